@@ -1,6 +1,8 @@
 #ifndef FAST_FOURIER_TRANSFORM_INTERFACE_H
 #define FAST_FOURIER_TRANSFORM_INTERFACE_H
 
+#include <complex>
+#include <cstddef>
 #include <vector>
 
 /**
@@ -42,6 +44,119 @@ class FastFourierTransformInterface {
       const std::vector<element_datatype>* imaginaryInput,
       std::vector<element_datatype>* realOutput,
       std::vector<element_datatype>* imaginaryOutput) = 0;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation on real input data.
+   * The spectrum of a real signal is Hermitian, so only its non-negative
+   * frequency half is returned.
+   * @param realInput The input data vector.
+   * @param realOutput The output data vector for real part, `n / 2 + 1`
+   * elements where `n` is the input size padded to a power of two.
+   * @param imaginaryOutput The output data vector for imaginary part, same
+   * size as `realOutput`.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void realFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) = 0;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation on the
+   * non-negative frequency half of a Hermitian spectrum, producing real data.
+   * @param realInput The input data vector for real part, `n / 2 + 1`
+   * elements.
+   * @param imaginaryInput The input data vector for imaginary part, same size
+   * as `realInput`.
+   * @param realOutput The output data vector, `n` elements.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void inverseRealFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput) = 0;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place on a
+   * caller-owned buffer. Once the plan of a size is built, no heap memory is
+   * allocated.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void fastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                           unsigned int log2n) = 0;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place on a
+   * caller-owned buffer, scaled by `1 / n`.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void inverseFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, unsigned int log2n) = 0;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place on a
+   * caller-owned buffer of any size, without zero-padding it. Once the plan of
+   * a size is built, no heap memory is allocated.
+   * @param data The interleaved complex data, `size` elements.
+   * @param size The transform size.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void exactSizeFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, std::size_t size) = 0;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place on a
+   * caller-owned buffer of any size, scaled by `1 / size`.
+   * @param data The interleaved complex data, `size` elements.
+   * @param size The transform size.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void inverseExactSizeFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, std::size_t size) = 0;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place on real data
+   * in a caller-owned buffer.
+   * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements. On entry
+   * its first `2 ^ log2n` scalars hold the real samples, on exit its elements
+   * hold the non-negative frequency bins.
+   * @param log2n The base 2 logarithm of the transform size.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void realFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, unsigned int log2n) = 0;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place on
+   * the non-negative frequency half of a Hermitian spectrum.
+   * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements. On entry
+   * its elements hold the bins, on exit its first `2 ^ log2n` scalars hold the
+   * real samples.
+   * @param log2n The base 2 logarithm of the transform size.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void inverseRealFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, unsigned int log2n) = 0;
 };
 
 #endif
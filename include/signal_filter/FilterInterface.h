@@ -26,6 +26,24 @@ class FilterInterface {
   virtual void process(
       SignalHistoryInterface<element_data_type>* filterInputPtr,
       SignalHistoryInterface<element_data_type>* filterOutputPtr) = 0;
+
+  /**
+   * @brief Apply the filter to two signals sampled together, such as the red
+   * and infrared channels of a PPG frame, sharing one transform.
+   *
+   * @param firstInputPtr The first input data to be filtered.
+   * @param secondInputPtr The second input data to be filtered.
+   * @param firstOutputPtr The first output data after filtering.
+   * @param secondOutputPtr The second output data after filtering.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void processPair(
+      SignalHistoryInterface<element_data_type>* firstInputPtr,
+      SignalHistoryInterface<element_data_type>* secondInputPtr,
+      SignalHistoryInterface<element_data_type>* firstOutputPtr,
+      SignalHistoryInterface<element_data_type>* secondOutputPtr) = 0;
 };
 
 #endif
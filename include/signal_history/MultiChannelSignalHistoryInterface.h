@@ -0,0 +1,126 @@
+#ifndef MULTI_CHANNEL_SIGNAL_HISTORY_INTERFACE_H
+#define MULTI_CHANNEL_SIGNAL_HISTORY_INTERFACE_H
+
+#include <cstddef>
+
+#include "signal_history/SignalHistoryInterface.h"
+
+/**
+ * @brief Channel lanes of a PPG multi-channel history.
+ *
+ * A history created with fewer than `PPGChannelTotal` channels keeps the
+ * leading lanes only, e.g. `AmbientChannel` channels store red and infrared.
+ */
+typedef enum {
+  RedChannel,
+  InfraRedChannel,
+  AmbientChannel,
+  PPGChannelTotal
+} PPGChannel;
+
+/**
+ * @interface MultiChannelSignalHistoryInterface
+ * @brief Template class for storing frames of simultaneously sampled signals.
+ *
+ * Every frame holds one signal per channel and the time it was sampled. All
+ * channels share one write cursor, so the nth signal of every channel belongs
+ * to the same frame and channel blocks of the same range split identically.
+ *
+ * @tparam element_type The type of the signals.
+ * @tparam time_data_type The type of the timestamps.
+ */
+template <class element_type, class time_data_type>
+class MultiChannelSignalHistoryInterface {
+ public:
+  virtual ~MultiChannelSignalHistoryInterface() {}
+
+  /**
+   * @brief Adds a frame to the history.
+   *
+   * @param channelSignals One signal per channel, indexed by channel.
+   * @param timestampUs The time the frame was sampled in microseconds.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void put(const element_type* channelSignals,
+                   time_data_type timestampUs) = 0;
+
+  /**
+   * @brief Retrieves the history of one channel.
+   *
+   * @param channel The index of the channel.
+   * @return The channel history. Only read from it, adding signals to a single
+   * channel breaks the frame alignment.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual SignalHistoryInterface<element_type>* getChannel(
+      std::size_t channel) = 0;
+
+  /**
+   * @brief Retrieves the timestamp of a frame.
+   *
+   * @param nthSample The index of the frame, where 0 is the oldest frame.
+   * @return The time the frame was sampled in microseconds.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual time_data_type getTimestampUs(std::size_t nthSample) = 0;
+
+  /**
+   * @brief Exposes consecutive frame timestamps without copying them.
+   *
+   * @param firstSample The index of the first frame, where 0 is the oldest.
+   * @param sampleCount The number of frames in the block.
+   * @return One or two contiguous spans covering the timestamps, oldest first.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual SignalBlock<time_data_type> getTimestampBlock(
+      std::size_t firstSample, std::size_t sampleCount) = 0;
+
+  /**
+   * @brief Retrieves the number of channels in every frame.
+   *
+   * @return The number of channels.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual std::size_t channelCount() = 0;
+
+  /**
+   * @brief Retrieves the number of frames stored for history.
+   *
+   * @return The number of frames stored for history.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual std::size_t size() = 0;
+
+  /**
+   * @brief Retrieves the number of frames ever put into the history.
+   *
+   * @return The version of the history. It changes on every put() and
+   * reset(), so a reader can skip work when it has not changed.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual unsigned int version() = 0;
+
+  /**
+   * @brief Resets the history of every channel.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void reset() = 0;
+};
+
+#endif  // MULTI_CHANNEL_SIGNAL_HISTORY_INTERFACE_H
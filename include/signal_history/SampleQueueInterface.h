@@ -0,0 +1,64 @@
+#ifndef SAMPLE_QUEUE_INTERFACE_H
+#define SAMPLE_QUEUE_INTERFACE_H
+
+#include <cstddef>
+
+/**
+ * @interface SampleQueueInterface
+ * @brief Template class for handing samples from one producer to one
+ * consumer, e.g. from an acquisition interrupt to the main loop.
+ *
+ * @tparam element_type The type of the samples.
+ */
+template <class element_type>
+class SampleQueueInterface {
+ public:
+  virtual ~SampleQueueInterface() {}
+
+  /**
+   * @brief Adds a sample to the queue. Only the producer may call this.
+   *
+   * @param sample The sample to be added to the queue.
+   * @return `true` if the sample was queued, `false` if the queue was full and
+   * the sample was dropped.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual bool push(const element_type& sample) = 0;
+
+  /**
+   * @brief Removes the oldest sample from the queue. Only the consumer may
+   * call this.
+   *
+   * @param sample Receives the oldest sample if there is one.
+   * @return `true` if a sample was removed, `false` if the queue was empty.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual bool pop(element_type& sample) = 0;
+
+  /**
+   * @brief Retrieves the number of queued samples.
+   *
+   * @return The number of queued samples. It is exact for the consumer and a
+   * lower bound of the free space for the producer.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual std::size_t size() = 0;
+
+  /**
+   * @brief Retrieves the number of samples dropped because the queue was full.
+   *
+   * @return The number of dropped samples.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual std::size_t droppedCount() = 0;
+};
+
+#endif  // SAMPLE_QUEUE_INTERFACE_H
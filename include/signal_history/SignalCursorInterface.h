@@ -0,0 +1,73 @@
+#ifndef SIGNAL_CURSOR_INTERFACE_H
+#define SIGNAL_CURSOR_INTERFACE_H
+
+#include <cstddef>
+
+#include "signal_history/SignalHistoryInterface.h"
+
+/**
+ * @brief Read position of one consumer of a history.
+ *
+ * Positions are sequence numbers, which count the signals put before a signal
+ * and keep increasing when the ring buffer evicts. Every consumer owns its
+ * cursor, so consumers read at their own pace.
+ */
+struct SignalCursor {
+  unsigned int nextSequence;  //!< Sequence number of the next signal to read.
+  unsigned int overrunCount;  //!< Signals evicted before they were read.
+};
+
+/**
+ * @interface SignalCursorInterface
+ * @brief Template class for reading only the signals that arrived since the
+ * last read, so a consumer does O(new signals) work per tick instead of
+ * O(window).
+ *
+ * @tparam element_type The type of the signals.
+ */
+template <class element_type>
+class SignalCursorInterface {
+ public:
+  virtual ~SignalCursorInterface() {}
+
+  /**
+   * @brief Creates a cursor positioned at the oldest signal of the history.
+   *
+   * @return The cursor.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual SignalCursor openCursor() = 0;
+
+  /**
+   * @brief Counts the signals a cursor has not read yet.
+   *
+   * @param cursor The cursor of the consumer.
+   * @return The number of unread signals still in the history.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual std::size_t pendingCount(const SignalCursor& cursor) = 0;
+
+  /**
+   * @brief Reads the unread signals of a cursor without copying them and
+   * advances the cursor past them.
+   *
+   * If the history evicted signals the cursor had not read, the cursor skips
+   * to the oldest signal and adds the evicted ones to its overrun count.
+   *
+   * @param cursor The cursor of the consumer.
+   * @param maxCount The maximum number of signals to read.
+   * @return One or two contiguous spans covering the signals, oldest first.
+   * The spans stay valid until the next put() or reset().
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual SignalBlock<element_type> readNew(SignalCursor& cursor,
+                                            std::size_t maxCount) = 0;
+};
+
+#endif  // SIGNAL_CURSOR_INTERFACE_H
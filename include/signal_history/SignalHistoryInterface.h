@@ -1,6 +1,33 @@
 #ifndef SIGNAL_HISTORY_INTERFACE_H
 #define SIGNAL_HISTORY_INTERFACE_H
 
+#include <cstddef>
+
+/**
+ * @brief Read-only view of signals stored contiguously in memory.
+ *
+ * @tparam element_type The type of the signals.
+ */
+template <class element_type>
+struct SignalSpan {
+  const element_type* data;  //!< The first signal of the span.
+  std::size_t length;        //!< The number of signals in the span.
+};
+
+/**
+ * @brief A run of consecutive signals of a history, oldest first.
+ *
+ * A ring buffer may wrap in the middle of the run, so the run is split into
+ * two contiguous spans. `second` is empty when the run does not wrap.
+ *
+ * @tparam element_type The type of the signals.
+ */
+template <class element_type>
+struct SignalBlock {
+  SignalSpan<element_type> first;   //!< The older part of the run.
+  SignalSpan<element_type> second;  //!< The newer part of the run.
+};
+
 /**
  * @interface SignalHistoryInterface
  * @brief Template class for storing history of discrete signal intensity.
@@ -32,6 +59,54 @@ class SignalHistoryInterface {
    */
   virtual element_type get(element_type nthSample) = 0;
 
+  /**
+   * @brief Retrieves a signal from the history by integer index.
+   *
+   * @param nthSample The index of the signal, where 0 is the oldest signal.
+   * @return The signal at the given index.
+   *
+   * Unlike get(), the index is not converted from `element_type` and is only
+   * range checked in the unit test build.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual element_type getSample(std::size_t nthSample) = 0;
+
+  /**
+   * @brief Exposes consecutive signals of the history without copying them.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the block.
+   * @return One or two contiguous spans covering the signals, oldest first.
+   *
+   * The spans stay valid until the next put() or reset(). Histories that do
+   * not store signals as `element_type` decode them into a buffer they own,
+   * which the next getBlock() overwrites as well, copyBlock() reads them
+   * without that buffer.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual SignalBlock<element_type> getBlock(std::size_t firstSample,
+                                             std::size_t sampleCount) = 0;
+
+  /**
+   * @brief Copies consecutive signals of the history to a buffer.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals to copy.
+   * @param destination The buffer receiving the signals, oldest first. It must
+   * hold at least `sampleCount` signals.
+   *
+   * This works for every history, including those storing compact codes.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void copyBlock(std::size_t firstSample, std::size_t sampleCount,
+                         element_type* destination) = 0;
+
   /**
    * @brief Retrieves the smallest signal from the history.
    *
@@ -52,6 +127,47 @@ class SignalHistoryInterface {
    */
   virtual element_type max() = 0;
 
+  /**
+   * @brief Retrieves the sum of the signals in the history.
+   *
+   * @return The sum of the signals.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual element_type sum() = 0;
+
+  /**
+   * @brief Retrieves the mean (DC component) of the signals in the history.
+   *
+   * @return The mean of the signals.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual element_type mean() = 0;
+
+  /**
+   * @brief Retrieves the sum of the squared signals in the history.
+   *
+   * @return The sum of the squared signals.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual element_type sumOfSquares() = 0;
+
+  /**
+   * @brief Retrieves the population variance of the signals in the history,
+   * which is the squared RMS of the AC component.
+   *
+   * @return The variance of the signals.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual element_type variance() = 0;
+
   /**
    * @brief Retrieves the number of samples stored for history.
    *
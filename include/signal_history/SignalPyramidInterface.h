@@ -0,0 +1,91 @@
+#ifndef SIGNAL_PYRAMID_INTERFACE_H
+#define SIGNAL_PYRAMID_INTERFACE_H
+
+#include <cstddef>
+
+/**
+ * @interface SignalPyramidInterface
+ * @brief Template class for summarizing a signal window at several levels of
+ * detail.
+ *
+ * A pyramid keeps the min, max and sum of every 2^k-sample block of its
+ * window, so the envelope or mean of any range is answered from O(log n)
+ * blocks instead of every sample. Positions are counted like in a history,
+ * where 0 is the oldest signal of the window.
+ *
+ * @tparam element_type The type of the signals.
+ */
+template <class element_type>
+class SignalPyramidInterface {
+ public:
+  virtual ~SignalPyramidInterface() {}
+
+  /**
+   * @brief Adds a signal to the window, evicting the oldest one when full.
+   *
+   * @param signal The signal to be added.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void put(element_type signal) = 0;
+
+  /**
+   * @brief Retrieves the smallest signal of a range.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the range, at least 1.
+   * @return The smallest signal of the range.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual element_type rangeMin(std::size_t firstSample,
+                                std::size_t sampleCount) = 0;
+
+  /**
+   * @brief Retrieves the largest signal of a range.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the range, at least 1.
+   * @return The largest signal of the range.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual element_type rangeMax(std::size_t firstSample,
+                                std::size_t sampleCount) = 0;
+
+  /**
+   * @brief Retrieves the mean of a range.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the range, at least 1.
+   * @return The mean of the range.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual element_type rangeMean(std::size_t firstSample,
+                                 std::size_t sampleCount) = 0;
+
+  /**
+   * @brief Retrieves the number of signals in the window.
+   *
+   * @return The number of signals in the window.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual std::size_t size() = 0;
+
+  /**
+   * @brief Clears the window.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual void reset() = 0;
+};
+
+#endif  // SIGNAL_PYRAMID_INTERFACE_H
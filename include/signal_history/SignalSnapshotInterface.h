@@ -0,0 +1,86 @@
+#ifndef SIGNAL_SNAPSHOT_INTERFACE_H
+#define SIGNAL_SNAPSHOT_INTERFACE_H
+
+#include <cstddef>
+
+#include "signal_history/SignalHistoryInterface.h"
+
+/**
+ * @brief The newest signals of a history as they were when the snapshot was
+ * taken.
+ *
+ * The block points into the history itself, nothing is copied. It holds the
+ * signals with sequence numbers [version - sampleCount, version), where the
+ * sequence number of a signal counts the signals put before it.
+ *
+ * @tparam element_type The type of the signals.
+ */
+template <class element_type>
+struct SignalSnapshot {
+  unsigned int version;             //!< Signals ever put when taken.
+  std::size_t sampleCount;          //!< The number of signals in the block.
+  SignalBlock<element_type> block;  //!< The signals, oldest first.
+};
+
+/**
+ * @interface SignalSnapshotInterface
+ * @brief Template class for reading a history from another context than the
+ * one putting signals into it, e.g. processing in the main loop while an
+ * interrupt acquires.
+ *
+ * Taking and checking a snapshot never blocks the writer. A reader takes a
+ * snapshot, reads its block and then checks that the writer has not
+ * overwritten it meanwhile, retrying otherwise:
+ *
+ * @code
+ * SignalSnapshot<double> snapshot;
+ * do {
+ *   snapshot = history.getSnapshot(sampleCount);
+ *   // read snapshot.block
+ * } while (!history.isSnapshotValid(snapshot));
+ * @endcode
+ *
+ * @tparam element_type The type of the signals.
+ */
+template <class element_type>
+class SignalSnapshotInterface {
+ public:
+  virtual ~SignalSnapshotInterface() {}
+
+  /**
+   * @brief Retrieves the number of signals ever put into the history.
+   *
+   * @return The version of the history. It changes on every put() and
+   * reset(), so a reader can skip work when it has not changed.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual unsigned int version() = 0;
+
+  /**
+   * @brief Takes a snapshot of the newest signals without copying them.
+   *
+   * @param sampleCount The number of signals wanted. It is clamped to the
+   * number of signals in the history.
+   * @return The snapshot.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual SignalSnapshot<element_type> getSnapshot(std::size_t sampleCount) = 0;
+
+  /**
+   * @brief Checks that none of the signals of a snapshot has been overwritten.
+   *
+   * @param snapshot A snapshot of this history.
+   * @return `true` if everything read from the snapshot so far is consistent.
+   *
+   * This is a pure virtual function, it must be overridden in any non-abstract
+   * child class.
+   */
+  virtual bool isSnapshotValid(
+      const SignalSnapshot<element_type>& snapshot) = 0;
+};
+
+#endif  // SIGNAL_SNAPSHOT_INTERFACE_H
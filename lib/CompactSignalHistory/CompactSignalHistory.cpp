@@ -0,0 +1,514 @@
+#include "CompactSignalHistory.h"
+
+#include <limits>
+
+#ifdef UNIT_TEST
+#include <stdexcept>  // std::invalid_argument
+#endif
+
+/**
+ * @brief Constructs a new CompactSignalHistory object.
+ *
+ * @param codeScale The signal step of one code, must be positive.
+ * @param codeOffset The signal of code 0.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+CompactSignalHistory<element_type, storage_type, capacity>::
+    CompactSignalHistory(element_type codeScale, element_type codeOffset)
+    : oldestSlot(0),
+      elementCount(0),
+      maxElementsCount(capacity),
+      codeScale(codeScale),
+      codeOffset(codeOffset),
+      inverseScale(1 / codeScale) {
+#ifdef UNIT_TEST
+  if (!(codeScale > 0)) {
+    throw std::invalid_argument("codeScale must be positive");
+  }
+#endif
+  reset();
+};
+
+/**
+ * @brief Constructs a new CompactSignalHistory object with a shorter window.
+ *
+ * @param codeScale The signal step of one code, must be positive.
+ * @param codeOffset The signal of code 0.
+ * @param maxElementsCount The number of signals kept before the oldest one is
+ * evicted. It is clamped to the range [1, capacity].
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+CompactSignalHistory<element_type, storage_type, capacity>::
+    CompactSignalHistory(element_type codeScale, element_type codeOffset,
+                         std::size_t maxElementsCount)
+    : oldestSlot(0),
+      elementCount(0),
+      maxElementsCount(maxElementsCount),
+      codeScale(codeScale),
+      codeOffset(codeOffset),
+      inverseScale(1 / codeScale) {
+#ifdef UNIT_TEST
+  if (!(codeScale > 0)) {
+    throw std::invalid_argument("codeScale must be positive");
+  }
+  if (maxElementsCount == 0 || maxElementsCount > capacity) {
+    throw std::invalid_argument(
+        "maxElementsCount must be between 1 and the history capacity");
+  }
+#endif
+  if (this->maxElementsCount == 0) this->maxElementsCount = 1;
+  if (this->maxElementsCount > capacity) this->maxElementsCount = capacity;
+  reset();
+};
+
+/**
+ * @brief Destructs a CompactSignalHistory object.
+ *
+ * The ring buffer is a member array, so there's no need to free anything.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+CompactSignalHistory<element_type, storage_type,
+                     capacity>::~CompactSignalHistory(){
+    // The ring buffer is released together with the object
+};
+
+/**
+ * @brief Adds a signal to the history.
+ *
+ * @param signal The signal to be added to the history.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+void CompactSignalHistory<element_type, storage_type, capacity>::put(
+    element_type signal) {
+  putCode(encode(signal));
+};
+
+/**
+ * @brief Adds a code to the history without converting it.
+ *
+ * If the history is full, the oldest code is overwritten by the new one.
+ *
+ * @param code The code to be added to the history.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+void CompactSignalHistory<element_type, storage_type, capacity>::putCode(
+    storage_type code) {
+  std::size_t entrySlot = static_cast<std::size_t>(getEntryPointIndex());
+
+  // Forget the oldest code in the extremum queues and sums before eviction
+  if (elementCount == maxElementsCount) {
+    storage_type evictedCode = history[oldestSlot];
+    popEvictedSlot(minSlotQueue, oldestSlot);
+    popEvictedSlot(maxSlotQueue, oldestSlot);
+    codeSum -= evictedCode;
+    squaredCodeSum -= static_cast<element_type>(evictedCode) *
+                      static_cast<element_type>(evictedCode);
+    ++evictionsSinceResync;
+  }
+  codeSum += code;
+  squaredCodeSum +=
+      static_cast<element_type>(code) * static_cast<element_type>(code);
+
+  // Store the code at the entry point, then advance the ring
+  history[entrySlot] = code;
+  pushSlot(minSlotQueue, entrySlot, true);
+  pushSlot(maxSlotQueue, entrySlot, false);
+  updateEntryPointIndex();
+
+  // Bound the rounding error of the sliding updates, O(1) amortized
+  if (evictionsSinceResync >= maxElementsCount) resyncRunningStatistics();
+};
+
+/**
+ * @brief Retrieves a signal from the history.
+ *
+ * @param nthSample The index of the signal, where 0 is the oldest signal.
+ * @return The signal at the given index.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type CompactSignalHistory<element_type, storage_type, capacity>::get(
+    element_type nthSample) {
+#ifdef UNIT_TEST
+  // Check if nthSample is a valid index
+  if (nthSample < 0 || nthSample >= elementCount) {
+    throw std::invalid_argument("nthSample is out of the history range");
+  }
+#endif
+
+  return decode(history[slotOf(static_cast<std::size_t>(nthSample))]);
+};
+
+/**
+ * @brief Retrieves a signal from the history by integer index.
+ *
+ * @param nthSample The index of the signal, where 0 is the oldest signal.
+ * @return The signal at the given index.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type
+CompactSignalHistory<element_type, storage_type, capacity>::getSample(
+    std::size_t nthSample) {
+  return decode(getCode(nthSample));
+};
+
+/**
+ * @brief Retrieves a stored code from the history.
+ *
+ * @param nthSample The index of the code, where 0 is the oldest code.
+ * @return The code at the given index.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+storage_type
+CompactSignalHistory<element_type, storage_type, capacity>::getCode(
+    std::size_t nthSample) {
+#ifdef UNIT_TEST
+  // Check if nthSample is a valid index
+  if (nthSample >= elementCount) {
+    throw std::invalid_argument("nthSample is out of the history range");
+  }
+#endif
+
+  return history[slotOf(nthSample)];
+};
+
+/**
+ * @brief Exposes consecutive signals of the history, decoded into a buffer
+ * owned by the history.
+ *
+ * The buffer only grows to the largest block ever requested, so histories read
+ * with copyBlock() alone never allocate it.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals in the block.
+ * @return One span covering the signals, oldest first, valid until the next
+ * getBlock(), put() or reset().
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+SignalBlock<element_type>
+CompactSignalHistory<element_type, storage_type, capacity>::getBlock(
+    std::size_t firstSample, std::size_t sampleCount) {
+  decodedBlock.resize(sampleCount);
+  copyBlock(firstSample, sampleCount, decodedBlock.data());
+
+  SignalBlock<element_type> block;
+  block.first.data = decodedBlock.data();
+  block.first.length = sampleCount;
+  block.second.data = decodedBlock.data();
+  block.second.length = 0;
+  return block;
+};
+
+/**
+ * @brief Exposes consecutive stored codes without copying them.
+ *
+ * @param firstSample The index of the first code, where 0 is the oldest.
+ * @param sampleCount The number of codes in the block.
+ * @return One or two contiguous spans covering the codes, oldest first.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+SignalBlock<storage_type>
+CompactSignalHistory<element_type, storage_type, capacity>::getCodeBlock(
+    std::size_t firstSample, std::size_t sampleCount) {
+#ifdef UNIT_TEST
+  // Check if the block lies inside the history
+  if (firstSample > elementCount || sampleCount > elementCount - firstSample) {
+    throw std::invalid_argument("Block is out of the history range");
+  }
+#endif
+
+  std::size_t startSlot = slotOf(firstSample);
+  std::size_t firstLength = capacity - startSlot;
+  if (firstLength > sampleCount) firstLength = sampleCount;
+
+  SignalBlock<storage_type> block;
+  block.first.data = history + startSlot;
+  block.first.length = firstLength;
+  block.second.data = history;
+  block.second.length = sampleCount - firstLength;
+  return block;
+};
+
+/**
+ * @brief Converts consecutive codes of the history to signals in a buffer.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals to copy.
+ * @param destination The buffer receiving the signals, oldest first.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+void CompactSignalHistory<element_type, storage_type, capacity>::copyBlock(
+    std::size_t firstSample, std::size_t sampleCount,
+    element_type* destination) {
+  SignalBlock<storage_type> block = getCodeBlock(firstSample, sampleCount);
+  for (std::size_t i = 0; i < block.first.length; ++i) {
+    *destination++ = decode(block.first.data[i]);
+  }
+  for (std::size_t i = 0; i < block.second.length; ++i) {
+    *destination++ = decode(block.second.data[i]);
+  }
+};
+
+/**
+ * @brief Retrieves the smallest signal from the history.
+ *
+ * @return The smallest signal value.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type CompactSignalHistory<element_type, storage_type, capacity>::min() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (elementCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  // codeScale is positive, so the smallest code is the smallest signal
+  return decode(history[minSlotQueue.slots[minSlotQueue.head]]);
+};
+
+/**
+ * @brief Retrieves the largest signal from the history.
+ *
+ * @return The largest signal value.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type CompactSignalHistory<element_type, storage_type, capacity>::max() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (elementCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  return decode(history[maxSlotQueue.slots[maxSlotQueue.head]]);
+};
+
+/**
+ * @brief Retrieves the sum of the signals in the history.
+ *
+ * @return The sum of the signals.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type CompactSignalHistory<element_type, storage_type, capacity>::sum() {
+  return codeOffset * static_cast<element_type>(elementCount) +
+         codeScale * static_cast<element_type>(codeSum);
+};
+
+/**
+ * @brief Retrieves the mean of the signals in the history.
+ *
+ * @return The mean of the signals.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type
+CompactSignalHistory<element_type, storage_type, capacity>::mean() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (elementCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  return codeOffset + codeScale * static_cast<element_type>(codeSum) /
+                          static_cast<element_type>(elementCount);
+};
+
+/**
+ * @brief Retrieves the sum of the squared signals in the history.
+ *
+ * Expands (offset + scale * code)^2 over the window.
+ *
+ * @return The sum of the squared signals.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type
+CompactSignalHistory<element_type, storage_type, capacity>::sumOfSquares() {
+  return codeOffset * codeOffset * static_cast<element_type>(elementCount) +
+         2 * codeOffset * codeScale * static_cast<element_type>(codeSum) +
+         codeScale * codeScale * squaredCodeSum;
+};
+
+/**
+ * @brief Retrieves the population variance of the signals in the history.
+ *
+ * The offset does not change the variance, so it is computed on the codes and
+ * scaled once.
+ *
+ * @return The variance of the signals.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type
+CompactSignalHistory<element_type, storage_type, capacity>::variance() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (elementCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  element_type count = static_cast<element_type>(elementCount);
+  element_type codeMean = static_cast<element_type>(codeSum) / count;
+  element_type codeVariance = squaredCodeSum / count - codeMean * codeMean;
+
+  // Rounding may push the difference slightly below zero
+  if (codeVariance < 0) codeVariance = 0;
+  return codeScale * codeScale * codeVariance;
+};
+
+/**
+ * @brief Retrieves the number of samples stored for history.
+ *
+ * @return The number of samples stored for history.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type
+CompactSignalHistory<element_type, storage_type, capacity>::size() {
+  return static_cast<element_type>(elementCount);
+};
+
+/**
+ * @brief Resets the history.
+ *
+ * This function clears the history.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+void CompactSignalHistory<element_type, storage_type, capacity>::reset() {
+  for (std::size_t i = 0; i < capacity; ++i) history[i] = 0;
+  oldestSlot = 0;
+  elementCount = 0;
+  minSlotQueue.head = 0;
+  minSlotQueue.count = 0;
+  maxSlotQueue.head = 0;
+  maxSlotQueue.count = 0;
+  codeSum = 0;
+  squaredCodeSum = 0;
+  evictionsSinceResync = 0;
+};
+
+/**
+ * @brief Gets the entry point index.
+ *
+ * @return The ring buffer slot where the next code will be stored.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type CompactSignalHistory<element_type, storage_type,
+                                  capacity>::getEntryPointIndex() {
+  return static_cast<element_type>(slotOf(elementCount));
+};
+
+/**
+ * @brief Updates the entry point index.
+ *
+ * This function grows the history by one code, or drops the oldest code when
+ * the history is full.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+void CompactSignalHistory<element_type, storage_type,
+                          capacity>::updateEntryPointIndex() {
+  if (elementCount == maxElementsCount) {
+    oldestSlot = (oldestSlot + 1) & INDEXMASK;
+  } else {
+    ++elementCount;
+  }
+};
+
+/**
+ * @brief Maps a position counted from the oldest code to a ring slot.
+ *
+ * @param nthSample The position counted from the oldest code.
+ * @return The ring buffer slot holding that code.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+std::size_t CompactSignalHistory<element_type, storage_type, capacity>::slotOf(
+    std::size_t nthSample) const {
+  return (oldestSlot + nthSample) & INDEXMASK;
+};
+
+/**
+ * @brief Converts a signal to the nearest code, saturating at the limits of
+ * `storage_type`.
+ *
+ * @param signal The signal to convert.
+ * @return The code of the signal.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+storage_type CompactSignalHistory<element_type, storage_type, capacity>::encode(
+    element_type signal) const {
+  element_type code = (signal - codeOffset) * inverseScale;
+  element_type lowestCode =
+      static_cast<element_type>(std::numeric_limits<storage_type>::min());
+  element_type highestCode =
+      static_cast<element_type>(std::numeric_limits<storage_type>::max());
+
+  if (!(code > lowestCode)) return std::numeric_limits<storage_type>::min();
+  if (!(code < highestCode)) return std::numeric_limits<storage_type>::max();
+  // Round half away from zero
+  return static_cast<storage_type>(code < 0 ? code - 0.5 : code + 0.5);
+};
+
+/**
+ * @brief Converts a code to its signal.
+ *
+ * @param code The code to convert.
+ * @return The signal of the code.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+element_type CompactSignalHistory<element_type, storage_type, capacity>::decode(
+    storage_type code) const {
+  return codeOffset + codeScale * static_cast<element_type>(code);
+};
+
+/**
+ * @brief Removes an evicted history slot from the front of an extremum queue.
+ *
+ * @param queue The extremum queue to update.
+ * @param evictedSlot The history slot of the code being evicted.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+void CompactSignalHistory<element_type, storage_type, capacity>::popEvictedSlot(
+    compact_slot_queue_data_type& queue, std::size_t evictedSlot) {
+  if (queue.count != 0 && queue.slots[queue.head] == evictedSlot) {
+    queue.head = (queue.head + 1) & INDEXMASK;
+    --queue.count;
+  }
+};
+
+/**
+ * @brief Appends a history slot to an extremum queue.
+ *
+ * @param queue The extremum queue to update.
+ * @param newSlot The history slot of the newest code.
+ * @param keepSmallest `true` for the min() queue, `false` for the max() queue.
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+void CompactSignalHistory<element_type, storage_type, capacity>::pushSlot(
+    compact_slot_queue_data_type& queue, std::size_t newSlot,
+    bool keepSmallest) {
+  storage_type newCode = history[newSlot];
+  while (queue.count != 0) {
+    storage_type backCode =
+        history[queue.slots[(queue.head + queue.count - 1) & INDEXMASK]];
+    bool backIsDominated =
+        keepSmallest ? !(backCode < newCode) : !(newCode < backCode);
+    if (!backIsDominated) break;
+    --queue.count;
+  }
+  queue.slots[(queue.head + queue.count) & INDEXMASK] =
+      static_cast<std::uint16_t>(newSlot);
+  ++queue.count;
+};
+
+/**
+ * @brief Recomputes the sum of squared codes from the stored codes.
+ *
+ * Squares of 16-bit codes add up exactly in a double, only 32-bit codes
+ * accumulate rounding error. This is called once per window of evictions, so
+ * its O(n) cost is O(1) amortized per put().
+ */
+template <class element_type, class storage_type, std::size_t capacity>
+void CompactSignalHistory<element_type, storage_type,
+                          capacity>::resyncRunningStatistics() {
+  element_type squaredSum = 0;
+  for (std::size_t i = 0; i < elementCount; ++i) {
+    element_type code = static_cast<element_type>(history[slotOf(i)]);
+    squaredSum += code * code;
+  }
+  squaredCodeSum = squaredSum;
+  evictionsSinceResync = 0;
+};
@@ -0,0 +1,306 @@
+#ifndef COMPACT_SIGNAL_HISTORY_H
+#define COMPACT_SIGNAL_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "signal_history/SignalHistoryInterface.h"
+
+/**
+ * @brief Template class for storing history of signals as compact codes.
+ *
+ * Signals are stored as `storage_type` codes and converted to `element_type`
+ * only when they are read, with `signal = codeOffset + codeScale * code`.
+ *
+ * - Raw 12-bit ADC readings: `std::uint16_t` with `codeScale` equal to the
+ *   reference voltage divided by 4096, or put with putCode() directly.
+ * - Q15 fixed point: `std::int16_t` with `codeScale = fullScale / 32768`.
+ * - Q31 fixed point: `std::int32_t` with `codeScale = fullScale / 2147483648`.
+ *
+ * A 16-bit history uses 6 bytes per signal including its extremum queues,
+ * against 16 bytes for `SignalHistory<double>` on the SAM3X, so the same SRAM
+ * holds windows more than twice as long.
+ *
+ * @tparam element_type The type of the signals.
+ * @tparam storage_type The integer type of the stored codes.
+ * @tparam capacity The maximum size of the history, must be a power of two no
+ * larger than 65536.
+ */
+template <class element_type, class storage_type, std::size_t capacity = 512>
+class CompactSignalHistory : public SignalHistoryInterface<element_type> {
+  static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0,
+                "CompactSignalHistory capacity must be a power of two");
+  static_assert(capacity <= 65536,
+                "CompactSignalHistory slots are indexed with 16 bits");
+
+ public:
+  /**
+   * @brief Constructs a new CompactSignalHistory object.
+   *
+   * @param codeScale The signal step of one code, must be positive.
+   * @param codeOffset The signal of code 0.
+   */
+  explicit CompactSignalHistory(element_type codeScale,
+                                element_type codeOffset = 0);
+
+  /**
+   * @brief Constructs a new CompactSignalHistory object with a shorter window.
+   *
+   * @param codeScale The signal step of one code, must be positive.
+   * @param codeOffset The signal of code 0.
+   * @param maxElementsCount The number of signals kept before the oldest one
+   * is evicted. It is clamped to the range [1, capacity].
+   */
+  CompactSignalHistory(element_type codeScale, element_type codeOffset,
+                       std::size_t maxElementsCount);
+
+  /**
+   * @brief Destructs a CompactSignalHistory object.
+   */
+  ~CompactSignalHistory();
+
+  /**
+   * @brief Adds a signal to the history.
+   *
+   * @param signal The signal to be added to the history. It is rounded to the
+   * nearest code and saturated to the range of `storage_type`.
+   */
+  void put(element_type signal) override;
+
+  /**
+   * @brief Adds a code to the history without converting it.
+   *
+   * @param code The code to be added to the history, e.g. an ADC reading.
+   */
+  void putCode(storage_type code);
+
+  /**
+   * @brief Retrieves a signal from the history.
+   *
+   * @param nthSample The index of the signal, where 0 is the oldest signal.
+   * @return The signal at the given index.
+   */
+  element_type get(element_type nthSample) override;
+
+  /**
+   * @brief Retrieves a signal from the history by integer index.
+   *
+   * @param nthSample The index of the signal, where 0 is the oldest signal.
+   * @return The signal at the given index.
+   */
+  element_type getSample(std::size_t nthSample) override;
+
+  /**
+   * @brief Retrieves a stored code from the history.
+   *
+   * @param nthSample The index of the code, where 0 is the oldest code.
+   * @return The code at the given index.
+   */
+  storage_type getCode(std::size_t nthSample);
+
+  /**
+   * @brief Exposes consecutive signals of the history, decoded into a buffer
+   * owned by the history.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the block.
+   * @return One span covering the signals, oldest first, valid until the next
+   * getBlock(), put() or reset().
+   */
+  SignalBlock<element_type> getBlock(std::size_t firstSample,
+                                     std::size_t sampleCount) override;
+
+  /**
+   * @brief Exposes consecutive stored codes without copying them.
+   *
+   * @param firstSample The index of the first code, where 0 is the oldest.
+   * @param sampleCount The number of codes in the block.
+   * @return One or two contiguous spans covering the codes, oldest first.
+   */
+  SignalBlock<storage_type> getCodeBlock(std::size_t firstSample,
+                                         std::size_t sampleCount);
+
+  /**
+   * @brief Converts consecutive codes of the history to signals in a buffer.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals to copy.
+   * @param destination The buffer receiving the signals, oldest first.
+   */
+  void copyBlock(std::size_t firstSample, std::size_t sampleCount,
+                 element_type* destination) override;
+
+  /**
+   * @brief Retrieves the smallest signal from the history.
+   *
+   * @return The smallest signal value.
+   *
+   * The smallest code is kept at the front of a monotonic queue, so this
+   * function runs in O(1).
+   */
+  element_type min() override;
+
+  /**
+   * @brief Retrieves the largest signal from the history.
+   *
+   * @return The largest signal value.
+   *
+   * The largest code is kept at the front of a monotonic queue, so this
+   * function runs in O(1).
+   */
+  element_type max() override;
+
+  /**
+   * @brief Retrieves the sum of the signals in the history.
+   *
+   * @return The sum of the signals.
+   */
+  element_type sum() override;
+
+  /**
+   * @brief Retrieves the mean (DC component) of the signals in the history.
+   *
+   * @return The mean of the signals.
+   */
+  element_type mean() override;
+
+  /**
+   * @brief Retrieves the sum of the squared signals in the history.
+   *
+   * @return The sum of the squared signals.
+   */
+  element_type sumOfSquares() override;
+
+  /**
+   * @brief Retrieves the population variance of the signals in the history.
+   *
+   * @return The variance of the signals.
+   *
+   * Computed from running sums of the codes, so this function runs in O(1).
+   */
+  element_type variance() override;
+
+  /**
+   * @brief Retrieves the number of samples stored for history.
+   *
+   * @return The number of samples stored for history.
+   */
+  element_type size() override;
+
+  /**
+   * @brief Resets the history.
+   *
+   * This function clears the history.
+   */
+  void reset() override;
+
+ private:
+  /**
+   * @brief Gets the entry point index.
+   *
+   * @return The ring buffer slot where the next code will be stored.
+   */
+  element_type getEntryPointIndex() override;
+
+  /**
+   * @brief Updates the entry point index.
+   *
+   * This function advances the ring buffer after a code has been written to
+   * the entry point, evicting the oldest code when the history is full.
+   */
+  void updateEntryPointIndex() override;
+
+  /**
+   * @brief Maps a position counted from the oldest code to a ring slot.
+   *
+   * @param nthSample The position counted from the oldest code.
+   * @return The ring buffer slot holding that code.
+   */
+  std::size_t slotOf(std::size_t nthSample) const;
+
+  /**
+   * @brief Converts a signal to the nearest code, saturating at the limits of
+   * `storage_type`.
+   *
+   * @param signal The signal to convert.
+   * @return The code of the signal.
+   */
+  storage_type encode(element_type signal) const;
+
+  /**
+   * @brief Converts a code to its signal.
+   *
+   * @param code The code to convert.
+   * @return The signal of the code.
+   */
+  element_type decode(storage_type code) const;
+
+  /**
+   * @brief Ring of history slots whose codes are monotonic from front to back,
+   * used to answer min() and max() of the sliding window in O(1).
+   */
+  typedef struct CompactSlotQueue {
+    std::uint16_t slots[capacity];  // Ring of history slots, oldest first
+    std::size_t head;               // Position of the front slot
+    std::size_t count;              // Number of queued slots
+  } compact_slot_queue_data_type;
+
+  /**
+   * @brief Removes an evicted history slot from the front of an extremum
+   * queue.
+   *
+   * @param queue The extremum queue to update.
+   * @param evictedSlot The history slot of the code being evicted.
+   */
+  void popEvictedSlot(compact_slot_queue_data_type& queue,
+                      std::size_t evictedSlot);
+
+  /**
+   * @brief Appends a history slot to an extremum queue, dropping every queued
+   * code that can no longer be the extremum of the window.
+   *
+   * @param queue The extremum queue to update.
+   * @param newSlot The history slot of the newest code.
+   * @param keepSmallest `true` for the min() queue, `false` for the max()
+   * queue.
+   */
+  void pushSlot(compact_slot_queue_data_type& queue, std::size_t newSlot,
+                bool keepSmallest);
+
+  /**
+   * @brief Recomputes the sum of squared codes from the stored codes,
+   * discarding the rounding error of 32-bit codes.
+   */
+  void resyncRunningStatistics();
+
+ private:
+  static const std::size_t INDEXMASK = capacity - 1;
+
+  storage_type history[capacity];  // The ring buffer of codes
+  std::size_t oldestSlot;          // Ring slot of the oldest code
+  std::size_t elementCount;        // Number of codes in the history
+  std::size_t maxElementsCount;    // Number of codes kept before eviction
+
+  element_type codeScale;     // Signal step of one code
+  element_type codeOffset;    // Signal of code 0
+  element_type inverseScale;  // Codes per unit of signal
+
+  compact_slot_queue_data_type minSlotQueue;  // Increasing codes
+  compact_slot_queue_data_type maxSlotQueue;  // Decreasing codes
+
+  long long codeSum;                 // Exact sum of the codes in the window
+  element_type squaredCodeSum;       // Sum of the squared codes in the window
+  std::size_t evictionsSinceResync;  // Evictions since the last resync
+
+  std::vector<element_type> decodedBlock;  // Signals decoded by getBlock()
+};
+
+// Raw 12-bit ADC codes
+template class CompactSignalHistory<double, std::uint16_t>;
+template class CompactSignalHistory<double, std::uint16_t, 64>;
+// Q15 and Q31 fixed-point signals
+template class CompactSignalHistory<double, std::int16_t, 64>;
+template class CompactSignalHistory<double, std::int32_t, 64>;
+
+#endif
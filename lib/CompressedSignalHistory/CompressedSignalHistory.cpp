@@ -0,0 +1,568 @@
+#include "CompressedSignalHistory.h"
+
+#ifdef UNIT_TEST
+#include <stdexcept>  // std::invalid_argument
+#endif
+
+/**
+ * @brief Constructs a new CompressedSignalHistory object.
+ *
+ * @param codeScale The signal step of one code, must be positive.
+ * @param codeOffset The signal of code 0.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+CompressedSignalHistory<element_type, blockLength, blockCount, poolBytes>::
+    CompressedSignalHistory(element_type codeScale, element_type codeOffset)
+    : codeScale(codeScale),
+      codeOffset(codeOffset),
+      inverseScale(1 / codeScale) {
+#ifdef UNIT_TEST
+  if (!(codeScale > 0)) {
+    throw std::invalid_argument("codeScale must be positive");
+  }
+#endif
+  reset();
+};
+
+/**
+ * @brief Destructs a CompressedSignalHistory object.
+ *
+ * The pool and the blocks are member arrays, so there's no need to free
+ * anything.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+CompressedSignalHistory<element_type, blockLength, blockCount,
+                        poolBytes>::~CompressedSignalHistory(){
+    // The pool is released together with the object
+};
+
+/**
+ * @brief Adds a signal to the history.
+ *
+ * @param signal The signal to be added to the history.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+void CompressedSignalHistory<element_type, blockLength, blockCount,
+                             poolBytes>::put(element_type signal) {
+  putCode(encode(signal));
+};
+
+/**
+ * @brief Adds a code to the history without converting it.
+ *
+ * The code is stored in the open block, which is packed once it is full.
+ *
+ * @param code The code to be added to the history.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+void CompressedSignalHistory<element_type, blockLength, blockCount,
+                             poolBytes>::putCode(std::uint16_t code) {
+  openBlock[static_cast<std::size_t>(getEntryPointIndex())] = code;
+  codeSum += code;
+  squaredCodeSum += static_cast<long long>(code) * code;
+  updateEntryPointIndex();
+};
+
+/**
+ * @brief Retrieves a signal from the history.
+ *
+ * @param nthSample The index of the signal, where 0 is the oldest signal.
+ * @return The signal at the given index.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type
+CompressedSignalHistory<element_type, blockLength, blockCount, poolBytes>::get(
+    element_type nthSample) {
+#ifdef UNIT_TEST
+  // Check if nthSample is a valid index
+  if (nthSample < 0) {
+    throw std::invalid_argument("nthSample is out of the history range");
+  }
+#endif
+
+  return decode(getCode(static_cast<std::size_t>(nthSample)));
+};
+
+/**
+ * @brief Retrieves a signal from the history by integer index.
+ *
+ * @param nthSample The index of the signal, where 0 is the oldest signal.
+ * @return The signal at the given index.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type CompressedSignalHistory<element_type, blockLength, blockCount,
+                                     poolBytes>::getSample(std::size_t
+                                                               nthSample) {
+  return decode(getCode(nthSample));
+};
+
+/**
+ * @brief Retrieves a stored code from the history.
+ *
+ * @param nthSample The index of the code, where 0 is the oldest code.
+ * @return The code at the given index.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+std::uint16_t CompressedSignalHistory<element_type, blockLength, blockCount,
+                                      poolBytes>::getCode(std::size_t
+                                                              nthSample) {
+  std::size_t closedSampleCount = closedBlockCount * blockLength;
+#ifdef UNIT_TEST
+  // Check if nthSample is a valid index
+  if (nthSample >= closedSampleCount + openCount) {
+    throw std::invalid_argument("nthSample is out of the history range");
+  }
+#endif
+
+  if (nthSample >= closedSampleCount) {
+    return openBlock[nthSample - closedSampleCount];
+  }
+  decodeBlock((oldestBlock + nthSample / blockLength) & BLOCKMASK);
+  return cachedCodes[nthSample % blockLength];
+};
+
+/**
+ * @brief Exposes consecutive signals of the history, decoded into a buffer
+ * owned by the history.
+ *
+ * The buffer only grows to the largest block ever requested, so histories read
+ * with copyBlock() alone never allocate it.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals in the block.
+ * @return One span covering the signals, oldest first, valid until the next
+ * getBlock(), put() or reset().
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+SignalBlock<element_type>
+CompressedSignalHistory<element_type, blockLength, blockCount,
+                        poolBytes>::getBlock(std::size_t firstSample,
+                                             std::size_t sampleCount) {
+  decodedBlock.resize(sampleCount);
+  copyBlock(firstSample, sampleCount, decodedBlock.data());
+
+  SignalBlock<element_type> block;
+  block.first.data = decodedBlock.data();
+  block.first.length = sampleCount;
+  block.second.data = decodedBlock.data();
+  block.second.length = 0;
+  return block;
+};
+
+/**
+ * @brief Decodes consecutive signals of the history to a buffer.
+ *
+ * Consecutive signals share a block, so every block is decoded once.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals to copy.
+ * @param destination The buffer receiving the signals, oldest first.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+void CompressedSignalHistory<element_type, blockLength, blockCount,
+                             poolBytes>::copyBlock(std::size_t firstSample,
+                                                   std::size_t sampleCount,
+                                                   element_type* destination) {
+#ifdef UNIT_TEST
+  // Check if the block lies inside the history
+  std::size_t elementCount = closedBlockCount * blockLength + openCount;
+  if (firstSample > elementCount || sampleCount > elementCount - firstSample) {
+    throw std::invalid_argument("Block is out of the history range");
+  }
+#endif
+
+  for (std::size_t i = 0; i < sampleCount; ++i) {
+    destination[i] = decode(getCode(firstSample + i));
+  }
+};
+
+/**
+ * @brief Retrieves the smallest signal from the history.
+ *
+ * @return The smallest signal value.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type CompressedSignalHistory<element_type, blockLength, blockCount,
+                                     poolBytes>::min() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (closedBlockCount == 0 && openCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  std::uint16_t minCode = 0xFFFF;
+  for (std::size_t i = 0; i < closedBlockCount; ++i) {
+    std::uint16_t blockMin = blocks[(oldestBlock + i) & BLOCKMASK].minCode;
+    if (blockMin < minCode) minCode = blockMin;
+  }
+  for (std::size_t i = 0; i < openCount; ++i) {
+    if (openBlock[i] < minCode) minCode = openBlock[i];
+  }
+  return decode(minCode);
+};
+
+/**
+ * @brief Retrieves the largest signal from the history.
+ *
+ * @return The largest signal value.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type CompressedSignalHistory<element_type, blockLength, blockCount,
+                                     poolBytes>::max() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (closedBlockCount == 0 && openCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  std::uint16_t maxCode = 0;
+  for (std::size_t i = 0; i < closedBlockCount; ++i) {
+    std::uint16_t blockMax = blocks[(oldestBlock + i) & BLOCKMASK].maxCode;
+    if (blockMax > maxCode) maxCode = blockMax;
+  }
+  for (std::size_t i = 0; i < openCount; ++i) {
+    if (openBlock[i] > maxCode) maxCode = openBlock[i];
+  }
+  return decode(maxCode);
+};
+
+/**
+ * @brief Retrieves the sum of the signals in the history.
+ *
+ * @return The sum of the signals.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type CompressedSignalHistory<element_type, blockLength, blockCount,
+                                     poolBytes>::sum() {
+  return codeOffset * size() + codeScale * static_cast<element_type>(codeSum);
+};
+
+/**
+ * @brief Retrieves the mean of the signals in the history.
+ *
+ * @return The mean of the signals.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type CompressedSignalHistory<element_type, blockLength, blockCount,
+                                     poolBytes>::mean() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (closedBlockCount == 0 && openCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  return codeOffset + codeScale * static_cast<element_type>(codeSum) / size();
+};
+
+/**
+ * @brief Retrieves the sum of the squared signals in the history.
+ *
+ * Expands (offset + scale * code)^2 over the history.
+ *
+ * @return The sum of the squared signals.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type CompressedSignalHistory<element_type, blockLength, blockCount,
+                                     poolBytes>::sumOfSquares() {
+  return codeOffset * codeOffset * size() +
+         2 * codeOffset * codeScale * static_cast<element_type>(codeSum) +
+         codeScale * codeScale * static_cast<element_type>(squaredCodeSum);
+};
+
+/**
+ * @brief Retrieves the population variance of the signals in the history.
+ *
+ * The code sums are exact, so n * sum(c^2) - sum(c)^2 is computed without
+ * cancellation and scaled once.
+ *
+ * @return The variance of the signals.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type CompressedSignalHistory<element_type, blockLength, blockCount,
+                                     poolBytes>::variance() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (closedBlockCount == 0 && openCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  long long count = static_cast<long long>(closedBlockCount * blockLength +
+                                           openCount);
+  long long scaledVariance = count * squaredCodeSum - codeSum * codeSum;
+  element_type countSquared = static_cast<element_type>(count) * count;
+  return codeScale * codeScale * static_cast<element_type>(scaledVariance) /
+         countSquared;
+};
+
+/**
+ * @brief Retrieves the number of samples stored for history.
+ *
+ * @return The number of samples stored for history.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type CompressedSignalHistory<element_type, blockLength, blockCount,
+                                     poolBytes>::size() {
+  return static_cast<element_type>(closedBlockCount * blockLength + openCount);
+};
+
+/**
+ * @brief Resets the history.
+ *
+ * This function clears the history.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+void CompressedSignalHistory<element_type, blockLength, blockCount,
+                             poolBytes>::reset() {
+  oldestBlock = 0;
+  closedBlockCount = 0;
+  poolTail = 0;
+  packedBytes = 0;
+  openCount = 0;
+  cachedBlock = NOBLOCK;
+  codeSum = 0;
+  squaredCodeSum = 0;
+};
+
+/**
+ * @brief Retrieves the number of pool bytes used by the closed blocks.
+ *
+ * @return The number of packed bytes.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+std::size_t CompressedSignalHistory<element_type, blockLength, blockCount,
+                                    poolBytes>::packedByteCount() {
+  return packedBytes;
+};
+
+/**
+ * @brief Gets the entry point index.
+ *
+ * @return The position in the open block where the next code is stored.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type CompressedSignalHistory<element_type, blockLength, blockCount,
+                                     poolBytes>::getEntryPointIndex() {
+  return static_cast<element_type>(openCount);
+};
+
+/**
+ * @brief Updates the entry point index.
+ *
+ * This function grows the open block by one code and packs it when full.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+void CompressedSignalHistory<element_type, blockLength, blockCount,
+                             poolBytes>::updateEntryPointIndex() {
+  if (++openCount == blockLength) closeOpenBlock();
+};
+
+/**
+ * @brief Packs the open block into the pool and appends it to the closed
+ * blocks, evicting the oldest ones when needed.
+ *
+ * Each delta is zigzag-encoded, mapping 0, -1, 1, -2, ... to 0, 1, 2, 3, ...,
+ * and written with the bit width of the largest one, least significant bits
+ * first.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+void CompressedSignalHistory<element_type, blockLength, blockCount,
+                             poolBytes>::closeOpenBlock() {
+  packed_block_data_type block;
+  block.firstCode = openBlock[0];
+  block.minCode = openBlock[0];
+  block.maxCode = openBlock[0];
+  block.codeSum = 0;
+  block.squaredCodeSum = 0;
+
+  // Summarize the block and find the widest delta
+  std::uint32_t widestDelta = 0;
+  for (std::size_t i = 0; i < blockLength; ++i) {
+    std::uint16_t code = openBlock[i];
+    if (code < block.minCode) block.minCode = code;
+    if (code > block.maxCode) block.maxCode = code;
+    block.codeSum += code;
+    block.squaredCodeSum += static_cast<long long>(code) * code;
+    if (i == 0) continue;
+
+    std::int32_t delta = static_cast<std::int32_t>(code) - openBlock[i - 1];
+    std::uint32_t zigzagDelta = (static_cast<std::uint32_t>(delta) << 1) ^
+                                static_cast<std::uint32_t>(delta >> 31);
+    widestDelta |= zigzagDelta;
+  }
+  block.bitWidth = 0;
+  while ((widestDelta >> block.bitWidth) != 0) ++block.bitWidth;
+  block.byteCount = ((blockLength - 1) * block.bitWidth + 7) / 8;
+
+  // Make room in the block table and in the pool
+  if (closedBlockCount == blockCount) evictOldestBlock();
+  block.poolOffset = reservePoolBytes(block.byteCount);
+
+  // Pack the deltas
+  std::size_t poolIndex = block.poolOffset;
+  std::uint32_t bitBuffer = 0;
+  std::size_t bufferedBits = 0;
+  for (std::size_t i = 1; i < blockLength; ++i) {
+    std::int32_t delta =
+        static_cast<std::int32_t>(openBlock[i]) - openBlock[i - 1];
+    std::uint32_t zigzagDelta = (static_cast<std::uint32_t>(delta) << 1) ^
+                                static_cast<std::uint32_t>(delta >> 31);
+    bitBuffer |= zigzagDelta << bufferedBits;
+    bufferedBits += block.bitWidth;
+    while (bufferedBits >= 8) {
+      pool[poolIndex++] = static_cast<std::uint8_t>(bitBuffer);
+      bitBuffer >>= 8;
+      bufferedBits -= 8;
+    }
+  }
+  if (bufferedBits != 0) pool[poolIndex] = static_cast<std::uint8_t>(bitBuffer);
+  poolTail = block.poolOffset + block.byteCount;
+  packedBytes += block.byteCount;
+
+  // The open block is the decoded form of the new block, keep it cached
+  std::size_t blockSlot = (oldestBlock + closedBlockCount) & BLOCKMASK;
+  blocks[blockSlot] = block;
+  ++closedBlockCount;
+  for (std::size_t i = 0; i < blockLength; ++i) cachedCodes[i] = openBlock[i];
+  cachedBlock = blockSlot;
+  openCount = 0;
+};
+
+/**
+ * @brief Finds room for a packed block in the pool.
+ *
+ * Blocks are stored back to back from the oldest to the newest. A block that
+ * does not fit before the end of the pool starts over at offset 0, and the
+ * oldest blocks are evicted until the room is free.
+ *
+ * @param byteCount The number of bytes needed.
+ * @return The pool offset of the room.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+std::size_t
+CompressedSignalHistory<element_type, blockLength, blockCount,
+                        poolBytes>::reservePoolBytes(std::size_t byteCount) {
+  if (byteCount == 0) return poolTail;
+
+  while (packedBytes != 0) {
+    // The oldest block holding bytes marks the start of the used bytes
+    std::size_t headBlock = oldestBlock;
+    while (blocks[headBlock].byteCount == 0) {
+      headBlock = (headBlock + 1) & BLOCKMASK;
+    }
+    std::size_t poolHead = blocks[headBlock].poolOffset;
+
+    if (poolTail > poolHead) {
+      if (poolTail + byteCount <= poolBytes) return poolTail;
+      if (byteCount <= poolHead) return 0;
+    } else if (poolTail < poolHead) {
+      if (poolTail + byteCount <= poolHead) return poolTail;
+    }
+    evictOldestBlock();
+  }
+  return 0;
+};
+
+/**
+ * @brief Drops the oldest closed block.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+void CompressedSignalHistory<element_type, blockLength, blockCount,
+                             poolBytes>::evictOldestBlock() {
+  const packed_block_data_type& block = blocks[oldestBlock];
+  codeSum -= block.codeSum;
+  squaredCodeSum -= block.squaredCodeSum;
+  packedBytes -= block.byteCount;
+  if (cachedBlock == oldestBlock) cachedBlock = NOBLOCK;
+  oldestBlock = (oldestBlock + 1) & BLOCKMASK;
+  --closedBlockCount;
+};
+
+/**
+ * @brief Decodes a closed block into the cache unless it is cached.
+ *
+ * @param blockSlot The block table slot of the closed block.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+void CompressedSignalHistory<element_type, blockLength, blockCount,
+                             poolBytes>::decodeBlock(std::size_t blockSlot) {
+  if (cachedBlock == blockSlot) return;
+
+  const packed_block_data_type& block = blocks[blockSlot];
+  std::uint32_t deltaMask = (1u << block.bitWidth) - 1;
+  std::size_t poolIndex = block.poolOffset;
+  std::uint32_t bitBuffer = 0;
+  std::size_t bufferedBits = 0;
+
+  cachedCodes[0] = block.firstCode;
+  for (std::size_t i = 1; i < blockLength; ++i) {
+    while (bufferedBits < block.bitWidth) {
+      bitBuffer |= static_cast<std::uint32_t>(pool[poolIndex++])
+                   << bufferedBits;
+      bufferedBits += 8;
+    }
+    std::uint32_t zigzagDelta = bitBuffer & deltaMask;
+    bitBuffer >>= block.bitWidth;
+    bufferedBits -= block.bitWidth;
+
+    std::int32_t delta = static_cast<std::int32_t>(zigzagDelta >> 1) ^
+                         -static_cast<std::int32_t>(zigzagDelta & 1);
+    cachedCodes[i] = static_cast<std::uint16_t>(cachedCodes[i - 1] + delta);
+  }
+  cachedBlock = blockSlot;
+};
+
+/**
+ * @brief Converts a signal to the nearest 16-bit code, saturating at the code
+ * range.
+ *
+ * @param signal The signal to convert.
+ * @return The code of the signal.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+std::uint16_t CompressedSignalHistory<element_type, blockLength, blockCount,
+                                      poolBytes>::encode(element_type signal)
+    const {
+  element_type code = (signal - codeOffset) * inverseScale;
+  if (!(code > 0)) return 0;
+  if (!(code < 65535)) return 65535;
+  return static_cast<std::uint16_t>(code + 0.5);
+};
+
+/**
+ * @brief Converts a code to its signal.
+ *
+ * @param code The code to convert.
+ * @return The signal of the code.
+ */
+template <class element_type, std::size_t blockLength, std::size_t blockCount,
+          std::size_t poolBytes>
+element_type CompressedSignalHistory<element_type, blockLength, blockCount,
+                                     poolBytes>::decode(std::uint16_t code)
+    const {
+  return codeOffset + codeScale * static_cast<element_type>(code);
+};
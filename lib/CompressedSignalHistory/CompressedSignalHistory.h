@@ -0,0 +1,290 @@
+#ifndef COMPRESSED_SIGNAL_HISTORY_H
+#define COMPRESSED_SIGNAL_HISTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "signal_history/SignalHistoryInterface.h"
+
+/**
+ * @brief Template class for storing a long history of ADC codes compressed in
+ * RAM.
+ *
+ * Signals are converted to 16-bit codes like in `CompactSignalHistory` and
+ * gathered in an uncompressed open block, so put() is a plain store. A full
+ * block is closed by packing the zigzag-encoded deltas between neighbouring
+ * codes with as many bits as its largest delta needs. PPG codes change by a
+ * few steps per sample, so a closed block takes 3 to 6 bits per signal
+ * instead of 64 for a double.
+ *
+ * Closed blocks are appended to a byte ring pool and evicted oldest first when
+ * the pool or the block table is full, so the history grows and shrinks by
+ * whole blocks. Reads decode one block at a time into a one-block cache, which
+ * makes sequential get() calls cheap.
+ *
+ * @tparam element_type The type of the signals.
+ * @tparam blockLength The number of signals in a block.
+ * @tparam blockCount The maximum number of closed blocks, a power of two.
+ * @tparam poolBytes The size of the packed block pool in bytes.
+ */
+template <class element_type, std::size_t blockLength = 64,
+          std::size_t blockCount = 64, std::size_t poolBytes = 4096>
+class CompressedSignalHistory : public SignalHistoryInterface<element_type> {
+  static_assert(blockLength > 1, "A block must hold at least two signals");
+  static_assert(blockCount > 0 && (blockCount & (blockCount - 1)) == 0,
+                "CompressedSignalHistory blockCount must be a power of two");
+  static_assert(poolBytes >= ((blockLength - 1) * 17 + 7) / 8,
+                "The pool must hold at least one incompressible block");
+
+ public:
+  /**
+   * @brief Constructs a new CompressedSignalHistory object.
+   *
+   * @param codeScale The signal step of one code, must be positive.
+   * @param codeOffset The signal of code 0.
+   */
+  explicit CompressedSignalHistory(element_type codeScale,
+                                   element_type codeOffset = 0);
+
+  /**
+   * @brief Destructs a CompressedSignalHistory object.
+   */
+  ~CompressedSignalHistory();
+
+  /**
+   * @brief Adds a signal to the history.
+   *
+   * @param signal The signal to be added to the history. It is rounded to the
+   * nearest code and saturated to 16 bits.
+   */
+  void put(element_type signal) override;
+
+  /**
+   * @brief Adds a code to the history without converting it.
+   *
+   * @param code The code to be added to the history, e.g. an ADC reading.
+   */
+  void putCode(std::uint16_t code);
+
+  /**
+   * @brief Retrieves a signal from the history.
+   *
+   * @param nthSample The index of the signal, where 0 is the oldest signal.
+   * @return The signal at the given index.
+   */
+  element_type get(element_type nthSample) override;
+
+  /**
+   * @brief Retrieves a signal from the history by integer index.
+   *
+   * @param nthSample The index of the signal, where 0 is the oldest signal.
+   * @return The signal at the given index.
+   */
+  element_type getSample(std::size_t nthSample) override;
+
+  /**
+   * @brief Retrieves a stored code from the history.
+   *
+   * @param nthSample The index of the code, where 0 is the oldest code.
+   * @return The code at the given index. Decodes its block unless it is the
+   * open block or the cached one.
+   */
+  std::uint16_t getCode(std::size_t nthSample);
+
+  /**
+   * @brief Exposes consecutive signals of the history, decoded into a buffer
+   * owned by the history.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the block.
+   * @return One span covering the signals, oldest first, valid until the next
+   * getBlock(), put() or reset().
+   */
+  SignalBlock<element_type> getBlock(std::size_t firstSample,
+                                     std::size_t sampleCount) override;
+
+  /**
+   * @brief Decodes consecutive signals of the history to a buffer.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals to copy.
+   * @param destination The buffer receiving the signals, oldest first.
+   */
+  void copyBlock(std::size_t firstSample, std::size_t sampleCount,
+                 element_type* destination) override;
+
+  /**
+   * @brief Retrieves the smallest signal from the history.
+   *
+   * @return The smallest signal value.
+   *
+   * Every closed block keeps its smallest code, so this function runs in
+   * O(blockCount + blockLength) without decoding.
+   */
+  element_type min() override;
+
+  /**
+   * @brief Retrieves the largest signal from the history.
+   *
+   * @return The largest signal value.
+   *
+   * Every closed block keeps its largest code, so this function runs in
+   * O(blockCount + blockLength) without decoding.
+   */
+  element_type max() override;
+
+  /**
+   * @brief Retrieves the sum of the signals in the history.
+   *
+   * @return The sum of the signals.
+   */
+  element_type sum() override;
+
+  /**
+   * @brief Retrieves the mean (DC component) of the signals in the history.
+   *
+   * @return The mean of the signals.
+   */
+  element_type mean() override;
+
+  /**
+   * @brief Retrieves the sum of the squared signals in the history.
+   *
+   * @return The sum of the squared signals.
+   */
+  element_type sumOfSquares() override;
+
+  /**
+   * @brief Retrieves the population variance of the signals in the history.
+   *
+   * @return The variance of the signals.
+   */
+  element_type variance() override;
+
+  /**
+   * @brief Retrieves the number of samples stored for history.
+   *
+   * @return The number of samples stored for history.
+   */
+  element_type size() override;
+
+  /**
+   * @brief Resets the history.
+   *
+   * This function clears the history.
+   */
+  void reset() override;
+
+  /**
+   * @brief Retrieves the number of pool bytes used by the closed blocks.
+   *
+   * @return The number of packed bytes.
+   */
+  std::size_t packedByteCount();
+
+ private:
+  /**
+   * @brief Gets the entry point index.
+   *
+   * @return The position in the open block where the next code is stored.
+   */
+  element_type getEntryPointIndex() override;
+
+  /**
+   * @brief Updates the entry point index.
+   *
+   * This function grows the open block by one code and closes it when full.
+   */
+  void updateEntryPointIndex() override;
+
+  /**
+   * @brief Summary and location of a closed block.
+   */
+  typedef struct PackedBlock {
+    std::size_t poolOffset;    // First byte of the packed deltas
+    std::size_t byteCount;     // Number of packed bytes
+    long long codeSum;         // Sum of the codes
+    long long squaredCodeSum;  // Sum of the squared codes
+    std::uint16_t firstCode;   // Code of the first signal, stored as is
+    std::uint16_t minCode;     // Smallest code
+    std::uint16_t maxCode;     // Largest code
+    std::uint8_t bitWidth;     // Bits per packed delta
+  } packed_block_data_type;
+
+  /**
+   * @brief Packs the open block into the pool and appends it to the closed
+   * blocks, evicting the oldest ones when needed.
+   */
+  void closeOpenBlock();
+
+  /**
+   * @brief Finds room for a packed block in the pool.
+   *
+   * @param byteCount The number of bytes needed.
+   * @return The pool offset of the room, evicting closed blocks until it
+   * fits.
+   */
+  std::size_t reservePoolBytes(std::size_t byteCount);
+
+  /**
+   * @brief Drops the oldest closed block.
+   */
+  void evictOldestBlock();
+
+  /**
+   * @brief Decodes a closed block into the cache unless it is cached.
+   *
+   * @param blockSlot The block table slot of the closed block.
+   */
+  void decodeBlock(std::size_t blockSlot);
+
+  /**
+   * @brief Converts a signal to the nearest 16-bit code.
+   *
+   * @param signal The signal to convert.
+   * @return The code of the signal.
+   */
+  std::uint16_t encode(element_type signal) const;
+
+  /**
+   * @brief Converts a code to its signal.
+   *
+   * @param code The code to convert.
+   * @return The signal of the code.
+   */
+  element_type decode(std::uint16_t code) const;
+
+ private:
+  static const std::size_t BLOCKMASK = blockCount - 1;
+  static const std::size_t NOBLOCK = blockCount;  // Empty cache marker
+
+  std::uint8_t pool[poolBytes];               // Ring of packed blocks
+  packed_block_data_type blocks[blockCount];  // Ring of closed blocks
+  std::size_t oldestBlock;                    // Slot of the oldest closed block
+  std::size_t closedBlockCount;               // Number of closed blocks
+  std::size_t poolTail;                       // Pool offset of the next block
+  std::size_t packedBytes;                    // Pool bytes of closed blocks
+
+  std::uint16_t openBlock[blockLength];  // The newest, uncompressed codes
+  std::size_t openCount;                 // Number of codes in the open block
+
+  std::uint16_t cachedCodes[blockLength];  // Codes of the cached block
+  std::size_t cachedBlock;                 // Slot of the cached block
+
+  element_type codeScale;     // Signal step of one code
+  element_type codeOffset;    // Signal of code 0
+  element_type inverseScale;  // Codes per unit of signal
+
+  long long codeSum;         // Exact sum of the codes in the history
+  long long squaredCodeSum;  // Exact sum of the squared codes
+
+  std::vector<element_type> decodedBlock;  // Signals decoded by getBlock()
+};
+
+// About 4000 raw 12-bit ADC readings in 6 KB
+template class CompressedSignalHistory<double>;
+// Small pool that fills quickly, used by the tests
+template class CompressedSignalHistory<double, 16, 8, 64>;
+
+#endif
@@ -104,22 +104,36 @@ void Display<values_data_type>::updatePPGWave(
   // Calculate the half of the screen height
   int half_screen_height = TFTscreenPtr->height() / 2;
 
+  // The waveform range is the same for every bar
+  values_data_type min_ppg_value = ppgWaveformClassPtr->min();
+  values_data_type max_ppg_value = ppgWaveformClassPtr->max();
+
+  // Read the PPG values straight from the history memory
+  std::size_t num_values =
+      static_cast<std::size_t>(ppgWaveformClassPtr->size());
+  SignalBlock<values_data_type> ppg_block =
+      ppgWaveformClassPtr->getBlock(0, num_values);
+  const SignalSpan<values_data_type> ppg_spans[] = {ppg_block.first,
+                                                    ppg_block.second};
+
   // Loop over each PPG value
-  for (int i = 0; i < ppgWaveformClassPtr->size(); i++) {
-    // Map the PPG value to the screen height
-    int bar_height =
-        map(ppgWaveformClassPtr->get(i), ppgWaveformClassPtr->min(),
-            ppgWaveformClassPtr->max(), 0, half_screen_height);
+  int i = 0;
+  for (const SignalSpan<values_data_type>& ppg_span : ppg_spans) {
+    for (std::size_t j = 0; j < ppg_span.length; j++, i++) {
+      // Map the PPG value to the screen height
+      int bar_height = map(ppg_span.data[j], min_ppg_value, max_ppg_value, 0,
+                           half_screen_height);
 
-    // Ensure the bar height is not negative
-    if (bar_height < 0) bar_height = 0;
+      // Ensure the bar height is not negative
+      if (bar_height < 0) bar_height = 0;
 
-    // Calculate the y position of the bar
-    int bar_y = half_screen_height - bar_height;
+      // Calculate the y position of the bar
+      int bar_y = half_screen_height - bar_height;
 
-    // Draw the bar on the screen
-    TFTscreenPtr->fillRect(i * bar_width, bar_y, bar_width, bar_height,
-                           BAR_COLOR);
+      // Draw the bar on the screen
+      TFTscreenPtr->fillRect(i * bar_width, bar_y, bar_width, bar_height,
+                             BAR_COLOR);
+    }
   }
   Serial.println("PPG()");
 };
@@ -6,6 +6,7 @@
 #include "Filter.h"
 #include "HardwareAbstractionLayer.h"
 #include "HeartRateCalculator.h"
+#include "MultiChannelSignalHistory.h"
 #include "PPGSignalHardwareController.h"
 #include "SignalHistory.h"
 #include "SpO2Calculator.h"
@@ -89,6 +90,8 @@ void EventController<voltage_data_type, time_data_type,
   // Initialize deviceMemory
   this->deviceMemory = {
       .rawPhotodiodeVoltage = 0,
+      .rawPhotodiodeReadTimeUs = 0,
+      .pendingPPGFrame = {0},
       .eventSequenceStartTimeUs =
           this->helperClassInstance.ppgSignalControllerPtr->getCurrentTimeUs(),
       .eventSequenceEndTimeUs =
@@ -96,19 +99,33 @@ void EventController<voltage_data_type, time_data_type,
           this->deviceSettings.screenRefreshTimeIntervalUs,
       .lastDisplayUpdateTime = 0,
       .lastFilteredSignalUpdateTime = 0,
-      .rawRedPPGSignalHistoryPtr = new SignalHistory<voltage_data_type>(),
-      .filteredRedPPGSignalHistoryPtr = new SignalHistory<voltage_data_type>(),
-      .rawInfraRedPPGSignalHistoryPtr = new SignalHistory<voltage_data_type>(),
+      .rawPPGSignalHistoryPtr =
+          new MultiChannelSignalHistory<voltage_data_type, time_data_type,
+                                        AmbientChannel,
+                                        PPG_SIGNAL_HISTORY_CAPACITY>(
+              this->deviceSettings.signalHistoryElementsCount),
+      .processedRawPPGVersion = 0,
+      .rawRedPPGSignalHistoryPtr = nullptr,
+      .filteredRedPPGSignalHistoryPtr =
+          new SignalHistory<voltage_data_type, PPG_SIGNAL_HISTORY_CAPACITY>(
+              this->deviceSettings.signalHistoryElementsCount),
+      .rawInfraRedPPGSignalHistoryPtr = nullptr,
       .filteredInfraRedPPGSignalHistoryPtr =
-          new SignalHistory<voltage_data_type>(),
+          new SignalHistory<voltage_data_type, PPG_SIGNAL_HISTORY_CAPACITY>(
+              this->deviceSettings.signalHistoryElementsCount),
       .spO2Value = 0,
       .heartBeatRateValue = 0,
   };
 
+  // The raw red and infrared histories are the lanes of the raw PPG history
+  this->deviceMemory.rawRedPPGSignalHistoryPtr =
+      this->deviceMemory.rawPPGSignalHistoryPtr->getChannel(RedChannel);
+  this->deviceMemory.rawInfraRedPPGSignalHistoryPtr =
+      this->deviceMemory.rawPPGSignalHistoryPtr->getChannel(InfraRedChannel);
+
   // Reset all signal histories
-  this->deviceMemory.rawRedPPGSignalHistoryPtr->reset();
+  this->deviceMemory.rawPPGSignalHistoryPtr->reset();
   this->deviceMemory.filteredRedPPGSignalHistoryPtr->reset();
-  this->deviceMemory.rawInfraRedPPGSignalHistoryPtr->reset();
   this->deviceMemory.filteredInfraRedPPGSignalHistoryPtr->reset();
 
   /*Serial.begin(38400);
@@ -142,9 +159,8 @@ EventController<voltage_data_type, time_data_type,
     // delete this->helperClassInstance.heartRateCalculatorPtr;
 
     // // Delete deviceMemory objects
-    // delete this->deviceMemory.rawRedPPGSignalHistoryPtr;
+    // delete this->deviceMemory.rawPPGSignalHistoryPtr;
     // delete this->deviceMemory.filteredRedPPGSignalHistoryPtr;
-    // delete this->deviceMemory.rawInfraRedPPGSignalHistoryPtr;
     // delete this->deviceMemory.filteredInfraRedPPGSignalHistoryPtr;
 };
 
@@ -200,6 +216,8 @@ void EventController<voltage_data_type, time_data_type, pin_id_data_type>::
           this->helperClassInstance.ppgSignalControllerPtr
               ->getPhotoDiodeVoltage(
                   this->deviceSettings.photoDiodeWarmupTimeUs);
+      this->deviceMemory.rawPhotodiodeReadTimeUs =
+          this->helperClassInstance.ppgSignalControllerPtr->getCurrentTimeUs();
       break;
     case UiIsUpdating:
       // Code to execute when UiIsUpdating
@@ -273,15 +291,18 @@ void EventController<voltage_data_type, time_data_type, pin_id_data_type>::
       // Code to execute when PhotoDetectorReading.
       if (this->deviceStatus.statesCompleted[RedLedOn] >
           this->deviceStatus.statesCompleted[InfraRedLedOn]) {
-        // Put the raw photodiode voltage into the raw red PPG signal history
-        this->deviceMemory.rawRedPPGSignalHistoryPtr->put(
-            this->deviceMemory.rawPhotodiodeVoltage);
+        // Hold the red reading until the infrared reading completes the frame
+        this->deviceMemory.pendingPPGFrame[RedChannel] =
+            this->deviceMemory.rawPhotodiodeVoltage;
       } else if (this->deviceStatus.statesCompleted[RedLedOn] ==
                  this->deviceStatus.statesCompleted[InfraRedLedOn]) {
-        // Put the raw photodiode voltage into the raw infrared PPG signal
-        // history
-        this->deviceMemory.rawInfraRedPPGSignalHistoryPtr->put(
-            this->deviceMemory.rawPhotodiodeVoltage);
+        // Put the red and infrared readings into the raw PPG signal history
+        // as one frame, stamped with the infrared reading time
+        this->deviceMemory.pendingPPGFrame[InfraRedChannel] =
+            this->deviceMemory.rawPhotodiodeVoltage;
+        this->deviceMemory.rawPPGSignalHistoryPtr->put(
+            this->deviceMemory.pendingPPGFrame,
+            this->deviceMemory.rawPhotodiodeReadTimeUs);
       } else {
         // assert an error.
       }
@@ -301,13 +322,20 @@ void EventController<voltage_data_type, time_data_type, pin_id_data_type>::
     case SignalIsProcessing:
 
       // Code to execute when SignalIsProcessing.
-      // Process the raw red PPG signal history using the filter
-      this->helperClassInstance.filterPtr->process(
+      // Nothing to do if no frame arrived since the last processing
+      if (this->deviceMemory.rawPPGSignalHistoryPtr->version() ==
+          this->deviceMemory.processedRawPPGVersion) {
+        break;
+      }
+      this->deviceMemory.processedRawPPGVersion =
+          this->deviceMemory.rawPPGSignalHistoryPtr->version();
+
+      // Process the raw red and infrared PPG signal histories together, they
+      // share one transform of the filter
+      this->helperClassInstance.filterPtr->processPair(
           this->deviceMemory.rawRedPPGSignalHistoryPtr,
-          this->deviceMemory.filteredRedPPGSignalHistoryPtr);
-      // Process the raw infrared PPG signal history using the filter
-      this->helperClassInstance.filterPtr->process(
           this->deviceMemory.rawInfraRedPPGSignalHistoryPtr,
+          this->deviceMemory.filteredRedPPGSignalHistoryPtr,
           this->deviceMemory.filteredInfraRedPPGSignalHistoryPtr);
       // Calculate the SpO2 value using the filtered PPG signal histories
       this->deviceMemory.spO2Value =
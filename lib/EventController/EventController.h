@@ -11,9 +11,14 @@
 #include "ppg_signal_io/PPGSignalHardwareControllerInterface.h"
 #include "signal_filter/FastFourierTransformInterface.h"
 #include "signal_filter/FilterInterface.h"
+#include "signal_history/MultiChannelSignalHistoryInterface.h"
 #include "signal_history/SignalHistoryInterface.h"
 #include "user_interface/Displayinterface.h"
 
+// Ring buffer capacity of each PPG signal history. It must be a power of two
+// and at least `DeviceSettings::signalHistoryElementsCount`.
+#define PPG_SIGNAL_HISTORY_CAPACITY 64
+
 typedef enum {
   RedLedOn,
   InfraRedLedOn,
@@ -145,10 +150,15 @@ class EventController : public EventControllerInterface {
    */
   typedef struct DeviceMemory {
     voltage_data_type rawPhotodiodeVoltage;
+    time_data_type rawPhotodiodeReadTimeUs;
+    voltage_data_type pendingPPGFrame[PPGChannelTotal];
     time_data_type eventSequenceStartTimeUs;
     time_data_type eventSequenceEndTimeUs;
     time_data_type lastDisplayUpdateTime;         // TODO
     time_data_type lastFilteredSignalUpdateTime;  // TODO
+    MultiChannelSignalHistoryInterface<voltage_data_type, time_data_type>*
+        rawPPGSignalHistoryPtr;
+    unsigned int processedRawPPGVersion;  // Raw history version last filtered
     SignalHistoryInterface<voltage_data_type>* rawRedPPGSignalHistoryPtr;
     SignalHistoryInterface<voltage_data_type>* filteredRedPPGSignalHistoryPtr;
     SignalHistoryInterface<voltage_data_type>* rawInfraRedPPGSignalHistoryPtr;
@@ -0,0 +1,469 @@
+#include "ButterflyKernels.h"
+
+#ifdef SIMDBUTTERFLIES
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Runs one radix-4 pass one butterfly at a time.
+ *
+ * @param real The real parts of the data.
+ * @param imaginary The imaginary parts of the data.
+ * @param n The transform size.
+ * @param span The distance between the four points of a butterfly.
+ * @param count The butterflies run in every group, `span` for a whole pass.
+ * @param twiddles The split twiddles of the pass, six arrays of `span` values.
+ */
+void scalarRadix4Pass(double* real, double* imaginary, unsigned int n,
+                      unsigned int span, unsigned int count,
+                      const double* twiddles) {
+  const double* twiddle1Real = twiddles;
+  const double* twiddle1Imaginary = twiddles + span;
+  const double* twiddle2Real = twiddles + 2 * span;
+  const double* twiddle2Imaginary = twiddles + 3 * span;
+  const double* twiddle3Real = twiddles + 4 * span;
+  const double* twiddle3Imaginary = twiddles + 5 * span;
+
+  for (unsigned int group = 0; group < n; group += 4 * span) {
+    double* xr = real + group;
+    double* xi = imaginary + group;
+    for (unsigned int j = 0; j < count; ++j) {
+      double a0r = xr[j];
+      double a0i = xi[j];
+      double b1r = xr[j + span], b1i = xi[j + span];
+      double a1r = twiddle2Real[j] * b1r - twiddle2Imaginary[j] * b1i;
+      double a1i = twiddle2Real[j] * b1i + twiddle2Imaginary[j] * b1r;
+      double b2r = xr[j + 2 * span], b2i = xi[j + 2 * span];
+      double a2r = twiddle1Real[j] * b2r - twiddle1Imaginary[j] * b2i;
+      double a2i = twiddle1Real[j] * b2i + twiddle1Imaginary[j] * b2r;
+      double b3r = xr[j + 3 * span], b3i = xi[j + 3 * span];
+      double a3r = twiddle3Real[j] * b3r - twiddle3Imaginary[j] * b3i;
+      double a3i = twiddle3Real[j] * b3i + twiddle3Imaginary[j] * b3r;
+
+      double sum01r = a0r + a1r, sum01i = a0i + a1i;
+      double difference01r = a0r - a1r, difference01i = a0i - a1i;
+      double sum23r = a2r + a3r, sum23i = a2i + a3i;
+      double difference23r = a2r - a3r, difference23i = a2i - a3i;
+
+      // -i * (a2 - a3) is (difference23i, -difference23r).
+      xr[j] = sum01r + sum23r;
+      xi[j] = sum01i + sum23i;
+      xr[j + span] = difference01r + difference23i;
+      xi[j + span] = difference01i - difference23r;
+      xr[j + 2 * span] = sum01r - sum23r;
+      xi[j + 2 * span] = sum01i - sum23i;
+      xr[j + 3 * span] = difference01r - difference23i;
+      xi[j + 3 * span] = difference01i + difference23r;
+    }
+  }
+}
+
+#ifdef SIMDBUTTERFLIES
+/**
+ * @brief Runs one radix-4 pass two butterflies at a time with SSE2.
+ *
+ * @param real The real parts of the data.
+ * @param imaginary The imaginary parts of the data.
+ * @param n The transform size.
+ * @param span The distance between the four points of a butterfly, a multiple
+ * of 2.
+ * @param count The butterflies run in every group, a multiple of 2.
+ * @param twiddles The split twiddles of the pass, six arrays of `span` values.
+ */
+void sse2Radix4Pass(double* real, double* imaginary, unsigned int n,
+                    unsigned int span, unsigned int count,
+                    const double* twiddles) {
+  for (unsigned int group = 0; group < n; group += 4 * span) {
+    double* xr = real + group;
+    double* xi = imaginary + group;
+    for (unsigned int j = 0; j < count; j += 2) {
+      __m128d t1r = _mm_loadu_pd(twiddles + j);
+      __m128d t1i = _mm_loadu_pd(twiddles + span + j);
+      __m128d t2r = _mm_loadu_pd(twiddles + 2 * span + j);
+      __m128d t2i = _mm_loadu_pd(twiddles + 3 * span + j);
+      __m128d t3r = _mm_loadu_pd(twiddles + 4 * span + j);
+      __m128d t3i = _mm_loadu_pd(twiddles + 5 * span + j);
+
+      __m128d a0r = _mm_loadu_pd(xr + j);
+      __m128d a0i = _mm_loadu_pd(xi + j);
+      __m128d b1r = _mm_loadu_pd(xr + j + span);
+      __m128d b1i = _mm_loadu_pd(xi + j + span);
+      __m128d a1r = _mm_sub_pd(_mm_mul_pd(t2r, b1r), _mm_mul_pd(t2i, b1i));
+      __m128d a1i = _mm_add_pd(_mm_mul_pd(t2r, b1i), _mm_mul_pd(t2i, b1r));
+      __m128d b2r = _mm_loadu_pd(xr + j + 2 * span);
+      __m128d b2i = _mm_loadu_pd(xi + j + 2 * span);
+      __m128d a2r = _mm_sub_pd(_mm_mul_pd(t1r, b2r), _mm_mul_pd(t1i, b2i));
+      __m128d a2i = _mm_add_pd(_mm_mul_pd(t1r, b2i), _mm_mul_pd(t1i, b2r));
+      __m128d b3r = _mm_loadu_pd(xr + j + 3 * span);
+      __m128d b3i = _mm_loadu_pd(xi + j + 3 * span);
+      __m128d a3r = _mm_sub_pd(_mm_mul_pd(t3r, b3r), _mm_mul_pd(t3i, b3i));
+      __m128d a3i = _mm_add_pd(_mm_mul_pd(t3r, b3i), _mm_mul_pd(t3i, b3r));
+
+      __m128d sum01r = _mm_add_pd(a0r, a1r), sum01i = _mm_add_pd(a0i, a1i);
+      __m128d difference01r = _mm_sub_pd(a0r, a1r);
+      __m128d difference01i = _mm_sub_pd(a0i, a1i);
+      __m128d sum23r = _mm_add_pd(a2r, a3r), sum23i = _mm_add_pd(a2i, a3i);
+      __m128d difference23r = _mm_sub_pd(a2r, a3r);
+      __m128d difference23i = _mm_sub_pd(a2i, a3i);
+
+      _mm_storeu_pd(xr + j, _mm_add_pd(sum01r, sum23r));
+      _mm_storeu_pd(xi + j, _mm_add_pd(sum01i, sum23i));
+      _mm_storeu_pd(xr + j + span, _mm_add_pd(difference01r, difference23i));
+      _mm_storeu_pd(xi + j + span, _mm_sub_pd(difference01i, difference23r));
+      _mm_storeu_pd(xr + j + 2 * span, _mm_sub_pd(sum01r, sum23r));
+      _mm_storeu_pd(xi + j + 2 * span, _mm_sub_pd(sum01i, sum23i));
+      _mm_storeu_pd(xr + j + 3 * span,
+                    _mm_sub_pd(difference01r, difference23i));
+      _mm_storeu_pd(xi + j + 3 * span,
+                    _mm_add_pd(difference01i, difference23r));
+    }
+  }
+}
+
+/**
+ * @brief Runs one radix-4 pass four butterflies at a time with AVX2.
+ *
+ * @param real The real parts of the data.
+ * @param imaginary The imaginary parts of the data.
+ * @param n The transform size.
+ * @param span The distance between the four points of a butterfly, a multiple
+ * of 4.
+ * @param count The butterflies run in every group, a multiple of 4.
+ * @param twiddles The split twiddles of the pass, six arrays of `span` values.
+ *
+ * Multiplications and additions stay separate, fusing them would round
+ * differently from the scalar kernel.
+ */
+__attribute__((target("avx2"))) void avx2Radix4Pass(double* real,
+                                                     double* imaginary,
+                                                     unsigned int n,
+                                                     unsigned int span,
+                                                     unsigned int count,
+                                                     const double* twiddles) {
+  for (unsigned int group = 0; group < n; group += 4 * span) {
+    double* xr = real + group;
+    double* xi = imaginary + group;
+    for (unsigned int j = 0; j < count; j += 4) {
+      __m256d t1r = _mm256_loadu_pd(twiddles + j);
+      __m256d t1i = _mm256_loadu_pd(twiddles + span + j);
+      __m256d t2r = _mm256_loadu_pd(twiddles + 2 * span + j);
+      __m256d t2i = _mm256_loadu_pd(twiddles + 3 * span + j);
+      __m256d t3r = _mm256_loadu_pd(twiddles + 4 * span + j);
+      __m256d t3i = _mm256_loadu_pd(twiddles + 5 * span + j);
+
+      __m256d a0r = _mm256_loadu_pd(xr + j);
+      __m256d a0i = _mm256_loadu_pd(xi + j);
+      __m256d b1r = _mm256_loadu_pd(xr + j + span);
+      __m256d b1i = _mm256_loadu_pd(xi + j + span);
+      __m256d a1r =
+          _mm256_sub_pd(_mm256_mul_pd(t2r, b1r), _mm256_mul_pd(t2i, b1i));
+      __m256d a1i =
+          _mm256_add_pd(_mm256_mul_pd(t2r, b1i), _mm256_mul_pd(t2i, b1r));
+      __m256d b2r = _mm256_loadu_pd(xr + j + 2 * span);
+      __m256d b2i = _mm256_loadu_pd(xi + j + 2 * span);
+      __m256d a2r =
+          _mm256_sub_pd(_mm256_mul_pd(t1r, b2r), _mm256_mul_pd(t1i, b2i));
+      __m256d a2i =
+          _mm256_add_pd(_mm256_mul_pd(t1r, b2i), _mm256_mul_pd(t1i, b2r));
+      __m256d b3r = _mm256_loadu_pd(xr + j + 3 * span);
+      __m256d b3i = _mm256_loadu_pd(xi + j + 3 * span);
+      __m256d a3r =
+          _mm256_sub_pd(_mm256_mul_pd(t3r, b3r), _mm256_mul_pd(t3i, b3i));
+      __m256d a3i =
+          _mm256_add_pd(_mm256_mul_pd(t3r, b3i), _mm256_mul_pd(t3i, b3r));
+
+      __m256d sum01r = _mm256_add_pd(a0r, a1r);
+      __m256d sum01i = _mm256_add_pd(a0i, a1i);
+      __m256d difference01r = _mm256_sub_pd(a0r, a1r);
+      __m256d difference01i = _mm256_sub_pd(a0i, a1i);
+      __m256d sum23r = _mm256_add_pd(a2r, a3r);
+      __m256d sum23i = _mm256_add_pd(a2i, a3i);
+      __m256d difference23r = _mm256_sub_pd(a2r, a3r);
+      __m256d difference23i = _mm256_sub_pd(a2i, a3i);
+
+      _mm256_storeu_pd(xr + j, _mm256_add_pd(sum01r, sum23r));
+      _mm256_storeu_pd(xi + j, _mm256_add_pd(sum01i, sum23i));
+      _mm256_storeu_pd(xr + j + span,
+                       _mm256_add_pd(difference01r, difference23i));
+      _mm256_storeu_pd(xi + j + span,
+                       _mm256_sub_pd(difference01i, difference23r));
+      _mm256_storeu_pd(xr + j + 2 * span, _mm256_sub_pd(sum01r, sum23r));
+      _mm256_storeu_pd(xi + j + 2 * span, _mm256_sub_pd(sum01i, sum23i));
+      _mm256_storeu_pd(xr + j + 3 * span,
+                       _mm256_sub_pd(difference01r, difference23i));
+      _mm256_storeu_pd(xi + j + 3 * span,
+                       _mm256_add_pd(difference01i, difference23r));
+    }
+  }
+}
+#endif
+
+/**
+ * @brief Runs the radix-2 pass that starts a transform of odd `log2n`.
+ *
+ * @param real The real parts of the data.
+ * @param imaginary The imaginary parts of the data.
+ * @param n The number of points.
+ */
+void radix2Pass(double* real, double* imaginary, unsigned int n) {
+  for (unsigned int k = 0; k < n; k += 2) {
+    double ur = real[k], ui = imaginary[k];
+    double tr = real[k + 1], ti = imaginary[k + 1];
+    real[k] = ur + tr;
+    imaginary[k] = ui + ti;
+    real[k + 1] = ur - tr;
+    imaginary[k + 1] = ui - ti;
+  }
+}
+
+/**
+ * @brief Runs part of a radix-4 pass on the widest kernel its butterfly count
+ * allows.
+ *
+ * @param level The kernel to use.
+ * @param real The real parts of the data.
+ * @param imaginary The imaginary parts of the data.
+ * @param n The number of points.
+ * @param span The distance between the four points of a butterfly.
+ * @param count The butterflies run in every group, `span` for a whole pass.
+ * @param twiddles The split twiddles of the pass.
+ */
+void radix4Pass(ButterflyKernelLevel level, double* real, double* imaginary,
+                unsigned int n, unsigned int span, unsigned int count,
+                const double* twiddles) {
+#ifdef SIMDBUTTERFLIES
+  if (level == AVX2ButterflyKernel && count % 4 == 0) {
+    avx2Radix4Pass(real, imaginary, n, span, count, twiddles);
+  } else if (level != ScalarButterflyKernel && count % 2 == 0) {
+    sse2Radix4Pass(real, imaginary, n, span, count, twiddles);
+  } else {
+    scalarRadix4Pass(real, imaginary, n, span, count, twiddles);
+  }
+#else
+  (void)level;
+  scalarRadix4Pass(real, imaginary, n, span, count, twiddles);
+#endif
+}
+
+}  // namespace
+
+/**
+ * @brief Detects the widest butterfly kernel the CPU supports.
+ *
+ * @return The kernel level, detected on the first call and cached.
+ */
+ButterflyKernelLevel activeButterflyKernelLevel() {
+#ifdef SIMDBUTTERFLIES
+  static const ButterflyKernelLevel level =
+      __builtin_cpu_supports("avx2") ? AVX2ButterflyKernel
+                                     : SSE2ButterflyKernel;
+  return level;
+#else
+  return ScalarButterflyKernel;
+#endif
+};
+
+/**
+ * @brief Computes the number of values in the split twiddle table of the
+ * radix-4 passes of a transform size.
+ *
+ * @param log2n The base 2 logarithm of the transform size.
+ * @return The number of values.
+ */
+std::size_t radix4SplitTwiddleCount(unsigned int log2n) {
+  const std::size_t n = static_cast<std::size_t>(1) << log2n;
+  std::size_t count = 0;
+  for (std::size_t span = (log2n & 1u) ? 2 : 1; 4 * span <= n; span *= 4) {
+    count += 6 * span;
+  }
+  return count;
+};
+
+/**
+ * @brief Lays out the twiddles of every radix-4 pass of a transform as
+ * contiguous real and imaginary arrays, so the vector kernels load them
+ * without gathering.
+ *
+ * @param twiddles The first `n / 2` twiddles of the transform.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @param passTwiddles The table, `radix4SplitTwiddleCount(log2n)` values.
+ *
+ * Every pass takes six arrays of `span` values: the real and imaginary parts
+ * of `W^j`, `W^2j` and `W^3j`. Twiddles past `n / 2` are the negated ones
+ * `n / 2` before them.
+ */
+void buildRadix4SplitTwiddles(const std::complex<double>* twiddles,
+                              unsigned int log2n, double* passTwiddles) {
+  const unsigned int n = 1u << log2n;
+  const unsigned int halfN = n >> 1;
+  for (unsigned int span = (log2n & 1u) ? 2 : 1; 4 * span <= n; span *= 4) {
+    const unsigned int twiddleStride = n / (4 * span);
+    for (unsigned int power = 1; power <= 3; ++power) {
+      double* passReal = passTwiddles + 2 * (power - 1) * span;
+      double* passImaginary = passReal + span;
+      for (unsigned int j = 0; j < span; ++j) {
+        unsigned int k = power * j * twiddleStride;
+        std::complex<double> w =
+            k < halfN ? twiddles[k] : -twiddles[k - halfN];
+        passReal[j] = w.real();
+        passImaginary[j] = w.imag();
+      }
+    }
+    passTwiddles += 6 * span;
+  }
+};
+
+/**
+ * @brief Runs the butterflies of a transform on split real and imaginary
+ * arrays in radix-4 passes, with one radix-2 pass first when `log2n` is odd.
+ *
+ * @param level The kernel to use.
+ * @param real The real parts of the bit-reversed input, transformed in place.
+ * @param imaginary The imaginary parts, transformed in place.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @param passTwiddles The table filled by buildRadix4SplitTwiddles().
+ *
+ * Passes whose span is narrower than the vector width run on the scalar
+ * kernel.
+ */
+void radix4SplitButterflies(ButterflyKernelLevel level, double* real,
+                            double* imaginary, unsigned int log2n,
+                            const double* passTwiddles) {
+  const unsigned int n = 1u << log2n;
+  unsigned int span = 1;
+
+  if (log2n & 1u) {
+    radix2Pass(real, imaginary, n);
+    span = 2;
+  }
+
+  for (; 4 * span <= n; span *= 4) {
+    radix4Pass(level, real, imaginary, n, span, span, passTwiddles);
+    passTwiddles += 6 * span;
+  }
+};
+
+#ifdef PARALLELBUTTERFLIES
+/**
+ * @brief Runs radix4SplitButterflies() as tasks of a worker pool.
+ *
+ * @param level The kernel to use.
+ * @param real The real parts of the bit-reversed input, transformed in place.
+ * @param imaginary The imaginary parts, transformed in place.
+ * @param log2n The base 2 logarithm of the transform size, with
+ * `2 ^ log2n >= PARALLELBLOCKSIZE`.
+ * @param passTwiddles The table filled by buildRadix4SplitTwiddles().
+ * @param workers The pool running the tasks.
+ *
+ * The passes whose groups fit in a block of `PARALLELBLOCKSIZE` points run
+ * block by block, one task per block, so a block stays in the cache of its
+ * core. The wider passes are cut into tasks of `PARALLELCHUNKSIZE`
+ * butterflies. Every butterfly computes the same operations as in the serial
+ * function, so the results are bit-identical to it for any number of threads.
+ */
+void radix4SplitButterflies(ButterflyKernelLevel level, double* real,
+                            double* imaginary, unsigned int log2n,
+                            const double* passTwiddles, WorkerPool& workers) {
+  const unsigned int n = 1u << log2n;
+  const unsigned int firstSpan = (log2n & 1u) ? 2 : 1;
+
+  workers.run(n / PARALLELBLOCKSIZE, [&](unsigned int task,
+                                          unsigned int /*thread*/) {
+    double* blockReal = real + task * PARALLELBLOCKSIZE;
+    double* blockImaginary = imaginary + task * PARALLELBLOCKSIZE;
+    const double* blockTwiddles = passTwiddles;
+    if (log2n & 1u) {
+      radix2Pass(blockReal, blockImaginary, PARALLELBLOCKSIZE);
+    }
+    for (unsigned int span = firstSpan; 4 * span <= PARALLELBLOCKSIZE;
+         span *= 4) {
+      radix4Pass(level, blockReal, blockImaginary, PARALLELBLOCKSIZE, span,
+                 span, blockTwiddles);
+      blockTwiddles += 6 * span;
+    }
+  });
+
+  unsigned int span = firstSpan;
+  for (; 4 * span <= PARALLELBLOCKSIZE; span *= 4) {
+    passTwiddles += 6 * span;
+  }
+  for (; 4 * span <= n; span *= 4) {
+    const unsigned int groupSize = 4 * span;
+    const unsigned int chunksPerGroup = span / PARALLELCHUNKSIZE;
+    workers.run(n / groupSize * chunksPerGroup,
+                [&](unsigned int task, unsigned int /*thread*/) {
+                  const unsigned int first =
+                      (task / chunksPerGroup) * groupSize +
+                      (task % chunksPerGroup) * PARALLELCHUNKSIZE;
+                  radix4Pass(level, real + first, imaginary + first,
+                             groupSize, span, PARALLELCHUNKSIZE,
+                             passTwiddles + first % groupSize);
+                });
+    passTwiddles += 6 * span;
+  }
+};
+#endif
+
+/**
+ * @brief Runs the butterflies of a transform with the vector kernels when the
+ * CPU and the element type allow it.
+ *
+ * @param data The bit-reversed input, transformed in place.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @param passTwiddles The table filled by buildSimdTwiddles().
+ * @param scratch The buffer of the split data, only grown when too small.
+ * @return `false` if nothing was done and the scalar kernels must run.
+ *
+ * The data is split into real and imaginary arrays for the passes and
+ * interleaved again afterwards.
+ */
+bool runSimdButterflies(std::complex<double>* data, unsigned int log2n,
+                        const std::vector<double>& passTwiddles,
+                        std::vector<double>& scratch, WorkerPool* workers) {
+  ButterflyKernelLevel level = activeButterflyKernelLevel();
+  if (level == ScalarButterflyKernel || passTwiddles.empty()) {
+    return false;
+  }
+
+  const unsigned int n = 1u << log2n;
+  if (scratch.size() < 2 * n) {
+    scratch.resize(2 * n);
+  }
+  double* real = scratch.data();
+  double* imaginary = real + n;
+#ifdef PARALLELBUTTERFLIES
+  if (workers && n >= PARALLELBLOCKSIZE) {
+    workers->run(n / PARALLELBLOCKSIZE, [&](unsigned int task,
+                                             unsigned int /*thread*/) {
+      const unsigned int first = task * PARALLELBLOCKSIZE;
+      for (unsigned int i = first; i < first + PARALLELBLOCKSIZE; ++i) {
+        real[i] = data[i].real();
+        imaginary[i] = data[i].imag();
+      }
+    });
+    radix4SplitButterflies(level, real, imaginary, log2n, passTwiddles.data(),
+                           *workers);
+    workers->run(n / PARALLELBLOCKSIZE, [&](unsigned int task,
+                                             unsigned int /*thread*/) {
+      const unsigned int first = task * PARALLELBLOCKSIZE;
+      for (unsigned int i = first; i < first + PARALLELBLOCKSIZE; ++i) {
+        data[i] = std::complex<double>(real[i], imaginary[i]);
+      }
+    });
+    return true;
+  }
+#else
+  (void)workers;
+#endif
+  for (unsigned int i = 0; i < n; ++i) {
+    real[i] = data[i].real();
+    imaginary[i] = data[i].imag();
+  }
+  radix4SplitButterflies(level, real, imaginary, log2n, passTwiddles.data());
+  for (unsigned int i = 0; i < n; ++i) {
+    data[i] = std::complex<double>(real[i], imaginary[i]);
+  }
+  return true;
+};
@@ -0,0 +1,141 @@
+#ifndef BUTTERFLY_KERNELS_H
+#define BUTTERFLY_KERNELS_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "WorkerPool.h"
+
+// The vector kernels exist on x86-64 hosts only, SSE2 is part of the base
+// instruction set there and AVX2 is enabled per function and checked at run
+// time, so the native build needs no extra compiler flags.
+#if defined(EXCLUDEARDUINOLIB) && defined(__x86_64__) && defined(__GNUC__)
+#define SIMDBUTTERFLIES
+#endif
+
+#ifdef PARALLELBUTTERFLIES
+// Points of the blocks transformed by one task before the passes that span
+// several blocks, 64 KiB of split data so a block stays in a core's cache.
+const unsigned int PARALLELBLOCKSIZE = 4096;
+// Butterflies of a pass spanning several blocks handed to a task at once
+const unsigned int PARALLELCHUNKSIZE = 1024;
+#endif
+
+/**
+ * @brief Instruction sets the radix-4 butterflies can run with.
+ */
+typedef enum {
+  ScalarButterflyKernel,
+  SSE2ButterflyKernel,
+  AVX2ButterflyKernel
+} ButterflyKernelLevel;
+
+/**
+ * @brief Detects the widest butterfly kernel the CPU supports.
+ *
+ * @return The kernel level, detected on the first call and cached.
+ */
+ButterflyKernelLevel activeButterflyKernelLevel();
+
+/**
+ * @brief Computes the number of values in the split twiddle table of the
+ * radix-4 passes of a transform size.
+ *
+ * @param log2n The base 2 logarithm of the transform size.
+ * @return The number of values.
+ */
+std::size_t radix4SplitTwiddleCount(unsigned int log2n);
+
+/**
+ * @brief Lays out the twiddles of every radix-4 pass of a transform as
+ * contiguous real and imaginary arrays, so the vector kernels load them
+ * without gathering.
+ *
+ * @param twiddles The first `n / 2` twiddles of the transform.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @param passTwiddles The table, `radix4SplitTwiddleCount(log2n)` values.
+ */
+void buildRadix4SplitTwiddles(const std::complex<double>* twiddles,
+                              unsigned int log2n, double* passTwiddles);
+
+/**
+ * @brief Runs the butterflies of a transform on split real and imaginary
+ * arrays in radix-4 passes, with one radix-2 pass first when `log2n` is odd.
+ *
+ * @param level The kernel to use. Every level computes the same operations in
+ * the same order, so their results are bit-identical.
+ * @param real The real parts of the bit-reversed input, transformed in place.
+ * @param imaginary The imaginary parts, transformed in place.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @param passTwiddles The table filled by buildRadix4SplitTwiddles().
+ */
+void radix4SplitButterflies(ButterflyKernelLevel level, double* real,
+                            double* imaginary, unsigned int log2n,
+                            const double* passTwiddles);
+
+#ifdef PARALLELBUTTERFLIES
+/**
+ * @brief Runs radix4SplitButterflies() as tasks of a worker pool, first every
+ * block of `PARALLELBLOCKSIZE` points on its own, then the wider passes in
+ * chunks of `PARALLELCHUNKSIZE` butterflies.
+ *
+ * @param level The kernel to use.
+ * @param real The real parts of the bit-reversed input, transformed in place.
+ * @param imaginary The imaginary parts, transformed in place.
+ * @param log2n The base 2 logarithm of the transform size, with
+ * `2 ^ log2n >= PARALLELBLOCKSIZE`.
+ * @param passTwiddles The table filled by buildRadix4SplitTwiddles().
+ * @param workers The pool running the tasks. The results are bit-identical to
+ * the serial function for any number of threads.
+ */
+void radix4SplitButterflies(ButterflyKernelLevel level, double* real,
+                            double* imaginary, unsigned int log2n,
+                            const double* passTwiddles, WorkerPool& workers);
+#endif
+
+/**
+ * @brief Builds the split twiddle table of a plan when vector kernels exist
+ * for its element type.
+ *
+ * @param twiddles The first `n / 2` twiddles of the transform.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @param passTwiddles The table to fill, left empty for other element types.
+ */
+inline void buildSimdTwiddles(
+    const std::vector<std::complex<double>>& twiddles, unsigned int log2n,
+    std::vector<double>& passTwiddles) {
+  passTwiddles.resize(radix4SplitTwiddleCount(log2n));
+  buildRadix4SplitTwiddles(twiddles.data(), log2n, passTwiddles.data());
+}
+
+template <typename element_datatype>
+inline void buildSimdTwiddles(
+    const std::vector<std::complex<element_datatype>>& /*twiddles*/,
+    unsigned int /*log2n*/, std::vector<element_datatype>& /*passTwiddles*/) {}
+
+/**
+ * @brief Runs the butterflies of a transform with the vector kernels when the
+ * CPU and the element type allow it.
+ *
+ * @param data The bit-reversed input, transformed in place.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @param passTwiddles The table filled by buildSimdTwiddles().
+ * @param scratch The buffer of the split data, only grown when too small.
+ * @param workers The pool running the transform, or null to run it on the
+ * calling thread.
+ * @return `false` if nothing was done and the scalar kernels must run.
+ */
+bool runSimdButterflies(std::complex<double>* data, unsigned int log2n,
+                        const std::vector<double>& passTwiddles,
+                        std::vector<double>& scratch, WorkerPool* workers);
+
+template <typename element_datatype>
+inline bool runSimdButterflies(
+    std::complex<element_datatype>* /*data*/, unsigned int /*log2n*/,
+    const std::vector<element_datatype>& /*passTwiddles*/,
+    std::vector<element_datatype>& /*scratch*/, WorkerPool* /*workers*/) {
+  return false;
+}
+
+#endif
@@ -1,61 +1,948 @@
 #include "FastFourierTransform.h"
 
+#include <algorithm>
 #include <cmath>
 #include <complex>
+#include <utility>
 #include <vector>
 
-// https://www.oreilly.com/library/view/c-cookbook/0596007612/ch11s18.html
+/**
+ * @brief Constructor for the FastFourierTransform class.
+ * @param threadCount The number of threads running large native transforms,
+ * the calling thread included, or 0 for one per core. The device build always
+ * runs on the calling thread.
+ */
 template <typename element_datatype>
-unsigned int FastFourierTransform<element_datatype>::bitReverse(
-    unsigned int num, unsigned int nBits) {
-  unsigned int reversed = 0;
-  for (unsigned int i = 0; i < nBits; i++) {
-    reversed <<= 1;
-    reversed |= (num & 1);
-    num >>= 1;
+FastFourierTransform<element_datatype>::FastFourierTransform(
+    unsigned int threadCount) {
+#ifdef PARALLELBUTTERFLIES
+  workers.reset(new WorkerPool(threadCount));
+#else
+  (void)threadCount;
+#endif
+};
+
+/**
+ * @brief Retrieves the plan of a transform size, building it on first use.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @return The cached plan.
+ */
+template <typename element_datatype>
+const typename FastFourierTransform<element_datatype>::fft_plan_data_type&
+FastFourierTransform<element_datatype>::getPlan(unsigned int log2n) {
+  if (plans.size() <= log2n) {
+    plans.resize(log2n + 1);
   }
-  return reversed;
-}
+  fft_plan_data_type& plan = plans[log2n];
+  if (plan.bitReversal.empty()) {
+    plan.log2n = log2n;
+    buildPlan(plan);
+  }
+  return plan;
+};
 
+/**
+ * @brief Computes the twiddle table and bit-reversal permutation of a
+ * transform size.
+ * @param plan The plan to fill, its `log2n` must already be set.
+ *
+ * Only the first quarter of the twiddles is computed with cos() and sin(), the
+ * second quarter is the first one rotated by -pi/2. Every twiddle is computed
+ * directly, so no rounding error accumulates across a stage.
+ */
 template <typename element_datatype>
-void FastFourierTransform<element_datatype>::fft(
-    std::vector<std::complex<element_datatype>>& input,
-    std::vector<std::complex<element_datatype>>& output, unsigned int log2n) {
-  typedef
-      typename std::iterator_traits<std::complex<element_datatype>*>::value_type
-          complex;
+void FastFourierTransform<element_datatype>::buildPlan(
+    fft_plan_data_type& plan) {
+  const unsigned int n = 1u << plan.log2n;
+  const unsigned int halfN = n >> 1;
+  const unsigned int quarterN = n >> 2;
 
-  const element_datatype PI = acos(-1);
-  const complex J(0, 1);
-  unsigned int n = 1 << log2n;
-#ifdef UNIT_TEST
-  // if (std::tuple_size(a) != std::tuple_size(b)) {
-  //   throw std::invalid_argument("Input vectors must have the same size");
-  // }
-  // if ((1 << n) < std::tuple_size(a)) {
-  //   throw std::invalid_argument("`2 ^ log2n` is smaller than the array
-  //   size.");
-  // }
+  // The reversal of i is the reversal of i / 2 shifted right, with the lowest
+  // bit of i moved to the top.
+  plan.bitReversal.assign(n, 0);
+  for (unsigned int i = 1; i < n; ++i) {
+    plan.bitReversal[i] = (plan.bitReversal[i >> 1] >> 1) |
+                          ((i & 1u) << (plan.log2n - 1));
+  }
+
+  plan.twiddles.assign(halfN, std::complex<element_datatype>(1, 0));
+  const double PI = acos(-1);
+  for (unsigned int k = 1; k < quarterN; ++k) {
+    double angle = 2 * PI * k / n;
+    plan.twiddles[k] = std::complex<element_datatype>(
+        static_cast<element_datatype>(cos(angle)),
+        static_cast<element_datatype>(-sin(angle)));
+  }
+  for (unsigned int k = quarterN; quarterN > 0 && k < halfN; ++k) {
+    const std::complex<element_datatype>& w = plan.twiddles[k - quarterN];
+    plan.twiddles[k] = std::complex<element_datatype>(w.imag(), -w.real());
+  }
+#ifdef SIMDBUTTERFLIES
+  buildSimdTwiddles(plan.twiddles, plan.log2n, plan.simdTwiddles);
+#endif
+};
+
+/**
+ * @brief Runs the butterflies of a transform, on the worker pool from
+ * `PARALLELMINIMUMSIZE` on. Native x86-64 builds use the vector radix-4
+ * kernels from `SIMDMINIMUMSIZE` on.
+ * @param data The bit-reversed input, transformed in place.
+ * @param plan The plan of the transform size.
+ *
+ * Large transforms take the parallel path even without worker threads, so
+ * their results are the same for every thread count.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::butterflies(
+    std::complex<element_datatype>* data, const fft_plan_data_type& plan) {
+  const unsigned int n = 1u << plan.log2n;
+#ifdef SIMDBUTTERFLIES
+  if (n >= SIMDMINIMUMSIZE &&
+      runSimdButterflies(data, plan.log2n, plan.simdTwiddles, simdScratch,
+                         n >= PARALLELMINIMUMSIZE ? workers.get() : nullptr)) {
+    return;
+  }
+#endif
+#ifdef PARALLELBUTTERFLIES
+  if (n >= PARALLELMINIMUMSIZE) {
+    parallelButterflies(data, plan);
+    return;
+  }
+#endif
+  scalarButterflies(data, plan);
+};
+
+/**
+ * @brief Runs the butterflies of a transform on the calling thread with the
+ * scalar kernels, radix-4 below `SPLITRADIXMINIMUMSIZE` and split-radix from
+ * there on.
+ * @param data The bit-reversed input, transformed in place.
+ * @param plan The plan of the transform size.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::scalarButterflies(
+    std::complex<element_datatype>* data, const fft_plan_data_type& plan) {
+  if ((1u << plan.log2n) >= SPLITRADIXMINIMUMSIZE) {
+    splitRadixButterflies(data, 1u << plan.log2n, plan);
+  } else {
+    radix4Butterflies(data, plan);
+  }
+};
+
+#ifdef PARALLELBUTTERFLIES
+/**
+ * @brief Runs the butterflies of a transform with the scalar kernels as
+ * `2 ^ PARALLELSPLITLOG2` sub-transforms followed by radix-4 passes cut into
+ * chunks, all of them tasks of the worker pool.
+ * @param data The bit-reversed input, transformed in place.
+ * @param plan The plan of the transform size.
+ *
+ * In bit-reversed order every consecutive block of `n / 2^PARALLELSPLITLOG2`
+ * points is a sub-transform of its own, and the butterflies of one pass are
+ * independent of each other. Every butterfly computes the same operations
+ * whichever thread runs it, so the results do not depend on the scheduling.
+ * Each sub-transform fits in a core's cache, only the combining passes stream
+ * the whole transform.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::parallelButterflies(
+    std::complex<element_datatype>* data, const fft_plan_data_type& plan) {
+  const unsigned int n = 1u << plan.log2n;
+  const unsigned int subLog2n = plan.log2n - PARALLELSPLITLOG2;
+  const unsigned int subN = 1u << subLog2n;
+  // Smaller plans are already allocated, so `plan` stays valid.
+  const fft_plan_data_type& subPlan = getPlan(subLog2n);
+
+  workers->run(1u << PARALLELSPLITLOG2,
+               [&](unsigned int task, unsigned int /*thread*/) {
+                 scalarButterflies(data + task * subN, subPlan);
+               });
+
+  for (unsigned int span = subN; span < n; span *= 4) {
+    const unsigned int groupSize = 4 * span;
+    const unsigned int twiddleStride = n / groupSize;
+    const unsigned int chunksPerGroup = span / PARALLELCHUNKSIZE;
+    workers->run(n / groupSize * chunksPerGroup,
+                 [&](unsigned int task, unsigned int /*thread*/) {
+                   std::complex<element_datatype>* x =
+                       data + (task / chunksPerGroup) * groupSize;
+                   const unsigned int first =
+                       (task % chunksPerGroup) * PARALLELCHUNKSIZE;
+                   for (unsigned int j = first; j < first + PARALLELCHUNKSIZE;
+                        ++j) {
+                     radix4Butterfly(x, j, span, j * twiddleStride, plan);
+                   }
+                 });
+  }
+};
+
+/**
+ * @brief Retrieves the four-step plan of a transform size, building it on
+ * first use.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @return The cached plan, whose buffers the transform overwrites.
+ *
+ * The twiddle `e^(-2 pi i m / n)` of the four-step algorithm is the product of
+ * a coarse and a fine one, for the high and low bits of `m`, so the tables
+ * hold `n1 + n2` entries instead of `n`.
+ */
+template <typename element_datatype>
+typename FastFourierTransform<element_datatype>::four_step_plan_data_type&
+FastFourierTransform<element_datatype>::getFourStepPlan(unsigned int log2n) {
+  if (fourStepPlans.size() <= log2n) {
+    fourStepPlans.resize(log2n + 1);
+  }
+  four_step_plan_data_type& plan = fourStepPlans[log2n];
+  if (!plan.scratch.empty()) {
+    return plan;
+  }
+
+  plan.rowsLog2n = log2n / 2;
+  plan.columnsLog2n = log2n - plan.rowsLog2n;
+  const std::size_t n = static_cast<std::size_t>(1) << log2n;
+  const unsigned int rows = 1u << plan.rowsLog2n;
+  const unsigned int columns = 1u << plan.columnsLog2n;
+  const double PI = acos(-1);
+  plan.coarseTwiddles.resize(rows);
+  for (unsigned int k = 0; k < rows; ++k) {
+    double angle = 2 * PI * k / rows;
+    plan.coarseTwiddles[k] = std::complex<element_datatype>(
+        static_cast<element_datatype>(cos(angle)),
+        static_cast<element_datatype>(-sin(angle)));
+  }
+  plan.fineTwiddles.resize(columns);
+  for (unsigned int k = 0; k < columns; ++k) {
+    double angle = 2 * PI * k / n;
+    plan.fineTwiddles[k] = std::complex<element_datatype>(
+        static_cast<element_datatype>(cos(angle)),
+        static_cast<element_datatype>(-sin(angle)));
+  }
+  plan.scratch.resize(static_cast<std::size_t>(rows) *
+                      (columns + FOURSTEPPADDING));
+  const unsigned int threadCount = workers->getThreadCount();
+  plan.columnBlocks.assign(threadCount,
+                           std::vector<std::complex<element_datatype>>(
+                               FOURSTEPBLOCKSIZE * (rows + FOURSTEPPADDING)));
+  plan.simdScratch.resize(threadCount);
+  return plan;
+};
+
+/**
+ * @brief Computes a transform with the four-step algorithm: FFTs of the
+ * columns of an `n1 x n2` matrix, a twiddle multiplication, FFTs of its rows
+ * and a blocked transpose.
+ * @param data The interleaved complex data, transformed in place.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * With `j = j1 n2 + j2` and `k = k1 + n1 k2`, the transform is
+ * `X[k] = sum_j2(W_n2^(j2 k2) W_n^(j2 k1) sum_j1(W_n1^(j1 k1) x[j]))`. The
+ * inner sums are the column FFTs, computed `FOURSTEPBLOCKSIZE` columns at a
+ * time in a contiguous buffer and written with their twiddle to the scratch
+ * matrix. The outer sums are the FFTs of its contiguous rows, and every
+ * block of `FOURSTEPBLOCKSIZE` transformed rows is transposed, `(k1, k2)` to
+ * `k1 + n1 k2`, while it is still in cache. The data is read and written once
+ * per step, every FFT runs in cache, and the blocks are tasks of the worker
+ * pool.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::fourStepTransform(
+    std::complex<element_datatype>* data, unsigned int log2n) {
+  typedef std::complex<element_datatype> complex_type;
+  four_step_plan_data_type& fourStep = getFourStepPlan(log2n);
+  const unsigned int rowsLog2n = fourStep.rowsLog2n;
+  const unsigned int columnsLog2n = fourStep.columnsLog2n;
+  const unsigned int rows = 1u << rowsLog2n;
+  const unsigned int columns = 1u << columnsLog2n;
+  const unsigned int blockStride = rows + FOURSTEPPADDING;
+  const std::size_t scratchStride = columns + FOURSTEPPADDING;
+  // The larger plan is built first, so building the smaller one cannot move
+  // it.
+  const fft_plan_data_type& rowPlan = getPlan(columnsLog2n);
+  const fft_plan_data_type& columnPlan = getPlan(rowsLog2n);
+  complex_type* scratch = fourStep.scratch.data();
+
+  // Column FFTs and twiddle multiplication. The twiddles are finite, so the
+  // products skip the checks for infinities of the complex operator.
+  workers->run(
+      columns / FOURSTEPBLOCKSIZE, [&](unsigned int task, unsigned int thread) {
+        complex_type* block = fourStep.columnBlocks[thread].data();
+        const unsigned int first = task * FOURSTEPBLOCKSIZE;
+        for (unsigned int j1 = 0; j1 < rows; ++j1) {
+          const complex_type* input =
+              data + (static_cast<std::size_t>(j1) << columnsLog2n) + first;
+          for (unsigned int b = 0; b < FOURSTEPBLOCKSIZE; ++b) {
+            block[b * blockStride + j1] = input[b];
+          }
+        }
+        for (unsigned int b = 0; b < FOURSTEPBLOCKSIZE; ++b) {
+          cachedTransform(block + b * blockStride, columnPlan,
+                          fourStep.simdScratch[thread]);
+        }
+        for (unsigned int k1 = 0; k1 < rows; ++k1) {
+          complex_type* output = scratch + k1 * scratchStride + first;
+          for (unsigned int b = 0; b < FOURSTEPBLOCKSIZE; ++b) {
+            const std::size_t m = static_cast<std::size_t>(first + b) * k1;
+            const complex_type& c = fourStep.coarseTwiddles[m >> columnsLog2n];
+            const complex_type& f = fourStep.fineTwiddles[m & (columns - 1)];
+            const complex_type& x = block[b * blockStride + k1];
+            element_datatype wReal = c.real() * f.real() - c.imag() * f.imag();
+            element_datatype wImaginary =
+                c.real() * f.imag() + c.imag() * f.real();
+            output[b] =
+                complex_type(x.real() * wReal - x.imag() * wImaginary,
+                             x.real() * wImaginary + x.imag() * wReal);
+          }
+        }
+      });
+
+  // Row FFTs, each block of rows is transposed while it is still in cache
+  workers->run(
+      rows / FOURSTEPBLOCKSIZE, [&](unsigned int task, unsigned int thread) {
+        const unsigned int first = task * FOURSTEPBLOCKSIZE;
+        complex_type* block = scratch + first * scratchStride;
+        for (unsigned int b = 0; b < FOURSTEPBLOCKSIZE; ++b) {
+          cachedTransform(block + b * scratchStride, rowPlan,
+                          fourStep.simdScratch[thread]);
+        }
+        for (unsigned int k2 = 0; k2 < columns; ++k2) {
+          complex_type* output =
+              data + (static_cast<std::size_t>(k2) << rowsLog2n) + first;
+          for (unsigned int b = 0; b < FOURSTEPBLOCKSIZE; ++b) {
+            output[b] = block[b * scratchStride + k2];
+          }
+        }
+      });
+};
+
+/**
+ * @brief Computes a transform that fits in cache on a caller-owned vector
+ * kernel buffer, so several of them can run at once.
+ * @param data The interleaved complex data, transformed in place.
+ * @param plan The plan of the transform size.
+ * @param scratch The split data buffer of the vector kernels.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::cachedTransform(
+    std::complex<element_datatype>* data, const fft_plan_data_type& plan,
+    std::vector<element_datatype>& scratch) {
+  const unsigned int n = 1u << plan.log2n;
+  for (unsigned int i = 0; i < n; ++i) {
+    unsigned int reversed = plan.bitReversal[i];
+    if (i < reversed) {
+      std::swap(data[i], data[reversed]);
+    }
+  }
+#ifdef SIMDBUTTERFLIES
+  if (n >= SIMDMINIMUMSIZE && runSimdButterflies(data, plan.log2n,
+                                                 plan.simdTwiddles, scratch,
+                                                 nullptr)) {
+    return;
+  }
+#else
+  (void)scratch;
 #endif
-  for (int i = 0; i < n; ++i) {
-    output[this->bitReverse(i, log2n)] = input[i];
-  }
-  for (unsigned int s = 1; s <= log2n; ++s) {
-    int m = 1 << s;
-    int m2 = m >> 1;
-    std::complex<element_datatype> w(1.0, 0);
-    std::complex<element_datatype> wm = std::exp(-J * (PI / m2));
-    for (int j = 0; j < m2; ++j) {
-      for (int k = j; k < n; k += m) {
-        std::complex<element_datatype> t = w * output[k + m2];
-        std::complex<element_datatype> u = output[k];
-        output[k] = u + t;
-        output[k + m2] = u - t;
+  scalarButterflies(data, plan);
+};
+#endif
+
+/**
+ * @brief Runs the butterflies of a transform in radix-4 passes, with one
+ * radix-2 pass first when `log2n` is odd.
+ * @param data The bit-reversed input, transformed in place.
+ * @param plan The plan of the transform size.
+ *
+ * Every radix-4 pass fuses two radix-2 passes, so it needs 3 twiddle
+ * multiplications per 4 points instead of 4 and reads the data half as often.
+ * Each group of `4 * span` points is finished before the next one is read.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::radix4Butterflies(
+    std::complex<element_datatype>* data, const fft_plan_data_type& plan) {
+  const unsigned int n = 1u << plan.log2n;
+  unsigned int span = 1;
+
+  if (plan.log2n & 1u) {
+    for (unsigned int k = 0; k < n; k += 2) {
+      std::complex<element_datatype> u = data[k];
+      std::complex<element_datatype> t = data[k + 1];
+      data[k] = u + t;
+      data[k + 1] = u - t;
+    }
+    span = 2;
+  }
+
+  for (; 4 * span <= n; span *= 4) {
+    const unsigned int groupSize = 4 * span;
+    const unsigned int twiddleStride = n / groupSize;
+    for (unsigned int group = 0; group < n; group += groupSize) {
+      std::complex<element_datatype>* x = data + group;
+      for (unsigned int j = 0; j < span; ++j) {
+        radix4Butterfly(x, j, span, j * twiddleStride, plan);
       }
-      w *= wm;
     }
   }
-}
+};
+
+/**
+ * @brief Computes one butterfly of a radix-4 pass.
+ * @param x The first point of the butterfly group.
+ * @param j The index of the butterfly in its group.
+ * @param span The distance between the four points of the butterfly.
+ * @param twiddleIndex The index of the twiddle of the first point.
+ * @param plan The plan of the transform size.
+ */
+template <typename element_datatype>
+inline void FastFourierTransform<element_datatype>::radix4Butterfly(
+    std::complex<element_datatype>* x, unsigned int j, unsigned int span,
+    unsigned int twiddleIndex, const fft_plan_data_type& plan) {
+  std::complex<element_datatype> a0 = x[j];
+  std::complex<element_datatype> a1 =
+      twiddleAt(plan, 2 * twiddleIndex) * x[j + span];
+  std::complex<element_datatype> a2 =
+      twiddleAt(plan, twiddleIndex) * x[j + 2 * span];
+  std::complex<element_datatype> a3 =
+      twiddleAt(plan, 3 * twiddleIndex) * x[j + 3 * span];
+
+  std::complex<element_datatype> sum01 = a0 + a1;
+  std::complex<element_datatype> difference01 = a0 - a1;
+  std::complex<element_datatype> sum23 = a2 + a3;
+  std::complex<element_datatype> difference23 = a2 - a3;
+  // -i * (a2 - a3)
+  std::complex<element_datatype> rotated23(difference23.imag(),
+                                           -difference23.real());
+
+  x[j] = sum01 + sum23;
+  x[j + span] = difference01 + rotated23;
+  x[j + 2 * span] = sum01 - sum23;
+  x[j + 3 * span] = difference01 - rotated23;
+};
+
+/**
+ * @brief Runs the butterflies of a transform with the split-radix algorithm,
+ * depth first.
+ * @param data The bit-reversed input, transformed in place.
+ * @param n The size of this sub-transform.
+ * @param plan The plan of the full transform size.
+ *
+ * In bit-reversed order the first half of the data holds the even samples, and
+ * the two quarters after it the samples `4m + 1` and `4m + 3`, each again in
+ * bit-reversed order. The three sub-transforms are combined with the L-shaped
+ * butterfly, which needs the fewest multiplications of the power of two FFTs.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::splitRadixButterflies(
+    std::complex<element_datatype>* data, unsigned int n,
+    const fft_plan_data_type& plan) {
+  if (n < 2) return;
+  if (n == 2) {
+    std::complex<element_datatype> u = data[0];
+    data[0] = u + data[1];
+    data[1] = u - data[1];
+    return;
+  }
+
+  const unsigned int quarter = n >> 2;
+  splitRadixButterflies(data, n >> 1, plan);
+  splitRadixButterflies(data + 2 * quarter, quarter, plan);
+  splitRadixButterflies(data + 3 * quarter, quarter, plan);
+
+  const unsigned int twiddleStride = (1u << plan.log2n) / n;
+  for (unsigned int k = 0; k < quarter; ++k) {
+    std::complex<element_datatype> t1 =
+        twiddleAt(plan, k * twiddleStride) * data[k + 2 * quarter];
+    std::complex<element_datatype> t3 =
+        twiddleAt(plan, 3 * k * twiddleStride) * data[k + 3 * quarter];
+    std::complex<element_datatype> sum = t1 + t3;
+    std::complex<element_datatype> difference = t1 - t3;
+    // -i * (t1 - t3)
+    std::complex<element_datatype> rotated(difference.imag(),
+                                           -difference.real());
+
+    std::complex<element_datatype> u0 = data[k];
+    std::complex<element_datatype> u1 = data[k + quarter];
+    data[k] = u0 + sum;
+    data[k + quarter] = u1 + rotated;
+    data[k + 2 * quarter] = u0 - sum;
+    data[k + 3 * quarter] = u1 - rotated;
+  }
+};
+
+/**
+ * @brief Retrieves `e^(-2 pi i k / n)` of a plan for any `k < n`.
+ * @param plan The plan of the transform size.
+ * @param k The twiddle index, the plan stores the first `n / 2`.
+ * @return The twiddle factor.
+ */
+template <typename element_datatype>
+std::complex<element_datatype>
+FastFourierTransform<element_datatype>::twiddleAt(
+    const fft_plan_data_type& plan, unsigned int k) {
+  const unsigned int halfN = static_cast<unsigned int>(plan.twiddles.size());
+  return k < halfN ? plan.twiddles[k] : -plan.twiddles[k - halfN];
+};
+
+/**
+ * @brief Computes the smallest power of two holding a number of samples.
+ * @param sampleCount The number of samples.
+ * @return The base 2 logarithm of that power of two.
+ */
+template <typename element_datatype>
+unsigned int FastFourierTransform<element_datatype>::ceilLog2(
+    std::size_t sampleCount) {
+  unsigned int log2n = 0;
+  while ((static_cast<std::size_t>(1) << log2n) < sampleCount) {
+    ++log2n;
+  }
+  return log2n;
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place.
+ * @param data The interleaved complex data, `2 ^ log2n` elements.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * The bit-reversal permutation is a set of swaps, so it needs no second
+ * buffer.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::fastFourierTransformInPlace(
+    std::complex<element_datatype>* data, unsigned int log2n) {
+  const fft_plan_data_type& plan = getPlan(log2n);
+  const unsigned int n = 1u << log2n;
+
+  for (unsigned int i = 0; i < n; ++i) {
+    unsigned int reversed = plan.bitReversal[i];
+    if (i < reversed) {
+      std::swap(data[i], data[reversed]);
+    }
+  }
+  butterflies(data, plan);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place,
+ * scaled by `1 / n`.
+ * @param data The interleaved complex data, `2 ^ log2n` elements.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * The inverse is the conjugate of the forward transform of the conjugate.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::inverseFastFourierTransformInPlace(
+    std::complex<element_datatype>* data, unsigned int log2n) {
+  const unsigned int n = 1u << log2n;
+
+  for (unsigned int i = 0; i < n; ++i) {
+    data[i] = std::conj(data[i]);
+  }
+  fastFourierTransformInPlace(data, log2n);
+  element_datatype scale = static_cast<element_datatype>(1) / n;
+  for (unsigned int i = 0; i < n; ++i) {
+    data[i] = std::conj(data[i]) * scale;
+  }
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place with the
+ * four-step algorithm, for transforms much larger than the caches.
+ * @param data The interleaved complex data, `2 ^ log2n` elements.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * The device build and sizes below `2 ^ FOURSTEPMINIMUMLOG2N` run
+ * fastFourierTransformInPlace() instead.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::
+    fourStepFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                        unsigned int log2n) {
+#ifdef PARALLELBUTTERFLIES
+  if (log2n >= FOURSTEPMINIMUMLOG2N) {
+    fourStepTransform(data, log2n);
+    return;
+  }
+#endif
+  fastFourierTransformInPlace(data, log2n);
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place on any number
+ * of elements, without zero-padding them.
+ * @param data The interleaved complex data, `size` elements.
+ * @param size The transform size.
+ *
+ * Powers of two take the radix-2 path, sizes made of the factors 2, 3 and 5
+ * the mixed-radix passes and any other size the Bluestein algorithm.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::
+    exactSizeFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                         std::size_t size) {
+  if (size <= 1) {
+    return;
+  }
+  if ((size & (size - 1)) == 0) {
+    fastFourierTransformInPlace(data, ceilLog2(size));
+    return;
+  }
+
+  exact_size_fft_plan_data_type& plan = getExactSizePlan(size);
+  if (plan.radices.empty()) {
+    bluesteinTransform(data, plan);
+  } else {
+    mixedRadixTransform(data, plan);
+  }
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place on any
+ * number of elements, scaled by `1 / size`.
+ * @param data The interleaved complex data, `size` elements.
+ * @param size The transform size.
+ *
+ * The inverse is the conjugate of the forward transform of the conjugate.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::
+    inverseExactSizeFastFourierTransformInPlace(
+        std::complex<element_datatype>* data, std::size_t size) {
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = std::conj(data[i]);
+  }
+  exactSizeFastFourierTransformInPlace(data, size);
+  element_datatype scale = static_cast<element_datatype>(1) / size;
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = std::conj(data[i]) * scale;
+  }
+};
+
+/**
+ * @brief Retrieves the plan of a transform size that is not a power of two,
+ * building it on first use.
+ * @param size The transform size.
+ * @return The cached plan, whose scratch buffer the transform overwrites.
+ */
+template <typename element_datatype>
+typename FastFourierTransform<element_datatype>::exact_size_fft_plan_data_type&
+FastFourierTransform<element_datatype>::getExactSizePlan(std::size_t size) {
+  exact_size_fft_plan_data_type& plan = exactSizePlans[size];
+  if (plan.scratch.empty()) {
+    plan.size = size;
+    buildExactSizePlan(plan);
+  }
+  return plan;
+};
+
+/**
+ * @brief Computes the radices and twiddles of a size made of the factors 2, 3
+ * and 5, or the chirp tables of the Bluestein algorithm for any other size.
+ * @param plan The plan to fill, its `size` must already be set.
+ *
+ * Pairs of factors 2 run as radix-4 passes. The chirp angles use `k^2` modulo
+ * `2 n`, so they stay exact for large `k`.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::buildExactSizePlan(
+    exact_size_fft_plan_data_type& plan) {
+  const std::size_t n = plan.size;
+  const double PI = acos(-1);
+
+  std::size_t remainder = n;
+  plan.radices.clear();
+  const unsigned int factors[] = {5, 3, 4, 2};
+  for (unsigned int radix : factors) {
+    while (remainder % radix == 0) {
+      plan.radices.push_back(radix);
+      remainder /= radix;
+    }
+  }
+
+  if (remainder == 1) {
+    plan.twiddles.resize(n);
+    for (std::size_t k = 0; k < n; ++k) {
+      double angle = 2 * PI * k / n;
+      plan.twiddles[k] = std::complex<element_datatype>(
+          static_cast<element_datatype>(cos(angle)),
+          static_cast<element_datatype>(-sin(angle)));
+    }
+    plan.scratch.resize(n);
+    return;
+  }
+
+  // The convolution of the chirped input with the conjugate chirp must not
+  // wrap around, so it needs at least `2 n - 1` points.
+  plan.radices.clear();
+  plan.convolutionLog2n = ceilLog2(2 * n - 1);
+  const std::size_t convolutionSize =
+      static_cast<std::size_t>(1) << plan.convolutionLog2n;
+  plan.chirp.resize(n);
+  for (std::size_t k = 0; k < n; ++k) {
+    unsigned long long square =
+        static_cast<unsigned long long>(k) * k % (2 * n);
+    double angle = PI * square / n;
+    plan.chirp[k] = std::complex<element_datatype>(
+        static_cast<element_datatype>(cos(angle)),
+        static_cast<element_datatype>(-sin(angle)));
+  }
+  plan.chirpSpectrum.assign(convolutionSize, 0);
+  plan.chirpSpectrum[0] = std::conj(plan.chirp[0]);
+  for (std::size_t k = 1; k < n; ++k) {
+    plan.chirpSpectrum[k] = std::conj(plan.chirp[k]);
+    plan.chirpSpectrum[convolutionSize - k] = std::conj(plan.chirp[k]);
+  }
+  fastFourierTransformInPlace(plan.chirpSpectrum.data(),
+                              plan.convolutionLog2n);
+  plan.scratch.resize(convolutionSize);
+};
+
+/**
+ * @brief Computes a transform whose size only has the factors 2, 3 and 5 with
+ * Stockham autosort passes, which need no reordering of the input.
+ * @param data The interleaved complex data, transformed in place.
+ * @param plan The plan of the transform size.
+ *
+ * Every pass reads one buffer and writes the other one, the result is copied
+ * back when it ends in the scratch buffer.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::mixedRadixTransform(
+    std::complex<element_datatype>* data,
+    exact_size_fft_plan_data_type& plan) {
+  std::complex<element_datatype>* input = data;
+  std::complex<element_datatype>* output = plan.scratch.data();
+  std::size_t n = plan.size;
+  std::size_t stride = 1;
+  for (unsigned int radix : plan.radices) {
+    mixedRadixPass(input, output, n, stride, radix, plan);
+    n /= radix;
+    stride *= radix;
+    std::swap(input, output);
+  }
+  if (input != data) {
+    std::copy(input, input + plan.size, data);
+  }
+};
+
+/**
+ * @brief Computes one Stockham pass of radix 2, 3, 4 or 5.
+ * @param input The data of the pass.
+ * @param output The buffer receiving the result of the pass.
+ * @param n The size of the sub-transforms still to compute.
+ * @param stride The number of interleaved sub-transforms.
+ * @param radix The radix of the pass.
+ * @param plan The plan of the transform size.
+ *
+ * Every butterfly reads the points `p + k n / radix` of a sub-transform,
+ * computes their `radix` point DFT and writes output `t`, rotated by
+ * `e^(-2 pi i p t / n)`, to point `radix p + t` of the next pass.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::mixedRadixPass(
+    const std::complex<element_datatype>* input,
+    std::complex<element_datatype>* output, std::size_t n, std::size_t stride,
+    unsigned int radix, const exact_size_fft_plan_data_type& plan) {
+  typedef std::complex<element_datatype> complex_type;
+  // sin(2 pi / 3), cos(2 pi / 5), cos(4 pi / 5), sin(2 pi / 5), sin(4 pi / 5)
+  const element_datatype SIN3 =
+      static_cast<element_datatype>(0.86602540378443864676);
+  const element_datatype COS5A =
+      static_cast<element_datatype>(0.30901699437494742410);
+  const element_datatype COS5B =
+      static_cast<element_datatype>(-0.80901699437494742410);
+  const element_datatype SIN5A =
+      static_cast<element_datatype>(0.95105651629515357212);
+  const element_datatype SIN5B =
+      static_cast<element_datatype>(0.58778525229247312917);
+  const element_datatype half = static_cast<element_datatype>(0.5);
+
+  const std::size_t m = n / radix;
+  const std::size_t twiddleStride = plan.size / n;
+  complex_type a[5];
+  complex_type b[5];
+  for (std::size_t p = 0; p < m; ++p) {
+    for (std::size_t q = 0; q < stride; ++q) {
+      for (unsigned int k = 0; k < radix; ++k) {
+        a[k] = input[q + stride * (p + k * m)];
+      }
+
+      // Multiplying by -i swaps the parts and negates the new imaginary one
+      switch (radix) {
+        case 2:
+          b[0] = a[0] + a[1];
+          b[1] = a[0] - a[1];
+          break;
+        case 3: {
+          complex_type sum = a[1] + a[2];
+          complex_type difference = (a[1] - a[2]) * SIN3;
+          complex_type middle = a[0] - sum * half;
+          complex_type rotated(difference.imag(), -difference.real());
+          b[0] = a[0] + sum;
+          b[1] = middle + rotated;
+          b[2] = middle - rotated;
+          break;
+        }
+        case 4: {
+          complex_type sum02 = a[0] + a[2];
+          complex_type difference02 = a[0] - a[2];
+          complex_type sum13 = a[1] + a[3];
+          complex_type difference13 = a[1] - a[3];
+          complex_type rotated(difference13.imag(), -difference13.real());
+          b[0] = sum02 + sum13;
+          b[1] = difference02 + rotated;
+          b[2] = sum02 - sum13;
+          b[3] = difference02 - rotated;
+          break;
+        }
+        default: {
+          complex_type sum14 = a[1] + a[4];
+          complex_type sum23 = a[2] + a[3];
+          complex_type difference14 = a[1] - a[4];
+          complex_type difference23 = a[2] - a[3];
+          complex_type middle1 = a[0] + sum14 * COS5A + sum23 * COS5B;
+          complex_type middle2 = a[0] + sum14 * COS5B + sum23 * COS5A;
+          complex_type odd1 = difference14 * SIN5A + difference23 * SIN5B;
+          complex_type odd2 = difference14 * SIN5B - difference23 * SIN5A;
+          complex_type rotated1(odd1.imag(), -odd1.real());
+          complex_type rotated2(odd2.imag(), -odd2.real());
+          b[0] = a[0] + sum14 + sum23;
+          b[1] = middle1 + rotated1;
+          b[4] = middle1 - rotated1;
+          b[2] = middle2 + rotated2;
+          b[3] = middle2 - rotated2;
+          break;
+        }
+      }
+
+      // The twiddles are finite, so the product skips the checks for
+      // infinities of the complex operator
+      output[q + stride * radix * p] = b[0];
+      for (unsigned int t = 1; t < radix; ++t) {
+        const complex_type& w = plan.twiddles[p * t * twiddleStride];
+        output[q + stride * (radix * p + t)] =
+            complex_type(b[t].real() * w.real() - b[t].imag() * w.imag(),
+                         b[t].real() * w.imag() + b[t].imag() * w.real());
+      }
+    }
+  }
+};
+
+/**
+ * @brief Computes a transform of any size as a power of two circular
+ * convolution with the Bluestein algorithm.
+ * @param data The interleaved complex data, transformed in place.
+ * @param plan The plan of the transform size.
+ *
+ * With `jk = (j^2 + k^2 - (k - j)^2) / 2`, the transform is
+ * `X[k] = w[k] sum(x[j] w[j] conj(w[k - j]))` for the chirp
+ * `w[k] = e^(-pi i k^2 / n)`, a convolution of the chirped input with the
+ * conjugate chirp whose spectrum the plan holds.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::bluesteinTransform(
+    std::complex<element_datatype>* data,
+    exact_size_fft_plan_data_type& plan) {
+  std::vector<std::complex<element_datatype>>& scratch = plan.scratch;
+  for (std::size_t k = 0; k < plan.size; ++k) {
+    scratch[k] = data[k] * plan.chirp[k];
+  }
+  std::fill(scratch.begin() + plan.size, scratch.end(),
+            std::complex<element_datatype>(0));
+
+  fastFourierTransformInPlace(scratch.data(), plan.convolutionLog2n);
+  for (std::size_t k = 0; k < scratch.size(); ++k) {
+    scratch[k] *= plan.chirpSpectrum[k];
+  }
+  inverseFastFourierTransformInPlace(scratch.data(), plan.convolutionLog2n);
+
+  for (std::size_t k = 0; k < plan.size; ++k) {
+    data[k] = scratch[k] * plan.chirp[k];
+  }
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place on real data.
+ * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding the
+ * real samples as scalars on entry and the bins on exit.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * The scalars `x[2m], x[2m + 1]` already form the complex `z[m]`, so `Z` is the
+ * `n / 2` point FFT of the first `n / 2` elements. The even and odd sample
+ * spectra are `E[k] = (Z[k] + conj(Z[n/2 - k])) / 2` and
+ * `O[k] = (Z[k] - conj(Z[n/2 - k])) / 2i`, with `X[k] = E[k] + W^k O[k]` and
+ * `X[n/2 - k] = conj(E[k] - W^k O[k])`, so every pair of bins is computed from
+ * the same two elements it overwrites.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::realFastFourierTransformInPlace(
+    std::complex<element_datatype>* data, unsigned int log2n) {
+  if (log2n == 0) {
+    data[0] = std::complex<element_datatype>(data[0].real(), 0);
+    return;
+  }
+
+  const unsigned int halfSize = 1u << (log2n - 1);
+  fastFourierTransformInPlace(data, log2n - 1);
+
+  // The twiddles of the full size transform combine the two half spectra.
+  const fft_plan_data_type& plan = getPlan(log2n);
+  const element_datatype half = static_cast<element_datatype>(0.5);
+  element_datatype z0Real = data[0].real();
+  element_datatype z0Imaginary = data[0].imag();
+  data[0] = std::complex<element_datatype>(z0Real + z0Imaginary, 0);
+  data[halfSize] = std::complex<element_datatype>(z0Real - z0Imaginary, 0);
+  for (unsigned int k = 1; k <= halfSize - k; ++k) {
+    std::complex<element_datatype> z = data[k];
+    std::complex<element_datatype> mirrored = std::conj(data[halfSize - k]);
+    std::complex<element_datatype> even = (z + mirrored) * half;
+    std::complex<element_datatype> odd =
+        (z - mirrored) * std::complex<element_datatype>(0, -half);
+    std::complex<element_datatype> rotatedOdd = plan.twiddles[k] * odd;
+    data[k] = even + rotatedOdd;
+    data[halfSize - k] = std::conj(even - rotatedOdd);
+  }
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place on the
+ * non-negative frequency half of a Hermitian spectrum.
+ * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding the
+ * bins on entry and the real samples as scalars on exit.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * With `E[k] = (X[k] + conj(X[n/2 - k])) / 2` and
+ * `O[k] = (X[k] - conj(X[n/2 - k])) conj(W^k) / 2`, the spectrum of
+ * `z[m] = x[2m] + i x[2m + 1]` is `Z[k] = E[k] + i O[k]` and
+ * `Z[n/2 - k] = conj(E[k]) + i conj(O[k])`. Its inverse leaves the samples
+ * interleaved in place.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::
+    inverseRealFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                           unsigned int log2n) {
+  if (log2n == 0) {
+    data[0] = std::complex<element_datatype>(data[0].real(), 0);
+    return;
+  }
+
+  const unsigned int halfSize = 1u << (log2n - 1);
+  const fft_plan_data_type& plan = getPlan(log2n);
+  const element_datatype half = static_cast<element_datatype>(0.5);
+  const std::complex<element_datatype> J(0, 1);
+  element_datatype x0 = data[0].real();
+  element_datatype xHalf = data[halfSize].real();
+  data[0] = std::complex<element_datatype>((x0 + xHalf) * half,
+                                           (x0 - xHalf) * half);
+  for (unsigned int k = 1; k <= halfSize - k; ++k) {
+    std::complex<element_datatype> bin = data[k];
+    std::complex<element_datatype> mirrored = std::conj(data[halfSize - k]);
+    std::complex<element_datatype> even = (bin + mirrored) * half;
+    std::complex<element_datatype> odd =
+        (bin - mirrored) * std::conj(plan.twiddles[k]) * half;
+    data[k] = even + J * odd;
+    data[halfSize - k] = std::conj(even) + J * std::conj(odd);
+  }
+
+  inverseFastFourierTransformInPlace(data, log2n - 1);
+};
 
 template <typename element_datatype>
 void FastFourierTransform<element_datatype>::fastFourierTransform(
@@ -74,32 +961,24 @@ void FastFourierTransform<element_datatype>::fastFourierTransform(
   }
 #endif
 
-  unsigned int fftPaddedArraySizeLogBase2 =
-      std::ceil(std::log2(realInput->size()));
-  unsigned int fftPaddedArraySize =
-      static_cast<unsigned int>(std::pow(2, fftPaddedArraySizeLogBase2));
+  unsigned int fftPaddedArraySizeLogBase2 = ceilLog2(realInput->size());
+  unsigned int fftPaddedArraySize = 1u << fftPaddedArraySizeLogBase2;
 
-  std::vector<std::complex<element_datatype>> input(fftPaddedArraySize);
-  std::vector<std::complex<element_datatype>> output(fftPaddedArraySize);
+  workspace.assign(fftPaddedArraySize, 0);
   for (unsigned int i = 0; i < realInput->size(); i++) {
-    input[i] =
+    workspace[i] =
         std::complex<element_datatype>((*realInput)[i], (*imaginaryInput)[i]);
-    output[i] = 0;
-  }
-  for (unsigned int i = realInput->size(); i < fftPaddedArraySize; i++) {
-    input[i] = 0;
-    output[i] = 0;
   }
 
-  // Use the fft method after preprocessing
-  this->fft(input, output, fftPaddedArraySizeLogBase2);
+  this->fastFourierTransformInPlace(workspace.data(),
+                                    fftPaddedArraySizeLogBase2);
   // Resize realOutput and imaginaryOutput before assigning values
   realOutput->resize(fftPaddedArraySize);
   imaginaryOutput->resize(fftPaddedArraySize);
 
   for (unsigned int i = 0; i < fftPaddedArraySize; i++) {
-    (*realOutput)[i] = output[i].real();
-    (*imaginaryOutput)[i] = output[i].imag();
+    (*realOutput)[i] = workspace[i].real();
+    (*imaginaryOutput)[i] = workspace[i].imag();
   }
 }
 
@@ -120,36 +999,117 @@ void FastFourierTransform<element_datatype>::inverseFastFourierTransform(
   }
 #endif
 
-  unsigned int fftPaddedArraySizeLogBase2 =
-      std::ceil(std::log2(realInput->size()));
-  unsigned int fftPaddedArraySize =
-      static_cast<unsigned int>(std::pow(2, fftPaddedArraySizeLogBase2));
-
-  std::vector<std::complex<element_datatype>> input(fftPaddedArraySize);
-  std::vector<std::complex<element_datatype>> output(fftPaddedArraySize);
-
-  element_datatype conjugateFactor = -1;
+  unsigned int fftPaddedArraySizeLogBase2 = ceilLog2(realInput->size());
+  unsigned int fftPaddedArraySize = 1u << fftPaddedArraySizeLogBase2;
 
+  workspace.assign(fftPaddedArraySize, 0);
   for (unsigned int i = 0; i < realInput->size(); i++) {
-    input[i] = std::complex<element_datatype>(
-        (*realInput)[i], conjugateFactor * (*imaginaryInput)[i]);
-    output[i] = 0;
-  }
-  for (unsigned int i = realInput->size(); i < fftPaddedArraySize; i++) {
-    input[i] = 0;
-    output[i] = 0;
+    workspace[i] =
+        std::complex<element_datatype>((*realInput)[i], (*imaginaryInput)[i]);
   }
 
-  // Use the fft method after preprocessing
-  this->fft(input, output, fftPaddedArraySizeLogBase2);
+  this->inverseFastFourierTransformInPlace(workspace.data(),
+                                           fftPaddedArraySizeLogBase2);
   // Resize realOutput and imaginaryOutput before assigning values
   realOutput->resize(fftPaddedArraySize);
   imaginaryOutput->resize(fftPaddedArraySize);
 
   for (unsigned int i = 0; i < fftPaddedArraySize; i++) {
-    (*realOutput)[i] =
-        output[i].real() / static_cast<element_datatype>(fftPaddedArraySize);
-    (*imaginaryOutput)[i] = conjugateFactor * output[i].imag() /
-                            static_cast<element_datatype>(fftPaddedArraySize);
+    (*realOutput)[i] = workspace[i].real();
+    (*imaginaryOutput)[i] = workspace[i].imag();
+  }
+}
+
+/**
+ * @brief Performs the Fast Fourier Transform operation on real input data and
+ * returns the `n / 2 + 1` non-negative frequency bins, where `n` is the input
+ * size padded to a power of two.
+ * @param realInput The input data vector.
+ * @param realOutput The output data vector for real part.
+ * @param imaginaryOutput The output data vector for imaginary part.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::realFastFourierTransform(
+    const std::vector<element_datatype>* realInput,
+    std::vector<element_datatype>* realOutput,
+    std::vector<element_datatype>* imaginaryOutput) {
+#ifdef UNIT_TEST
+  if (!realInput || !realOutput || !imaginaryOutput) {
+    throw std::invalid_argument("Input and output vectors cannot be null");
+  }
+#endif
+
+  unsigned int fftPaddedArraySizeLogBase2 = ceilLog2(realInput->size());
+  unsigned int binCount = (1u << fftPaddedArraySizeLogBase2) / 2 + 1;
+
+  workspace.assign(binCount, 0);
+  element_datatype* samples =
+      reinterpret_cast<element_datatype*>(workspace.data());
+  for (unsigned int i = 0; i < realInput->size(); i++) {
+    samples[i] = (*realInput)[i];
+  }
+
+  this->realFastFourierTransformInPlace(workspace.data(),
+                                        fftPaddedArraySizeLogBase2);
+  realOutput->resize(binCount);
+  imaginaryOutput->resize(binCount);
+  for (unsigned int k = 0; k < binCount; k++) {
+    (*realOutput)[k] = workspace[k].real();
+    (*imaginaryOutput)[k] = workspace[k].imag();
+  }
+}
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation on the
+ * `n / 2 + 1` non-negative frequency bins of a real signal and returns the `n`
+ * real samples.
+ * @param realInput The input data vector for real part.
+ * @param imaginaryInput The input data vector for imaginary part.
+ * @param realOutput The output data vector.
+ */
+template <typename element_datatype>
+void FastFourierTransform<element_datatype>::inverseRealFastFourierTransform(
+    const std::vector<element_datatype>* realInput,
+    const std::vector<element_datatype>* imaginaryInput,
+    std::vector<element_datatype>* realOutput) {
+#ifdef UNIT_TEST
+  if (!realInput || !imaginaryInput || !realOutput) {
+    throw std::invalid_argument("Input and output vectors cannot be null");
+  }
+
+  if (realInput->size() != imaginaryInput->size()) {
+    throw std::invalid_argument(
+        "Real and Imaginary input vectors must have the same size");
   }
-}
\ No newline at end of file
+
+  if (realInput->empty()) {
+    throw std::invalid_argument("Input vectors cannot be empty");
+  }
+#endif
+
+  unsigned int halfSize = static_cast<unsigned int>(realInput->size()) - 1;
+  if (halfSize == 0) {
+    realOutput->assign(1, (*realInput)[0]);
+    return;
+  }
+
+  unsigned int halfSizeLogBase2 = ceilLog2(halfSize);
+#ifdef UNIT_TEST
+  if ((1u << halfSizeLogBase2) != halfSize) {
+    throw std::invalid_argument(
+        "Input vectors must hold a power of two plus one bins");
+  }
+#endif
+
+  workspace.resize(halfSize + 1);
+  for (unsigned int k = 0; k <= halfSize; k++) {
+    workspace[k] =
+        std::complex<element_datatype>((*realInput)[k], (*imaginaryInput)[k]);
+  }
+
+  this->inverseRealFastFourierTransformInPlace(workspace.data(),
+                                               halfSizeLogBase2 + 1);
+  const element_datatype* samples =
+      reinterpret_cast<const element_datatype*>(workspace.data());
+  realOutput->assign(samples, samples + 2 * halfSize);
+}
@@ -2,8 +2,14 @@
 #define FAST_FOURIER_TRANSFORM_H
 
 #include <complex>
+#include <cstddef>
 #include <iterator>
+#include <map>
+#include <memory>
+#include <vector>
 
+#include "ButterflyKernels.h"
+#include "WorkerPool.h"
 #include "signal_filter/FastFourierTransformInterface.h"
 
 using cd = std::complex<double>;
@@ -12,6 +18,26 @@ using cd = std::complex<double>;
  * @brief The FastFourierTransform class is a concrete implementation of the
  * FastFourierTransformInterface class that uses the arduinoFFT library to
  * perform Fast Fourier Transform and Inverse Fast Fourier Transform operations.
+ *
+ * The twiddle factors and bit-reversal permutation of every transform size are
+ * computed once, the first time that size is used, and cached in a plan. The
+ * SAM3X has no FPU, so later transforms of the same size make no
+ * transcendental calls at all. The in-place transforms then allocate nothing,
+ * the vector ones reuse an internal workspace.
+ *
+ * The exact size transforms take any size. Sizes made of the factors 2, 3 and
+ * 5, such as a 50 sample history, run mixed-radix Stockham passes, any other
+ * size runs the Bluestein algorithm on a power of two convolution.
+ *
+ * Native builds split transforms of `PARALLELMINIMUMSIZE` points and more into
+ * independent blocks and butterfly chunks, which a worker pool runs when the
+ * transform was built with more than one thread. The split does not depend on
+ * the thread count, so neither do the results.
+ *
+ * For recordings much larger than the caches, the four-step transform streams
+ * the data through cache-sized blocks of columns and rows instead, reading and
+ * writing it twice whatever the size. It is a separate call, so it is only
+ * used where it was measured to be faster.
  * @tparam element_datatype The data type of the elements in the input and
  * output vectors.
  */
@@ -19,6 +45,14 @@ template <typename element_datatype>
 class FastFourierTransform
     : public FastFourierTransformInterface<element_datatype> {
  public:
+  /**
+   * @brief Constructor for the FastFourierTransform class.
+   * @param threadCount The number of threads running large native transforms,
+   * the calling thread included, or 0 for one per core. The device build
+   * always runs on the calling thread.
+   */
+  explicit FastFourierTransform(unsigned int threadCount = 1);
+
   /**
    * @brief Performs the Fast Fourier Transform operation on the input data and
    * returns the result to the address with `2 ^ realInput.length()` elements.
@@ -51,15 +85,362 @@ class FastFourierTransform
       std::vector<element_datatype>* realOutput,
       std::vector<element_datatype>* imaginaryOutput) override;
 
+  /**
+   * @brief Performs the Fast Fourier Transform operation on real input data
+   * and returns the `n / 2 + 1` non-negative frequency bins, where `n` is the
+   * input size padded to a power of two.
+   * @param realInput The input data vector.
+   * @param realOutput The output data vector for real part.
+   * @param imaginaryOutput The output data vector for imaginary part.
+   *
+   * The even and odd samples are packed into the real and imaginary parts of
+   * an `n / 2` point complex FFT, which is then split into the spectrum.
+   */
+  void realFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation on the
+   * `n / 2 + 1` non-negative frequency bins of a real signal and returns the
+   * `n` real samples.
+   * @param realInput The input data vector for real part.
+   * @param imaginaryInput The input data vector for imaginary part.
+   * @param realOutput The output data vector.
+   *
+   * The bins are merged into an `n / 2` point complex spectrum whose inverse
+   * holds the even samples in its real part and the odd ones in its imaginary
+   * part.
+   */
+  void inverseRealFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void fastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                   unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place,
+   * scaled by `1 / n`.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void inverseFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                          unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place with the
+   * four-step algorithm, for transforms much larger than the caches.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void fourStepFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, unsigned int log2n);
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place on any
+   * number of elements, without zero-padding them.
+   * @param data The interleaved complex data, `size` elements.
+   * @param size The transform size.
+   */
+  void exactSizeFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, std::size_t size) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place on
+   * any number of elements, scaled by `1 / size`.
+   * @param data The interleaved complex data, `size` elements.
+   * @param size The transform size.
+   */
+  void inverseExactSizeFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, std::size_t size) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place on real
+   * data.
+   * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding
+   * the real samples as scalars on entry and the bins on exit.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void realFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                       unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place on
+   * the non-negative frequency half of a Hermitian spectrum.
+   * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding
+   * the bins on entry and the real samples as scalars on exit.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void inverseRealFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, unsigned int log2n) override;
+
+#ifdef PARALLELBUTTERFLIES
+  // Base 2 logarithm of the smallest four-step transform, whose matrix has at
+  // least `FOURSTEPBLOCKSIZE` rows and columns. Smaller transforms take the
+  // regular path.
+  static const unsigned int FOURSTEPMINIMUMLOG2N = 10;
+#endif
+
  private:
   /**
-   * @brief FIXME A static function to perform FFT on the input data.
-   * @param a The input data vector.
-   * @param invert A boolean indicating whether to perform FFT or inverse FFT.
+   * @brief Precomputed tables of one transform size.
+   */
+  typedef struct FFTPlan {
+    unsigned int log2n;  // Base 2 logarithm of the transform size
+    std::vector<unsigned int> bitReversal;  // Input index of every output
+    std::vector<std::complex<element_datatype>> twiddles;  // e^(-2 pi i k / n)
+#ifdef SIMDBUTTERFLIES
+    std::vector<element_datatype> simdTwiddles;  // Split radix-4 pass twiddles
+#endif
+  } fft_plan_data_type;
+
+  /**
+   * @brief Precomputed tables of one transform size that is not a power of
+   * two.
+   */
+  typedef struct ExactSizeFFTPlan {
+    std::size_t size;  // Transform size
+    std::vector<unsigned int> radices;  // Stockham passes, empty for Bluestein
+    std::vector<std::complex<element_datatype>> twiddles;  // e^(-2 pi i k / n)
+    unsigned int convolutionLog2n;  // Base 2 logarithm of the Bluestein size
+    std::vector<std::complex<element_datatype>> chirp;  // e^(-pi i k^2 / n)
+    std::vector<std::complex<element_datatype>> chirpSpectrum;  // Filter FFT
+    std::vector<std::complex<element_datatype>> scratch;  // Second buffer
+  } exact_size_fft_plan_data_type;
+
+#ifdef PARALLELBUTTERFLIES
+  /**
+   * @brief Precomputed tables and buffers of one four-step transform size.
+   */
+  typedef struct FourStepPlan {
+    unsigned int rowsLog2n;     // Base 2 logarithm of the column FFT size
+    unsigned int columnsLog2n;  // Base 2 logarithm of the row FFT size
+    std::vector<std::complex<element_datatype>>
+        coarseTwiddles;  // e^(-2 pi i k n2 / n), `n1` of them
+    std::vector<std::complex<element_datatype>>
+        fineTwiddles;  // e^(-2 pi i k / n), `n2` of them
+    std::vector<std::complex<element_datatype>>
+        scratch;  // Output of the column FFTs, rows padded
+    std::vector<std::vector<std::complex<element_datatype>>>
+        columnBlocks;  // Padded columns being transformed, one per thread
+    std::vector<std::vector<element_datatype>>
+        simdScratch;  // Split data of vector kernels, one per thread
+  } four_step_plan_data_type;
+#endif
+
+  /**
+   * @brief Retrieves the plan of a transform size, building it on first use.
+   * @param log2n The base 2 logarithm of the transform size.
+   * @return The cached plan.
+   */
+  const fft_plan_data_type& getPlan(unsigned int log2n);
+
+  /**
+   * @brief Computes the twiddle table and bit-reversal permutation of a
+   * transform size.
+   * @param plan The plan to fill, its `log2n` must already be set.
    */
-  void fft(std::vector<std::complex<element_datatype>>& a,
-           std::vector<std::complex<element_datatype>>& b, unsigned int log2n);
-  unsigned int bitReverse(unsigned int num, unsigned int nBits);
+  void buildPlan(fft_plan_data_type& plan);
+
+  /**
+   * @brief Retrieves the plan of a transform size that is not a power of two,
+   * building it on first use.
+   * @param size The transform size.
+   * @return The cached plan, whose scratch buffer the transform overwrites.
+   */
+  exact_size_fft_plan_data_type& getExactSizePlan(std::size_t size);
+
+  /**
+   * @brief Computes the radices and twiddles of a size made of the factors 2,
+   * 3 and 5, or the chirp tables of the Bluestein algorithm for any other
+   * size.
+   * @param plan The plan to fill, its `size` must already be set.
+   */
+  void buildExactSizePlan(exact_size_fft_plan_data_type& plan);
+
+  /**
+   * @brief Computes a transform whose size only has the factors 2, 3 and 5
+   * with Stockham autosort passes, which need no reordering of the input.
+   * @param data The interleaved complex data, transformed in place.
+   * @param plan The plan of the transform size.
+   */
+  void mixedRadixTransform(std::complex<element_datatype>* data,
+                           exact_size_fft_plan_data_type& plan);
+
+  /**
+   * @brief Computes one Stockham pass of radix 2, 3, 4 or 5.
+   * @param input The data of the pass.
+   * @param output The buffer receiving the result of the pass.
+   * @param n The size of the sub-transforms still to compute.
+   * @param stride The number of interleaved sub-transforms.
+   * @param radix The radix of the pass.
+   * @param plan The plan of the transform size.
+   */
+  static void mixedRadixPass(const std::complex<element_datatype>* input,
+                             std::complex<element_datatype>* output,
+                             std::size_t n, std::size_t stride,
+                             unsigned int radix,
+                             const exact_size_fft_plan_data_type& plan);
+
+  /**
+   * @brief Computes a transform of any size as a power of two circular
+   * convolution with the Bluestein algorithm.
+   * @param data The interleaved complex data, transformed in place.
+   * @param plan The plan of the transform size.
+   */
+  void bluesteinTransform(std::complex<element_datatype>* data,
+                          exact_size_fft_plan_data_type& plan);
+
+  /**
+   * @brief Runs the butterflies of a transform, on the worker pool from
+   * `PARALLELMINIMUMSIZE` on.
+   * @param data The bit-reversed input, transformed in place.
+   * @param plan The plan of the transform size.
+   */
+  void butterflies(std::complex<element_datatype>* data,
+                   const fft_plan_data_type& plan);
+
+  /**
+   * @brief Runs the butterflies of a transform on the calling thread with the
+   * scalar kernels, radix-4 below `SPLITRADIXMINIMUMSIZE` and split-radix from
+   * there on.
+   * @param data The bit-reversed input, transformed in place.
+   * @param plan The plan of the transform size.
+   */
+  void scalarButterflies(std::complex<element_datatype>* data,
+                         const fft_plan_data_type& plan);
+
+#ifdef PARALLELBUTTERFLIES
+  /**
+   * @brief Runs the butterflies of a transform with the scalar kernels as
+   * `2 ^ PARALLELSPLITLOG2` sub-transforms followed by radix-4 passes cut into
+   * chunks, all of them tasks of the worker pool.
+   * @param data The bit-reversed input, transformed in place.
+   * @param plan The plan of the transform size.
+   */
+  void parallelButterflies(std::complex<element_datatype>* data,
+                           const fft_plan_data_type& plan);
+
+  /**
+   * @brief Retrieves the four-step plan of a transform size, building it on
+   * first use.
+   * @param log2n The base 2 logarithm of the transform size.
+   * @return The cached plan, whose buffers the transform overwrites.
+   */
+  four_step_plan_data_type& getFourStepPlan(unsigned int log2n);
+
+  /**
+   * @brief Computes a transform with the four-step algorithm: FFTs of the
+   * columns of an `n1 x n2` matrix, a twiddle multiplication, FFTs of its
+   * rows and a blocked transpose.
+   * @param data The interleaved complex data, transformed in place.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void fourStepTransform(std::complex<element_datatype>* data,
+                         unsigned int log2n);
+
+  /**
+   * @brief Computes a transform that fits in cache on a caller-owned vector
+   * kernel buffer, so several of them can run at once.
+   * @param data The interleaved complex data, transformed in place.
+   * @param plan The plan of the transform size.
+   * @param scratch The split data buffer of the vector kernels.
+   */
+  void cachedTransform(std::complex<element_datatype>* data,
+                       const fft_plan_data_type& plan,
+                       std::vector<element_datatype>& scratch);
+#endif
+
+  /**
+   * @brief Runs the butterflies of a transform in radix-4 passes, with one
+   * radix-2 pass first when `log2n` is odd.
+   * @param data The bit-reversed input, transformed in place.
+   * @param plan The plan of the transform size.
+   */
+  void radix4Butterflies(std::complex<element_datatype>* data,
+                         const fft_plan_data_type& plan);
+
+  /**
+   * @brief Computes one butterfly of a radix-4 pass.
+   * @param x The first point of the butterfly group.
+   * @param j The index of the butterfly in its group.
+   * @param span The distance between the four points of the butterfly.
+   * @param twiddleIndex The index of the twiddle of the first point.
+   * @param plan The plan of the transform size.
+   */
+  static void radix4Butterfly(std::complex<element_datatype>* x,
+                              unsigned int j, unsigned int span,
+                              unsigned int twiddleIndex,
+                              const fft_plan_data_type& plan);
+
+  /**
+   * @brief Runs the butterflies of a transform with the split-radix
+   * algorithm, depth first.
+   * @param data The bit-reversed input, transformed in place.
+   * @param n The size of this sub-transform.
+   * @param plan The plan of the full transform size.
+   */
+  void splitRadixButterflies(std::complex<element_datatype>* data,
+                             unsigned int n, const fft_plan_data_type& plan);
+
+  /**
+   * @brief Retrieves `e^(-2 pi i k / n)` of a plan for any `k < n`.
+   * @param plan The plan of the transform size.
+   * @param k The twiddle index, the plan stores the first `n / 2`.
+   * @return The twiddle factor.
+   */
+  static std::complex<element_datatype> twiddleAt(
+      const fft_plan_data_type& plan, unsigned int k);
+
+  /**
+   * @brief Computes the smallest power of two holding a number of samples.
+   * @param sampleCount The number of samples.
+   * @return The base 2 logarithm of that power of two.
+   */
+  static unsigned int ceilLog2(std::size_t sampleCount);
+
+  // Smallest transform using the split-radix kernel. Its depth-first order
+  // keeps sub-transforms in cache, below this the call overhead dominates.
+  static const unsigned int SPLITRADIXMINIMUMSIZE = 1024;
+#ifdef SIMDBUTTERFLIES
+  // Smallest transform using the vector kernels, below this splitting the
+  // data into real and imaginary arrays costs more than the kernels save.
+  static const unsigned int SIMDMINIMUMSIZE = 256;
+#endif
+#ifdef PARALLELBUTTERFLIES
+  // Smallest transform using the parallel path, below this a transform takes
+  // about as long as waking the pool threads.
+  static const unsigned int PARALLELMINIMUMSIZE = 1u << 16;
+  // Base 2 logarithm of the number of sub-transforms of the scalar parallel
+  // path, even so that whole radix-4 passes combine them.
+  static const unsigned int PARALLELSPLITLOG2 = 6;
+  // Number of adjacent columns, or rows, the four-step algorithm transforms
+  // and moves together. Each access to another matrix row then moves whole
+  // cache lines and its page is used for more than one element.
+  static const unsigned int FOURSTEPBLOCKSIZE = 32;
+  // Number of unused elements after every row of the four-step buffers. Rows
+  // a power of two apart would otherwise share the same cache sets.
+  static const unsigned int FOURSTEPPADDING = 8;
+#endif
+
+  std::vector<fft_plan_data_type> plans;  // Cached plans, indexed by log2n
+  std::map<std::size_t, exact_size_fft_plan_data_type>
+      exactSizePlans;  // Cached plans of the other sizes, keyed by size
+  std::vector<std::complex<element_datatype>> workspace;  // Vector API buffer
+  std::vector<element_datatype> simdScratch;  // Split data of vector kernels
+#ifdef PARALLELBUTTERFLIES
+  std::unique_ptr<WorkerPool> workers;  // Runs the parallel path
+  std::vector<four_step_plan_data_type>
+      fourStepPlans;  // Cached four-step plans, indexed by log2n
+#endif
 };
 
 // Explicit instantiation
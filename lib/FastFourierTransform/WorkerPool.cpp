@@ -0,0 +1,111 @@
+#include "WorkerPool.h"
+
+#ifdef PARALLELBUTTERFLIES
+#include <algorithm>
+
+/**
+ * @brief Starts the threads of the pool.
+ *
+ * @param threadCount The number of threads running a loop, the calling thread
+ * included, or 0 for one per core.
+ */
+WorkerPool::WorkerPool(unsigned int threadCount) : nextTask(0) {
+  if (threadCount == 0) {
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+  }
+  for (unsigned int thread = 1; thread < threadCount; ++thread) {
+    threads.emplace_back(&WorkerPool::work, this, thread);
+  }
+};
+
+/**
+ * @brief Stops and joins the threads of the pool.
+ */
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  loopStarted.notify_all();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+};
+
+/**
+ * @brief Retrieves the number of threads running a loop.
+ *
+ * @return The number of threads, the calling thread included.
+ */
+unsigned int WorkerPool::getThreadCount() const {
+  return static_cast<unsigned int>(threads.size()) + 1;
+};
+
+/**
+ * @brief Runs every task of a loop and waits until all of them finished.
+ *
+ * @param taskCount The number of tasks.
+ * @param task The task, called once for every index below `taskCount`.
+ */
+void WorkerPool::run(unsigned int taskCount, const task_type& task) {
+  if (threads.empty()) {
+    for (unsigned int index = 0; index < taskCount; ++index) {
+      task(index, 0);
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->task = &task;
+    this->taskCount = taskCount;
+    nextTask = 0;
+    busyThreads = static_cast<unsigned int>(threads.size());
+    ++loop;
+  }
+  loopStarted.notify_all();
+  runTasks(0);
+
+  std::unique_lock<std::mutex> lock(mutex);
+  loopFinished.wait(lock, [this] { return busyThreads == 0; });
+  this->task = nullptr;
+};
+
+/**
+ * @brief Body of a pool thread, waiting for loops until the pool stops.
+ *
+ * @param thread The index of the thread.
+ */
+void WorkerPool::work(unsigned int thread) {
+  unsigned long finishedLoop = 0;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      loopStarted.wait(
+          lock, [&] { return stopping || loop != finishedLoop; });
+      if (stopping) return;
+      finishedLoop = loop;
+    }
+    runTasks(thread);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--busyThreads == 0) {
+        loopFinished.notify_one();
+      }
+    }
+  }
+};
+
+/**
+ * @brief Runs tasks of the current loop until none is left.
+ *
+ * @param thread The index of the running thread.
+ */
+void WorkerPool::runTasks(unsigned int thread) {
+  for (unsigned int index = nextTask.fetch_add(1); index < taskCount;
+       index = nextTask.fetch_add(1)) {
+    (*task)(index, thread);
+  }
+};
+
+#endif
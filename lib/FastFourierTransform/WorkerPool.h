@@ -0,0 +1,98 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+// Native builds can spread the butterflies of large transforms over threads,
+// the SAM3X has a single core and its C++ library has no thread support.
+#if defined(EXCLUDEARDUINOLIB)
+#define PARALLELBUTTERFLIES
+#endif
+
+#ifdef PARALLELBUTTERFLIES
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A fixed set of threads running the tasks of one parallel loop at a
+ * time.
+ *
+ * The threads are started once and sleep between loops. The calling thread
+ * takes part in every loop, so a pool of one thread starts none and runs the
+ * tasks in order.
+ */
+class WorkerPool {
+ public:
+  /**
+   * @brief Signature of a task, called with the task index and the index of
+   * the thread running it, below getThreadCount().
+   */
+  typedef std::function<void(unsigned int, unsigned int)> task_type;
+
+  /**
+   * @brief Starts the threads of the pool.
+   *
+   * @param threadCount The number of threads running a loop, the calling
+   * thread included, or 0 for one per core.
+   */
+  explicit WorkerPool(unsigned int threadCount);
+
+  /**
+   * @brief Stops and joins the threads of the pool.
+   */
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /**
+   * @brief Retrieves the number of threads running a loop.
+   *
+   * @return The number of threads, the calling thread included.
+   */
+  unsigned int getThreadCount() const;
+
+  /**
+   * @brief Runs every task of a loop and waits until all of them finished.
+   *
+   * The tasks are handed out in index order to whichever thread is free, so
+   * they must not depend on each other.
+   *
+   * @param taskCount The number of tasks.
+   * @param task The task, called once for every index below `taskCount`.
+   */
+  void run(unsigned int taskCount, const task_type& task);
+
+ private:
+  /**
+   * @brief Body of a pool thread, waiting for loops until the pool stops.
+   *
+   * @param thread The index of the thread.
+   */
+  void work(unsigned int thread);
+
+  /**
+   * @brief Runs tasks of the current loop until none is left.
+   *
+   * @param thread The index of the running thread.
+   */
+  void runTasks(unsigned int thread);
+
+  std::vector<std::thread> threads;  // Pool threads, from index 1 on
+  std::mutex mutex;                  // Guards the loop state below
+  std::condition_variable loopStarted;   // Wakes the pool threads
+  std::condition_variable loopFinished;  // Wakes the calling thread
+  const task_type* task = nullptr;       // Task of the current loop
+  unsigned int taskCount = 0;            // Tasks of the current loop
+  std::atomic<unsigned int> nextTask;    // Next task index to hand out
+  unsigned int busyThreads = 0;  // Pool threads still in the current loop
+  unsigned long loop = 0;        // Number of loops started
+  bool stopping = false;         // Set when the pool is destroyed
+};
+#else
+class WorkerPool;
+#endif
+
+#endif
@@ -0,0 +1,495 @@
+#include "FastFourierTransformPlanner.h"
+
+#ifdef EXCLUDEARDUINOLIB
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#else
+#include <Arduino.h>
+#undef min  // for muting the `Arduino.h` in-built min() function
+#undef max  // for muting the `Arduino.h` in-built max() function
+#endif
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// Names of the kernels in the wisdom file, indexed by kernel
+static const char* const PLANNERKERNELNAMES[FastFourierTransformKernelTotal] =
+    {"RadixFour", "FourStep", "FixedSize", "FixedPoint"};
+
+/**
+ * @brief Constructor for the FastFourierTransformPlanner class.
+ * @param wisdomFilePath The path of the wisdom file, or `nullptr` to keep the
+ * choices in memory only. The device build has no files and ignores it.
+ * @param threadCount The number of threads running large native transforms,
+ * passed on to `FastFourierTransform`.
+ */
+template <typename element_datatype>
+FastFourierTransformPlanner<element_datatype>::FastFourierTransformPlanner(
+    const char* wisdomFilePath, unsigned int threadCount)
+    : radixFour(threadCount) {
+#ifdef EXCLUDEARDUINOLIB
+  if (wisdomFilePath != nullptr) {
+    this->wisdomFilePath = wisdomFilePath;
+    loadWisdom();
+  }
+#else
+  (void)wisdomFilePath;
+#endif
+};
+
+/**
+ * @brief Retrieves the kernel of a transform size, measuring the candidates on
+ * first use.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @return The fastest kernel.
+ */
+template <typename element_datatype>
+FastFourierTransformKernel FastFourierTransformPlanner<
+    element_datatype>::getKernel(unsigned int log2n) {
+  typename std::map<unsigned int, FastFourierTransformKernel>::const_iterator
+      choice = kernels.find(log2n);
+  if (choice != kernels.end()) {
+    return choice->second;
+  }
+  return plan(log2n);
+};
+
+/**
+ * @brief Retrieves the name of a kernel, as written in the wisdom file.
+ * @param kernel The kernel.
+ * @return The name of the kernel.
+ */
+template <typename element_datatype>
+const char* FastFourierTransformPlanner<element_datatype>::getKernelName(
+    FastFourierTransformKernel kernel) {
+  return PLANNERKERNELNAMES[kernel];
+};
+
+/**
+ * @brief Checks whether a kernel can compute a transform size.
+ * @param kernel The kernel.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @return `true` if the kernel is a candidate of the size.
+ *
+ * The four-step kernel is only a candidate on native builds, from the size it
+ * stops falling back to the radix-4 kernels.
+ */
+template <typename element_datatype>
+bool FastFourierTransformPlanner<element_datatype>::isCandidate(
+    FastFourierTransformKernel kernel, unsigned int log2n) {
+  switch (kernel) {
+    case FourStepKernel:
+#ifdef PARALLELBUTTERFLIES
+      return log2n >=
+             FastFourierTransform<element_datatype>::FOURSTEPMINIMUMLOG2N;
+#else
+      return false;
+#endif
+    case FixedSizeKernel:
+      return (std::size_t(1) << log2n) == PLANNERFIXEDSIZE;
+    default:
+      return true;
+  }
+};
+
+/**
+ * @brief Measures every candidate of a transform size and records the fastest
+ * one.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @return The fastest kernel.
+ *
+ * The benchmark buffer is released afterwards, as every size is only planned
+ * once.
+ */
+template <typename element_datatype>
+FastFourierTransformKernel FastFourierTransformPlanner<element_datatype>::plan(
+    unsigned int log2n) {
+  const std::size_t n = std::size_t(1) << log2n;
+  // A fixed linear congruential sequence, so every candidate sees the same
+  // values in [-1, 1)
+  benchmark.resize(n);
+  unsigned long state = 1;
+  for (std::size_t i = 0; i < n; i++) {
+    state = (state * 1103515245ul + 12345ul) & 0x7fffffff;
+    element_datatype real = element_datatype(state) / 0x40000000 - 1;
+    state = (state * 1103515245ul + 12345ul) & 0x7fffffff;
+    element_datatype imaginary = element_datatype(state) / 0x40000000 - 1;
+    benchmark[i] = std::complex<element_datatype>(real, imaginary);
+  }
+
+  FastFourierTransformKernel fastest = RadixFourKernel;
+  double fastestTime = measure(RadixFourKernel, log2n);
+  for (int candidate = RadixFourKernel + 1;
+       candidate < FastFourierTransformKernelTotal; candidate++) {
+    FastFourierTransformKernel kernel =
+        static_cast<FastFourierTransformKernel>(candidate);
+    if (!isCandidate(kernel, log2n)) {
+      continue;
+    }
+    double time = measure(kernel, log2n);
+    if (time < fastestTime) {
+      fastest = kernel;
+      fastestTime = time;
+    }
+  }
+  std::vector<std::complex<element_datatype>>().swap(benchmark);
+
+  kernels[log2n] = fastest;
+#ifdef EXCLUDEARDUINOLIB
+  saveWisdom(log2n, fastest);
+#endif
+  return fastest;
+};
+
+/**
+ * @brief Measures the time of a forward and inverse transform pair of a
+ * kernel.
+ * @param kernel The kernel.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @return The shortest time of a pair over the trials, in microseconds.
+ *
+ * A first pair builds the plans of the kernel and warms the caches. Every
+ * trial then runs pairs until `PLANNERMINIMUMTIMEUS` has passed or
+ * `PLANNERMAXIMUMPAIRS` pairs ran.
+ */
+template <typename element_datatype>
+double FastFourierTransformPlanner<element_datatype>::measure(
+    FastFourierTransformKernel kernel, unsigned int log2n) {
+  std::complex<element_datatype>* data = benchmark.data();
+  forward(kernel, data, log2n);
+  inverse(kernel, data, log2n);
+
+  double shortestTime = 0;
+  for (unsigned int trial = 0; trial < PLANNERTRIALS; trial++) {
+    unsigned long start = getMicroseconds();
+    unsigned long elapsed = 0;
+    unsigned int pairs = 0;
+    while (elapsed < PLANNERMINIMUMTIMEUS && pairs < PLANNERMAXIMUMPAIRS) {
+      forward(kernel, data, log2n);
+      inverse(kernel, data, log2n);
+      pairs++;
+      elapsed = getMicroseconds() - start;
+    }
+    double time = double(elapsed) / pairs;
+    if (trial == 0 || time < shortestTime) {
+      shortestTime = time;
+    }
+  }
+  return shortestTime;
+};
+
+/**
+ * @brief Retrieves the transform running the interface calls of a kernel.
+ * @param kernel The kernel.
+ * @return The transform, `FastFourierTransform` for the four-step kernel.
+ */
+template <typename element_datatype>
+FastFourierTransformInterface<element_datatype>&
+FastFourierTransformPlanner<element_datatype>::transformOf(
+    FastFourierTransformKernel kernel) {
+  switch (kernel) {
+    case FixedSizeKernel:
+      return fixedSize;
+    case FixedPointKernel:
+      return fixedPoint;
+    default:
+      return radixFour;
+  }
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place with a kernel.
+ * @param kernel The kernel.
+ * @param data The interleaved complex data, `2 ^ log2n` elements.
+ * @param log2n The base 2 logarithm of the transform size.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::forward(
+    FastFourierTransformKernel kernel, std::complex<element_datatype>* data,
+    unsigned int log2n) {
+  if (kernel == FourStepKernel) {
+    radixFour.fourStepFastFourierTransformInPlace(data, log2n);
+    return;
+  }
+  transformOf(kernel).fastFourierTransformInPlace(data, log2n);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place with a
+ * kernel, scaled by `1 / n`.
+ * @param kernel The kernel.
+ * @param data The interleaved complex data, `2 ^ log2n` elements.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * The four-step kernel has no inverse of its own, it runs the forward
+ * transform of the conjugate, which is the conjugate of the inverse.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::inverse(
+    FastFourierTransformKernel kernel, std::complex<element_datatype>* data,
+    unsigned int log2n) {
+  if (kernel != FourStepKernel) {
+    transformOf(kernel).inverseFastFourierTransformInPlace(data, log2n);
+    return;
+  }
+  const std::size_t n = std::size_t(1) << log2n;
+  for (std::size_t i = 0; i < n; i++) {
+    data[i] = std::conj(data[i]);
+  }
+  radixFour.fourStepFastFourierTransformInPlace(data, log2n);
+  const element_datatype scale = element_datatype(1) / element_datatype(n);
+  for (std::size_t i = 0; i < n; i++) {
+    data[i] = std::conj(data[i]) * scale;
+  }
+};
+
+/**
+ * @brief Gets the current time in microseconds.
+ * @return The current time in microseconds.
+ */
+template <typename element_datatype>
+unsigned long FastFourierTransformPlanner<element_datatype>::getMicroseconds() {
+#ifdef EXCLUDEARDUINOLIB
+  return static_cast<unsigned long>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+#else
+  return micros();
+#endif
+};
+
+#ifdef EXCLUDEARDUINOLIB
+/**
+ * @brief Reads the choices of this element type from the wisdom file.
+ *
+ * A missing file holds no choices. Lines of another element type, of an
+ * unknown kernel or of a kernel that cannot compute their size are skipped, so
+ * a file written by another build does no harm.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::loadWisdom() {
+  std::FILE* file = std::fopen(wisdomFilePath.c_str(), "r");
+  if (file == nullptr) {
+    return;
+  }
+  char line[64];
+  while (std::fgets(line, sizeof(line), file) != nullptr) {
+    unsigned int elementSize = 0;
+    unsigned int log2n = 0;
+    char name[32];
+    if (std::sscanf(line, "%u %u %31s", &elementSize, &log2n, name) != 3 ||
+        elementSize != sizeof(element_datatype)) {
+      continue;
+    }
+    for (int kernel = 0; kernel < FastFourierTransformKernelTotal; kernel++) {
+      if (std::strcmp(name, PLANNERKERNELNAMES[kernel]) == 0 &&
+          isCandidate(static_cast<FastFourierTransformKernel>(kernel),
+                      log2n)) {
+        kernels[log2n] = static_cast<FastFourierTransformKernel>(kernel);
+      }
+    }
+  }
+  std::fclose(file);
+};
+
+/**
+ * @brief Appends a choice to the wisdom file.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @param kernel The chosen kernel.
+ *
+ * The wisdom only saves time, so a file that cannot be written is ignored.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::saveWisdom(
+    unsigned int log2n, FastFourierTransformKernel kernel) {
+  if (wisdomFilePath.empty()) {
+    return;
+  }
+  std::FILE* file = std::fopen(wisdomFilePath.c_str(), "a");
+  if (file == nullptr) {
+    return;
+  }
+  std::fprintf(file, "%u %u %s\n",
+               static_cast<unsigned int>(sizeof(element_datatype)), log2n,
+               PLANNERKERNELNAMES[kernel]);
+  std::fclose(file);
+};
+#endif
+
+/**
+ * @brief Performs the Fast Fourier Transform operation on the input data and
+ * returns the result to the address with `2 ^ realInput.length()` elements.
+ * @param realInput The input data vector for real part.
+ * @param imaginaryInput The input data vector for imaginary part.
+ * @param realOutput The output data vector for real part.
+ * @param imaginaryOutput The output data vector for imaginary part.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::fastFourierTransform(
+    const std::vector<element_datatype>* realInput,
+    const std::vector<element_datatype>* imaginaryInput,
+    std::vector<element_datatype>* realOutput,
+    std::vector<element_datatype>* imaginaryOutput) {
+  radixFour.fastFourierTransform(realInput, imaginaryInput, realOutput,
+                                 imaginaryOutput);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation on the input
+ * data and returns the result to the address with `2 ^ realInput.length()`
+ * elements.
+ * @param realInput The input data vector for real part.
+ * @param imaginaryInput The input data vector for imaginary part.
+ * @param realOutput The output data vector for real part.
+ * @param imaginaryOutput The output data vector for imaginary part.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::inverseFastFourierTransform(
+    const std::vector<element_datatype>* realInput,
+    const std::vector<element_datatype>* imaginaryInput,
+    std::vector<element_datatype>* realOutput,
+    std::vector<element_datatype>* imaginaryOutput) {
+  radixFour.inverseFastFourierTransform(realInput, imaginaryInput, realOutput,
+                                        imaginaryOutput);
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation on real input data and
+ * returns the `n / 2 + 1` non-negative frequency bins, where `n` is the input
+ * size padded to a power of two.
+ * @param realInput The input data vector.
+ * @param realOutput The output data vector for real part.
+ * @param imaginaryOutput The output data vector for imaginary part.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::realFastFourierTransform(
+    const std::vector<element_datatype>* realInput,
+    std::vector<element_datatype>* realOutput,
+    std::vector<element_datatype>* imaginaryOutput) {
+  radixFour.realFastFourierTransform(realInput, realOutput, imaginaryOutput);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation on the
+ * `n / 2 + 1` non-negative frequency bins of a real signal and returns the `n`
+ * real samples.
+ * @param realInput The input data vector for real part.
+ * @param imaginaryInput The input data vector for imaginary part.
+ * @param realOutput The output data vector.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::
+    inverseRealFastFourierTransform(
+        const std::vector<element_datatype>* realInput,
+        const std::vector<element_datatype>* imaginaryInput,
+        std::vector<element_datatype>* realOutput) {
+  radixFour.inverseRealFastFourierTransform(realInput, imaginaryInput,
+                                            realOutput);
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place with the
+ * kernel of the transform size.
+ * @param data The interleaved complex data, `2 ^ log2n` elements.
+ * @param log2n The base 2 logarithm of the transform size.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::fastFourierTransformInPlace(
+    std::complex<element_datatype>* data, unsigned int log2n) {
+  forward(getKernel(log2n), data, log2n);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place with
+ * the kernel of the transform size, scaled by `1 / n`.
+ * @param data The interleaved complex data, `2 ^ log2n` elements.
+ * @param log2n The base 2 logarithm of the transform size.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::
+    inverseFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                       unsigned int log2n) {
+  inverse(getKernel(log2n), data, log2n);
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place on any number
+ * of elements, with the kernel of the size if it is a power of two.
+ * @param data The interleaved complex data, `size` elements.
+ * @param size The transform size.
+ *
+ * Only `FastFourierTransform` computes the other sizes, so they are not
+ * planned.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::
+    exactSizeFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                         std::size_t size) {
+  if (size < 2 || (size & (size - 1)) != 0) {
+    radixFour.exactSizeFastFourierTransformInPlace(data, size);
+    return;
+  }
+  unsigned int log2n = 0;
+  while ((std::size_t(1) << log2n) < size) {
+    log2n++;
+  }
+  fastFourierTransformInPlace(data, log2n);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place on any
+ * number of elements, with the kernel of the size if it is a power of two,
+ * scaled by `1 / size`.
+ * @param data The interleaved complex data, `size` elements.
+ * @param size The transform size.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::
+    inverseExactSizeFastFourierTransformInPlace(
+        std::complex<element_datatype>* data, std::size_t size) {
+  if (size < 2 || (size & (size - 1)) != 0) {
+    radixFour.inverseExactSizeFastFourierTransformInPlace(data, size);
+    return;
+  }
+  unsigned int log2n = 0;
+  while ((std::size_t(1) << log2n) < size) {
+    log2n++;
+  }
+  inverseFastFourierTransformInPlace(data, log2n);
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place on real data
+ * with the kernel of the transform size.
+ * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding the
+ * real samples as scalars on entry and the bins on exit.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * The kernel is the one measured on complex transforms of the same size. The
+ * four-step kernel has no real transform, `FastFourierTransform` runs it.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::
+    realFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                    unsigned int log2n) {
+  transformOf(getKernel(log2n)).realFastFourierTransformInPlace(data, log2n);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place on the
+ * non-negative frequency half of a Hermitian spectrum with the kernel of the
+ * transform size.
+ * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding the
+ * bins on entry and the real samples as scalars on exit.
+ * @param log2n The base 2 logarithm of the transform size.
+ */
+template <typename element_datatype>
+void FastFourierTransformPlanner<element_datatype>::
+    inverseRealFastFourierTransformInPlace(
+        std::complex<element_datatype>* data, unsigned int log2n) {
+  transformOf(getKernel(log2n))
+      .inverseRealFastFourierTransformInPlace(data, log2n);
+};
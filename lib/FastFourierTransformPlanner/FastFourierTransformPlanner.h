@@ -0,0 +1,299 @@
+#ifndef FAST_FOURIER_TRANSFORM_PLANNER_H
+#define FAST_FOURIER_TRANSFORM_PLANNER_H
+
+#include <complex>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "FastFourierTransform.h"
+#include "FixedFastFourierTransform.h"
+#include "FixedPointFastFourierTransform.h"
+#include "signal_filter/FastFourierTransformInterface.h"
+
+/**
+ * @brief Transform kernels the planner chooses from.
+ */
+typedef enum {
+  RadixFourKernel,   // FastFourierTransform
+  FourStepKernel,    // FastFourierTransform, four-step algorithm
+  FixedSizeKernel,   // FixedFastFourierTransform of the fixed size
+  FixedPointKernel,  // FixedPointFastFourierTransform in Q31
+  FastFourierTransformKernelTotal
+} FastFourierTransformKernel;
+
+/**
+ * @brief Fast Fourier Transform that measures the kernels able to compute a
+ * transform size the first time that size is used, and runs the fastest one
+ * from then on.
+ *
+ * The candidates are the radix-4 `FastFourierTransform`, its four-step mode
+ * for large native transforms, the `FixedFastFourierTransform` of
+ * `PLANNERFIXEDSIZE` points and the Q31 `FixedPointFastFourierTransform`. Q15
+ * is not a candidate, its 50 dB of signal to noise ratio is below the
+ * resolution of the 12 bit ADC.
+ *
+ * Each candidate computes pairs of forward and inverse transforms of the same
+ * buffer, so its values neither grow nor vanish, and the fastest of a few
+ * trials counts. On native builds the choices can be kept in a wisdom file, a
+ * text file with one `<element size> <log2n> <kernel name>` line per choice.
+ * It is read when the planner is built and appended to after every new
+ * measurement, so later runs skip the measurements and later lines win.
+ *
+ * The in-place power of two transforms run the chosen kernel. Other exact
+ * sizes and the vector transforms run `FastFourierTransform`, the only kernel
+ * computing them. `Filter` transforms its histories at their exact size, so
+ * the device keeps a plain `FastFourierTransform`: its 50 sample history has
+ * nothing to plan, and measuring inside the signal processing step would
+ * block it.
+ * @tparam element_datatype The data type of the elements in the input and
+ * output vectors.
+ */
+template <typename element_datatype>
+class FastFourierTransformPlanner
+    : public FastFourierTransformInterface<element_datatype> {
+ public:
+  /**
+   * @brief Constructor for the FastFourierTransformPlanner class.
+   * @param wisdomFilePath The path of the wisdom file, or `nullptr` to keep
+   * the choices in memory only. The device build has no files and ignores it.
+   * @param threadCount The number of threads running large native transforms,
+   * passed on to `FastFourierTransform`.
+   */
+  explicit FastFourierTransformPlanner(const char* wisdomFilePath = nullptr,
+                                       unsigned int threadCount = 1);
+
+  /**
+   * @brief Retrieves the kernel of a transform size, measuring the candidates
+   * on first use.
+   * @param log2n The base 2 logarithm of the transform size.
+   * @return The fastest kernel.
+   */
+  FastFourierTransformKernel getKernel(unsigned int log2n);
+
+  /**
+   * @brief Retrieves the name of a kernel, as written in the wisdom file.
+   * @param kernel The kernel.
+   * @return The name of the kernel.
+   */
+  static const char* getKernelName(FastFourierTransformKernel kernel);
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation on the input data and
+   * returns the result to the address with `2 ^ realInput.length()` elements.
+   * @param realInput The input data vector for real part.
+   * @param imaginaryInput The input data vector for imaginary part.
+   * @param realOutput The output data vector for real part.
+   * @param imaginaryOutput The output data vector for imaginary part.
+   */
+  void fastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation on the input
+   * data and returns the result to the address with `2 ^ realInput.length()`
+   * elements.
+   * @param realInput The input data vector for real part.
+   * @param imaginaryInput The input data vector for imaginary part.
+   * @param realOutput The output data vector for real part.
+   * @param imaginaryOutput The output data vector for imaginary part.
+   */
+  void inverseFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation on real input data
+   * and returns the `n / 2 + 1` non-negative frequency bins, where `n` is the
+   * input size padded to a power of two.
+   * @param realInput The input data vector.
+   * @param realOutput The output data vector for real part.
+   * @param imaginaryOutput The output data vector for imaginary part.
+   */
+  void realFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation on the
+   * `n / 2 + 1` non-negative frequency bins of a real signal and returns the
+   * `n` real samples.
+   * @param realInput The input data vector for real part.
+   * @param imaginaryInput The input data vector for imaginary part.
+   * @param realOutput The output data vector.
+   */
+  void inverseRealFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place with the
+   * kernel of the transform size.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void fastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                   unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place with
+   * the kernel of the transform size, scaled by `1 / n`.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void inverseFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                          unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place on any
+   * number of elements, with the kernel of the size if it is a power of two.
+   * @param data The interleaved complex data, `size` elements.
+   * @param size The transform size.
+   */
+  void exactSizeFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, std::size_t size) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place on
+   * any number of elements, with the kernel of the size if it is a power of
+   * two, scaled by `1 / size`.
+   * @param data The interleaved complex data, `size` elements.
+   * @param size The transform size.
+   */
+  void inverseExactSizeFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, std::size_t size) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place on real
+   * data with the kernel of the transform size.
+   * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding
+   * the real samples as scalars on entry and the bins on exit.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void realFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                       unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place on
+   * the non-negative frequency half of a Hermitian spectrum with the kernel of
+   * the transform size.
+   * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding
+   * the bins on entry and the real samples as scalars on exit.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void inverseRealFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, unsigned int log2n) override;
+
+  // Size of the `FixedFastFourierTransform` candidate, the size its tables
+  // are built for.
+  static const std::size_t PLANNERFIXEDSIZE = 64;
+
+ private:
+  /**
+   * @brief Checks whether a kernel can compute a transform size.
+   * @param kernel The kernel.
+   * @param log2n The base 2 logarithm of the transform size.
+   * @return `true` if the kernel is a candidate of the size.
+   */
+  static bool isCandidate(FastFourierTransformKernel kernel,
+                          unsigned int log2n);
+
+  /**
+   * @brief Measures every candidate of a transform size and records the
+   * fastest one.
+   * @param log2n The base 2 logarithm of the transform size.
+   * @return The fastest kernel.
+   */
+  FastFourierTransformKernel plan(unsigned int log2n);
+
+  /**
+   * @brief Measures the time of a forward and inverse transform pair of a
+   * kernel.
+   * @param kernel The kernel.
+   * @param log2n The base 2 logarithm of the transform size.
+   * @return The shortest time of a pair over the trials, in microseconds.
+   */
+  double measure(FastFourierTransformKernel kernel, unsigned int log2n);
+
+  /**
+   * @brief Retrieves the transform running the interface calls of a kernel.
+   * @param kernel The kernel.
+   * @return The transform, `FastFourierTransform` for the four-step kernel.
+   */
+  FastFourierTransformInterface<element_datatype>& transformOf(
+      FastFourierTransformKernel kernel);
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place with a
+   * kernel.
+   * @param kernel The kernel.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void forward(FastFourierTransformKernel kernel,
+               std::complex<element_datatype>* data, unsigned int log2n);
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place with
+   * a kernel, scaled by `1 / n`.
+   * @param kernel The kernel.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void inverse(FastFourierTransformKernel kernel,
+               std::complex<element_datatype>* data, unsigned int log2n);
+
+  /**
+   * @brief Gets the current time in microseconds.
+   * @return The current time in microseconds.
+   */
+  static unsigned long getMicroseconds();
+
+#ifdef EXCLUDEARDUINOLIB
+  /**
+   * @brief Reads the choices of this element type from the wisdom file.
+   */
+  void loadWisdom();
+
+  /**
+   * @brief Appends a choice to the wisdom file.
+   * @param log2n The base 2 logarithm of the transform size.
+   * @param kernel The chosen kernel.
+   */
+  void saveWisdom(unsigned int log2n, FastFourierTransformKernel kernel);
+#endif
+
+  // Number of measurements of every candidate, the fastest one counts
+  static const unsigned int PLANNERTRIALS = 3;
+  // Time a measurement lasts at least, short ones are dominated by the clock
+  // resolution
+  static const unsigned long PLANNERMINIMUMTIMEUS = 2000;
+  // Number of transform pairs a measurement runs at most
+  static const unsigned int PLANNERMAXIMUMPAIRS = 256;
+
+  FastFourierTransform<element_datatype> radixFour;  // Radix-4 kernels
+  FixedFastFourierTransform<element_datatype, PLANNERFIXEDSIZE>
+      fixedSize;  // Fixed size kernel
+  FixedPointFastFourierTransform<element_datatype, q31_data_type>
+      fixedPoint;  // Q31 kernel
+  std::map<unsigned int, FastFourierTransformKernel>
+      kernels;  // Chosen kernels, keyed by log2n
+  std::vector<std::complex<element_datatype>> benchmark;  // Measured data
+#ifdef EXCLUDEARDUINOLIB
+  std::string wisdomFilePath;  // Wisdom file, empty for none
+#endif
+};
+
+// Explicit instantiation
+template class FastFourierTransformPlanner<float>;
+template class FastFourierTransformPlanner<double>;
+
+#endif
@@ -1,5 +1,7 @@
 #include "Filter.h"
 
+#include <algorithm>
+
 #ifdef UNIT_TEST
 #include <stdexcept>
 #endif
@@ -79,80 +81,223 @@ void Filter<element_data_type, signal_period_datatype>::process(
   }
 #endif
 
-  // Retrieve the signal history from the input filter
-  element_data_type historySize =
-      static_cast<element_data_type>(filterInputPtr->size());
-  std::vector<element_data_type> realInput(historySize),
-      imaginaryInput(historySize);
-  for (std::size_t i = 0; i < historySize; ++i) {
-    realInput[i] = filterInputPtr->get(i);
-    imaginaryInput[i] = 0;  // Assume that the imaginary part is always 0
+  std::size_t historySize = static_cast<std::size_t>(filterInputPtr->size());
+  if ((historySize & (historySize - 1)) != 0) {
+    processExactSize(filterInputPtr, filterOutputPtr, historySize);
+    return;
   }
 
+  // Copy the signal history into the workspace, the signal is real so it is
+  // transformed in place into the non-negative half of its spectrum
+  unsigned int transformLogBase2 = sizeLogBase2(historySize);
+  unsigned int transformSize = 1u << transformLogBase2;
+  std::size_t binCount = transformSize / 2 + 1;
+  if (workspace.size() < binCount) {
+    workspace.resize(binCount);
+  }
+  element_data_type* samples =
+      reinterpret_cast<element_data_type*>(workspace.data());
+  filterInputPtr->copyBlock(0, historySize, samples);
+  std::fill(samples + historySize, samples + 2 * binCount,
+            static_cast<element_data_type>(0));
+
   // Perform FFT on the input data
-  std::vector<element_data_type> realOutput, imaginaryOutput;
-  fftClassInstancePtr->fastFourierTransform(&realInput, &imaginaryInput,
-                                            &realOutput, &imaginaryOutput);
+  fftClassInstancePtr->realFastFourierTransformInPlace(workspace.data(),
+                                                       transformLogBase2);
+
+  // Modify the frequency components according to the passbands and stopbands
+  for (std::size_t i = 0; i < binCount; ++i) {
+    if (!keepsBin(i, transformSize)) {
+      workspace[i] = 0;
+    }
+  }
 
-  // Array size check.
+  return;
+  // Perform inverse FFT on the modified frequency components
+  fftClassInstancePtr->inverseRealFastFourierTransformInPlace(
+      workspace.data(), transformLogBase2);
+
+  // Store the filtered signal
+  for (std::size_t i = 0; i < historySize; ++i) {
+    filterOutputPtr->put(samples[i]);
+  }
+
+  return;
+}
+
+/**
+ * @brief Apply the filter to two signals sampled together with one complex
+ * transform, the first signal in its real part and the second one in its
+ * imaginary part.
+ *
+ * @param firstInputPtr The first input data to be filtered.
+ * @param secondInputPtr The second input data to be filtered.
+ * @param firstOutputPtr The first output data after filtering.
+ * @param secondOutputPtr The second output data after filtering.
+ *
+ * Bin `k` and bin `n - k` hold the same frequency and are kept or zeroed
+ * together, so the mask is real and symmetric. The spectrum of each signal is
+ * Hermitian, so the masked spectra stay Hermitian and the inverse transform
+ * returns the filtered first signal in its real part and the filtered second
+ * signal in its imaginary part, without separating the spectra.
+ */
+template <typename element_data_type, typename signal_period_datatype>
+void Filter<element_data_type, signal_period_datatype>::processPair(
+    SignalHistoryInterface<element_data_type>* firstInputPtr,
+    SignalHistoryInterface<element_data_type>* secondInputPtr,
+    SignalHistoryInterface<element_data_type>* firstOutputPtr,
+    SignalHistoryInterface<element_data_type>* secondOutputPtr) {
 #ifdef UNIT_TEST
-  if (realOutput.size() == imaginaryOutput.size()) {
-    throw std::invalid_argument(
-        "realOutput and imaginaryOutput have different size.");
+  if (firstInputPtr == nullptr || secondInputPtr == nullptr ||
+      firstOutputPtr == nullptr || secondOutputPtr == nullptr) {
+    throw std::invalid_argument("Input and output pointers cannot be null");
   }
 #endif
 
-  //  Get the frequencies in the frequency
-  std::vector<element_data_type> fftFrequency =
-      this->fftfreq(static_cast<unsigned int>(realOutput.size()));
+  // The shorter signal is zero-padded to the longer one, which is transformed
+  // at its exact size
+  std::size_t firstSize = static_cast<std::size_t>(firstInputPtr->size());
+  std::size_t secondSize = static_cast<std::size_t>(secondInputPtr->size());
+  std::size_t transformSize = std::max(firstSize, secondSize);
+  if (workspace.size() < transformSize) {
+    workspace.resize(transformSize);
+  }
+  if (pairScratch.size() < transformSize) {
+    pairScratch.resize(transformSize);
+  }
+
+  // Copy the first signal to the front of the workspace and interleave it with
+  // the second one from the back, so no value is overwritten before it is read
+  element_data_type* samples =
+      reinterpret_cast<element_data_type*>(workspace.data());
+  firstInputPtr->copyBlock(0, firstSize, samples);
+  std::fill(samples + firstSize, samples + transformSize,
+            static_cast<element_data_type>(0));
+  secondInputPtr->copyBlock(0, secondSize, pairScratch.data());
+  std::fill(pairScratch.begin() + secondSize,
+            pairScratch.begin() + transformSize,
+            static_cast<element_data_type>(0));
+  for (std::size_t i = transformSize; i-- > 0;) {
+    workspace[i] = std::complex<element_data_type>(samples[i], pairScratch[i]);
+  }
+
+  // Perform one FFT for both signals
+  fftClassInstancePtr->exactSizeFastFourierTransformInPlace(workspace.data(),
+                                                            transformSize);
 
   // Modify the frequency components according to the passbands and stopbands
-  for (std::size_t i = 0; i < realOutput.size(); ++i) {
-    element_data_type fftFrequencyIter = fftFrequency[i];
+  for (std::size_t i = 0; i < transformSize; ++i) {
+    if (!keepsBin(std::min<std::size_t>(i, transformSize - i),
+                  transformSize)) {
+      workspace[i] = 0;
+    }
+  }
 
-    if (isInPassband(fftFrequencyIter, stopbands)) continue;
+  return;
+  // Perform one inverse FFT for both signals
+  fftClassInstancePtr->inverseExactSizeFastFourierTransformInPlace(
+      workspace.data(), transformSize);
 
-    realOutput[i] = 0;
-    imaginaryOutput[i] = 0;
+  // Store the filtered signals
+  for (std::size_t i = 0; i < firstSize; ++i) {
+    firstOutputPtr->put(workspace[i].real());
+  }
+  for (std::size_t i = 0; i < secondSize; ++i) {
+    secondOutputPtr->put(workspace[i].imag());
+  }
 
-#ifdef UNIT_TEST
-    if (!isInStopband(fftFrequencyIter, stopbands)) {
-      throw std::invalid_argument(
-          "Frequency not placed in passband or stopband");
+  return;
+}
+
+/**
+ * @brief Apply the filter to a history whose size is not a power of two. Such
+ * a history has no real transform, so it is transformed as complex data with
+ * a zero imaginary part, at its exact size.
+ *
+ * @param filterInputPtr The input data to be filtered.
+ * @param filterOutputPtr The output data after filtering.
+ * @param historySize The number of samples of the input data.
+ */
+template <typename element_data_type, typename signal_period_datatype>
+void Filter<element_data_type, signal_period_datatype>::processExactSize(
+    SignalHistoryInterface<element_data_type>* filterInputPtr,
+    SignalHistoryInterface<element_data_type>* filterOutputPtr,
+    std::size_t historySize) {
+  if (workspace.size() < historySize) {
+    workspace.resize(historySize);
+  }
+
+  // Copy the signal to the front of the workspace and spread it from the back,
+  // so no value is overwritten before it is read
+  element_data_type* samples =
+      reinterpret_cast<element_data_type*>(workspace.data());
+  filterInputPtr->copyBlock(0, historySize, samples);
+  for (std::size_t i = historySize; i-- > 0;) {
+    workspace[i] = std::complex<element_data_type>(samples[i], 0);
+  }
+
+  // Perform FFT on the input data
+  fftClassInstancePtr->exactSizeFastFourierTransformInPlace(workspace.data(),
+                                                            historySize);
+
+  // Modify the frequency components according to the passbands and stopbands
+  for (std::size_t i = 0; i < historySize; ++i) {
+    if (!keepsBin(std::min<std::size_t>(i, historySize - i), historySize)) {
+      workspace[i] = 0;
     }
-#endif
   }
 
   return;
   // Perform inverse FFT on the modified frequency components
-  std::vector<element_data_type> realOutputInverse, imaginaryOutputInverse;
-  fftClassInstancePtr->inverseFastFourierTransform(
-      &realOutput, &imaginaryOutput, &realOutputInverse,
-      &imaginaryOutputInverse);
+  fftClassInstancePtr->inverseExactSizeFastFourierTransformInPlace(
+      workspace.data(), historySize);
 
   // Store the filtered signal
-  for (std::size_t i = 0; i < realInput.size(); ++i) {
-    filterOutputPtr->put(realOutputInverse[i]);
-  }
-
-  // Free all the memory
-  realInput.clear();
-  imaginaryInput.clear();
-  realOutput.clear();
-  imaginaryOutput.clear();
-  realOutputInverse.clear();
-  imaginaryOutputInverse.clear();
-  fftFrequency.clear();
-
-  realInput.shrink_to_fit();
-  imaginaryInput.shrink_to_fit();
-  realOutput.shrink_to_fit();
-  imaginaryOutput.shrink_to_fit();
-  realOutputInverse.shrink_to_fit();
-  imaginaryOutputInverse.shrink_to_fit();
-  fftFrequency.shrink_to_fit();
+  for (std::size_t i = 0; i < historySize; ++i) {
+    filterOutputPtr->put(workspace[i].real());
+  }
+}
 
-  return;
+/**
+ * @brief Computes the base 2 logarithm of a power of two number of samples.
+ *
+ * @param sampleCount The number of samples, a power of two.
+ * @return The base 2 logarithm of the number of samples.
+ */
+template <typename element_data_type, typename signal_period_datatype>
+unsigned int Filter<element_data_type, signal_period_datatype>::sizeLogBase2(
+    std::size_t sampleCount) {
+  unsigned int logBase2 = 0;
+  while ((static_cast<std::size_t>(1) << logBase2) < sampleCount) {
+    ++logBase2;
+  }
+  return logBase2;
+}
+
+/**
+ * @brief Decides whether a frequency bin passes the filter.
+ *
+ * @param bin The bin, at most half the transform size.
+ * @param transformSize The size of the transform.
+ * @return true if the bin is kept, false if it is zeroed.
+ */
+template <typename element_data_type, typename signal_period_datatype>
+bool Filter<element_data_type, signal_period_datatype>::keepsBin(
+    std::size_t bin, unsigned int transformSize) {
+  // Get the frequencies of the spectrum
+  if (binFrequencies.size() != transformSize) {
+    binFrequencies = this->fftfreq(transformSize);
+  }
+  element_data_type fftFrequencyIter = binFrequencies[bin];
+
+  if (isInPassband(fftFrequencyIter, stopbands)) return true;
+
+#ifdef UNIT_TEST
+  if (!isInStopband(fftFrequencyIter, stopbands)) {
+    throw std::invalid_argument("Frequency not placed in passband or stopband");
+  }
+#endif
+  return false;
 }
 
 /**
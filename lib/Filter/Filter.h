@@ -11,6 +11,11 @@
  * algorithm to process and filter input data based on the provided passbands
  * and stopbands.
  *
+ * The forward transform, the masking and the inverse transform all run in
+ * place in one workspace, which is only reallocated when the history grows.
+ * Histories are transformed at their exact size, so the bins fall on the grid
+ * of `fftfreq` for the history size instead of a zero-padded one.
+ *
  * @tparam element_data_type The data type of the input data elements.
  * @tparam signal_period_datatype The data type of the time period values in
  * microseconds.
@@ -47,6 +52,22 @@ class Filter
       SignalHistoryInterface<element_data_type>* filterInputPtr,
       SignalHistoryInterface<element_data_type>* filterOutputPtr) override;
 
+  /**
+   * @brief Apply the filter to two signals sampled together with one complex
+   * transform, the first signal in its real part and the second one in its
+   * imaginary part.
+   *
+   * @param firstInputPtr The first input data to be filtered.
+   * @param secondInputPtr The second input data to be filtered.
+   * @param firstOutputPtr The first output data after filtering.
+   * @param secondOutputPtr The second output data after filtering.
+   */
+  void processPair(
+      SignalHistoryInterface<element_data_type>* firstInputPtr,
+      SignalHistoryInterface<element_data_type>* secondInputPtr,
+      SignalHistoryInterface<element_data_type>* firstOutputPtr,
+      SignalHistoryInterface<element_data_type>* secondOutputPtr) override;
+
  private:
   FastFourierTransformInterface<element_data_type>*
       fftClassInstancePtr;  //!< The FastFourierTransformInterface instance.
@@ -55,6 +76,44 @@ class Filter
   std::vector<std::pair<element_data_type, element_data_type>> passbands;
   std::vector<std::pair<element_data_type, element_data_type>> stopbands;
 
+  // Spectrum of the last processed history, reused by every process() call
+  std::vector<std::complex<element_data_type>> workspace;
+  // Frequencies of the spectrum, recomputed when its size changes
+  std::vector<element_data_type> binFrequencies;
+  // Second signal of processPair() while the first one is interleaved
+  std::vector<element_data_type> pairScratch;
+
+  /**
+   * @brief Apply the filter to a history whose size is not a power of two.
+   * Such a history has no real transform, so it is transformed as complex
+   * data with a zero imaginary part, at its exact size.
+   *
+   * @param filterInputPtr The input data to be filtered.
+   * @param filterOutputPtr The output data after filtering.
+   * @param historySize The number of samples of the input data.
+   */
+  void processExactSize(
+      SignalHistoryInterface<element_data_type>* filterInputPtr,
+      SignalHistoryInterface<element_data_type>* filterOutputPtr,
+      std::size_t historySize);
+
+  /**
+   * @brief Computes the base 2 logarithm of a power of two number of samples.
+   *
+   * @param sampleCount The number of samples, a power of two.
+   * @return The base 2 logarithm of the number of samples.
+   */
+  static unsigned int sizeLogBase2(std::size_t sampleCount);
+
+  /**
+   * @brief Decides whether a frequency bin passes the filter.
+   *
+   * @param bin The bin, at most half the transform size.
+   * @param transformSize The size of the transform.
+   * @return true if the bin is kept, false if it is zeroed.
+   */
+  bool keepsBin(std::size_t bin, unsigned int transformSize);
+
   bool isInPassband(
       element_data_type frequency,
       const std::vector<std::pair<element_data_type, element_data_type>>&
@@ -0,0 +1,552 @@
+#include "FixedFastFourierTransform.h"
+
+#include <cstdint>
+#include <utility>
+
+#ifdef UNIT_TEST
+#include <stdexcept>  // std::invalid_argument
+#endif
+
+namespace {
+
+constexpr double FIXEDPI = 3.14159265358979323846;
+
+/**
+ * @brief Sums the Taylor series of the sine, one term per recursion as C++11
+ * constexpr functions hold a single return statement.
+ *
+ * @param x The angle in radians, within [-pi/2, pi/2].
+ * @param term The current term of the series.
+ * @param sum The sum of the previous terms.
+ * @param k The index of the current term.
+ * @return The sine of the angle.
+ */
+constexpr double taylorSine(double x, double term, double sum, unsigned int k) {
+  return k == 24 ? sum
+                 : taylorSine(x, -term * x * x / ((2 * k + 2) * (2 * k + 3)),
+                              sum + term, k + 1);
+}
+
+/**
+ * @brief Computes the sine of an angle at compile time.
+ *
+ * @param x The angle in radians, within [-pi/2, pi].
+ * @return The sine of the angle.
+ */
+constexpr double fixedSine(double x) {
+  return x > FIXEDPI / 2 ? taylorSine(FIXEDPI - x, FIXEDPI - x, 0, 0)
+                         : taylorSine(x, x, 0, 0);
+}
+
+/**
+ * @brief Computes the cosine of an angle at compile time.
+ *
+ * @param x The angle in radians, within [0, pi].
+ * @return The cosine of the angle.
+ */
+constexpr double fixedCosine(double x) { return fixedSine(FIXEDPI / 2 - x); }
+
+/**
+ * @brief Reverses the lowest bits of an index at compile time.
+ *
+ * @param value The index.
+ * @param bitCount The number of bits to reverse.
+ * @return The reversed index.
+ */
+constexpr std::size_t reverseBits(std::size_t value, unsigned int bitCount) {
+  return bitCount == 0 ? 0
+                       : ((value & 1u) << (bitCount - 1)) |
+                             reverseBits(value >> 1, bitCount - 1);
+}
+
+/**
+ * @brief Computes the base 2 logarithm of a power of two at compile time.
+ *
+ * @param n The power of two.
+ * @return The logarithm.
+ */
+constexpr unsigned int fixedLogBase2(std::size_t n) {
+  return n <= 1 ? 0 : 1 + fixedLogBase2(n >> 1);
+}
+
+/**
+ * @brief Pack of the indices of a table, std::index_sequence is C++14.
+ */
+template <std::size_t... indices>
+struct FixedIndexSequence {};
+
+template <std::size_t count, std::size_t... indices>
+struct MakeFixedIndexSequence
+    : MakeFixedIndexSequence<count - 1, count - 1, indices...> {};
+
+template <std::size_t... indices>
+struct MakeFixedIndexSequence<0, indices...> {
+  typedef FixedIndexSequence<indices...> type;
+};
+
+/**
+ * @brief The first `transformSize / 2` twiddles `e^(-2 pi i k / n)`, split in
+ * real and imaginary arrays.
+ */
+template <typename element_datatype, std::size_t transformSize,
+          typename sequence>
+struct FixedTwiddleTable;
+
+template <typename element_datatype, std::size_t transformSize,
+          std::size_t... k>
+struct FixedTwiddleTable<element_datatype, transformSize,
+                         FixedIndexSequence<k...>> {
+  static constexpr element_datatype real[sizeof...(k)] = {
+      static_cast<element_datatype>(
+          fixedCosine(2 * FIXEDPI * k / transformSize))...};
+  static constexpr element_datatype imaginary[sizeof...(k)] = {
+      static_cast<element_datatype>(
+          -fixedSine(2 * FIXEDPI * k / transformSize))...};
+};
+
+template <typename element_datatype, std::size_t transformSize,
+          std::size_t... k>
+constexpr element_datatype FixedTwiddleTable<
+    element_datatype, transformSize, FixedIndexSequence<k...>>::real[];
+
+template <typename element_datatype, std::size_t transformSize,
+          std::size_t... k>
+constexpr element_datatype FixedTwiddleTable<
+    element_datatype, transformSize, FixedIndexSequence<k...>>::imaginary[];
+
+/**
+ * @brief The bit-reversal permutation of `transformSize` indices.
+ */
+template <std::size_t transformSize, typename sequence>
+struct FixedBitReversalTable;
+
+template <std::size_t transformSize, std::size_t... i>
+struct FixedBitReversalTable<transformSize, FixedIndexSequence<i...>> {
+  static constexpr std::uint16_t reversed[sizeof...(i)] = {
+      static_cast<std::uint16_t>(
+          reverseBits(i, fixedLogBase2(transformSize)))...};
+};
+
+template <std::size_t transformSize, std::size_t... i>
+constexpr std::uint16_t FixedBitReversalTable<
+    transformSize, FixedIndexSequence<i...>>::reversed[];
+
+/**
+ * @brief Runs the radix-2 stage of a given span, then the next one, until
+ * the span reaches the size of the transform.
+ *
+ * @tparam transformSize The size of the twiddle table.
+ * @tparam size The size of the transform, `transformSize` or half of it.
+ * @tparam span The distance between the two points of a butterfly.
+ */
+template <typename element_datatype, std::size_t transformSize,
+          std::size_t size, std::size_t span>
+struct FixedStages {
+  static void run(std::complex<element_datatype>* data) {
+    typedef FixedTwiddleTable<
+        element_datatype, transformSize,
+        typename MakeFixedIndexSequence<transformSize / 2>::type>
+        twiddles;
+    const std::size_t twiddleStride = transformSize / (2 * span);
+
+    for (std::size_t group = 0; group < size; group += 2 * span) {
+      std::complex<element_datatype>* x = data + group;
+      for (std::size_t j = 0; j < span; ++j) {
+        const std::size_t k = j * twiddleStride;
+        std::complex<element_datatype> w(twiddles::real[k],
+                                         twiddles::imaginary[k]);
+        std::complex<element_datatype> t = w * x[j + span];
+        std::complex<element_datatype> u = x[j];
+        x[j] = u + t;
+        x[j + span] = u - t;
+      }
+    }
+    FixedStages<element_datatype, transformSize, size, 2 * span>::run(data);
+  }
+};
+
+template <typename element_datatype, std::size_t transformSize,
+          std::size_t size>
+struct FixedStages<element_datatype, transformSize, size, size> {
+  static void run(std::complex<element_datatype>* /*data*/) {}
+};
+
+}  // namespace
+
+/**
+ * @brief Computes the FFT of `size` elements in place, `size` being
+ * `transformSize` or half of it.
+ * @tparam size The size of the transform.
+ * @param data The interleaved complex data.
+ *
+ * The reversal of `i` on `log2(size)` bits is its reversal on
+ * `log2(transformSize)` bits shifted right, so one table serves both sizes.
+ */
+template <typename element_datatype, std::size_t transformSize>
+template <std::size_t size>
+void FixedFastFourierTransform<element_datatype, transformSize>::transform(
+    std::complex<element_datatype>* data) {
+  typedef FixedBitReversalTable<
+      transformSize, typename MakeFixedIndexSequence<transformSize>::type>
+      bitReversal;
+  const unsigned int shift =
+      fixedLogBase2(transformSize) - fixedLogBase2(size);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    std::size_t reversed = bitReversal::reversed[i] >> shift;
+    if (i < reversed) {
+      std::swap(data[i], data[reversed]);
+    }
+  }
+  FixedStages<element_datatype, transformSize, size, 1>::run(data);
+};
+
+/**
+ * @brief Computes the inverse FFT of `size` elements in place, scaled by
+ * `1 / size`.
+ * @tparam size The size of the transform.
+ * @param data The interleaved complex data.
+ */
+template <typename element_datatype, std::size_t transformSize>
+template <std::size_t size>
+void FixedFastFourierTransform<element_datatype,
+                               transformSize>::inverseTransform(
+    std::complex<element_datatype>* data) {
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = std::conj(data[i]);
+  }
+  transform<size>(data);
+  const element_datatype scale = static_cast<element_datatype>(1) / size;
+  for (std::size_t i = 0; i < size; ++i) {
+    data[i] = std::conj(data[i]) * scale;
+  }
+};
+
+/**
+ * @brief Checks the size requested from an in-place transform.
+ * @param log2n The base 2 logarithm of the requested size.
+ *
+ * If it is not the fixed size, it throws an std::invalid_argument exception in
+ * the unit test build.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::checkLogBase2(
+    unsigned int log2n) {
+#ifdef UNIT_TEST
+  if (log2n != fixedLogBase2(transformSize)) {
+    throw std::invalid_argument("log2n does not match the fixed size");
+  }
+#else
+  (void)log2n;
+#endif
+};
+
+/**
+ * @brief Checks the size requested from an exact size transform.
+ * @param size The requested size.
+ *
+ * If it is not the fixed size, it throws an std::invalid_argument exception in
+ * the unit test build.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::checkSize(
+    std::size_t size) {
+#ifdef UNIT_TEST
+  if (size != transformSize) {
+    throw std::invalid_argument("size does not match the fixed size");
+  }
+#else
+  (void)size;
+#endif
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place.
+ * @param data The interleaved complex data, `transformSize` elements.
+ * @param log2n The base 2 logarithm of `transformSize`.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::
+    fastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                unsigned int log2n) {
+  checkLogBase2(log2n);
+  transform<transformSize>(data);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place,
+ * scaled by `1 / transformSize`.
+ * @param data The interleaved complex data, `transformSize` elements.
+ * @param log2n The base 2 logarithm of `transformSize`.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::
+    inverseFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                       unsigned int log2n) {
+  checkLogBase2(log2n);
+  inverseTransform<transformSize>(data);
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place.
+ * @param data The interleaved complex data, `transformSize` elements.
+ * @param size The transform size, `transformSize`.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::
+    exactSizeFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                         std::size_t size) {
+  checkSize(size);
+  transform<transformSize>(data);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place,
+ * scaled by `1 / transformSize`.
+ * @param data The interleaved complex data, `transformSize` elements.
+ * @param size The transform size, `transformSize`.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::
+    inverseExactSizeFastFourierTransformInPlace(
+        std::complex<element_datatype>* data, std::size_t size) {
+  checkSize(size);
+  inverseTransform<transformSize>(data);
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place on real data.
+ * @param data A buffer of `transformSize / 2 + 1` complex elements, holding the
+ * real samples as scalars on entry and the bins on exit.
+ * @param log2n The base 2 logarithm of `transformSize`.
+ *
+ * The packed samples go through a `transformSize / 2` point transform, whose
+ * spectrum is split into the even and odd sample spectra and combined with the
+ * full size twiddles, as in `FastFourierTransform`.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::
+    realFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                    unsigned int log2n) {
+  typedef FixedTwiddleTable<
+      element_datatype, transformSize,
+      typename MakeFixedIndexSequence<transformSize / 2>::type>
+      twiddles;
+  const std::size_t halfSize = transformSize / 2;
+  checkLogBase2(log2n);
+  transform<halfSize>(data);
+
+  const element_datatype half = static_cast<element_datatype>(0.5);
+  element_datatype z0Real = data[0].real();
+  element_datatype z0Imaginary = data[0].imag();
+  data[0] = std::complex<element_datatype>(z0Real + z0Imaginary, 0);
+  data[halfSize] = std::complex<element_datatype>(z0Real - z0Imaginary, 0);
+  for (std::size_t k = 1; k <= halfSize - k; ++k) {
+    std::complex<element_datatype> z = data[k];
+    std::complex<element_datatype> mirrored = std::conj(data[halfSize - k]);
+    std::complex<element_datatype> even = (z + mirrored) * half;
+    std::complex<element_datatype> odd =
+        (z - mirrored) * std::complex<element_datatype>(0, -half);
+    std::complex<element_datatype> rotatedOdd =
+        std::complex<element_datatype>(twiddles::real[k],
+                                       twiddles::imaginary[k]) *
+        odd;
+    data[k] = even + rotatedOdd;
+    data[halfSize - k] = std::conj(even - rotatedOdd);
+  }
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place on the
+ * non-negative frequency half of a Hermitian spectrum.
+ * @param data A buffer of `transformSize / 2 + 1` complex elements, holding the
+ * bins on entry and the real samples as scalars on exit.
+ * @param log2n The base 2 logarithm of `transformSize`.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::
+    inverseRealFastFourierTransformInPlace(
+        std::complex<element_datatype>* data, unsigned int log2n) {
+  typedef FixedTwiddleTable<
+      element_datatype, transformSize,
+      typename MakeFixedIndexSequence<transformSize / 2>::type>
+      twiddles;
+  const std::size_t halfSize = transformSize / 2;
+  checkLogBase2(log2n);
+
+  const element_datatype half = static_cast<element_datatype>(0.5);
+  const std::complex<element_datatype> J(0, 1);
+  element_datatype x0 = data[0].real();
+  element_datatype xHalf = data[halfSize].real();
+  data[0] = std::complex<element_datatype>((x0 + xHalf) * half,
+                                           (x0 - xHalf) * half);
+  for (std::size_t k = 1; k <= halfSize - k; ++k) {
+    std::complex<element_datatype> bin = data[k];
+    std::complex<element_datatype> mirrored = std::conj(data[halfSize - k]);
+    std::complex<element_datatype> even = (bin + mirrored) * half;
+    std::complex<element_datatype> odd =
+        (bin - mirrored) *
+        std::complex<element_datatype>(twiddles::real[k],
+                                       -twiddles::imaginary[k]) *
+        half;
+    data[k] = even + J * odd;
+    data[halfSize - k] = std::conj(even) + J * std::conj(odd);
+  }
+
+  inverseTransform<halfSize>(data);
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation on the input data and
+ * returns `transformSize` elements.
+ * @param realInput The input data vector for real part.
+ * @param imaginaryInput The input data vector for imaginary part.
+ * @param realOutput The output data vector for real part.
+ * @param imaginaryOutput The output data vector for imaginary part.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::
+    fastFourierTransform(const std::vector<element_datatype>* realInput,
+                         const std::vector<element_datatype>* imaginaryInput,
+                         std::vector<element_datatype>* realOutput,
+                         std::vector<element_datatype>* imaginaryOutput) {
+#ifdef UNIT_TEST
+  if (!realInput || !imaginaryInput || !realOutput || !imaginaryOutput) {
+    throw std::invalid_argument("Input and output vectors cannot be null");
+  }
+  if (realInput->size() != imaginaryInput->size() ||
+      realInput->size() > transformSize) {
+    throw std::invalid_argument(
+        "Input vectors must have the same size, at most the fixed size");
+  }
+#endif
+
+  for (std::size_t i = 0; i < transformSize; ++i) {
+    workspace[i] = i < realInput->size()
+                       ? std::complex<element_datatype>((*realInput)[i],
+                                                        (*imaginaryInput)[i])
+                       : std::complex<element_datatype>(0, 0);
+  }
+  transform<transformSize>(workspace);
+
+  realOutput->resize(transformSize);
+  imaginaryOutput->resize(transformSize);
+  for (std::size_t i = 0; i < transformSize; ++i) {
+    (*realOutput)[i] = workspace[i].real();
+    (*imaginaryOutput)[i] = workspace[i].imag();
+  }
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation on the input
+ * data and returns `transformSize` elements.
+ * @param realInput The input data vector for real part.
+ * @param imaginaryInput The input data vector for imaginary part.
+ * @param realOutput The output data vector for real part.
+ * @param imaginaryOutput The output data vector for imaginary part.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::
+    inverseFastFourierTransform(
+        const std::vector<element_datatype>* realInput,
+        const std::vector<element_datatype>* imaginaryInput,
+        std::vector<element_datatype>* realOutput,
+        std::vector<element_datatype>* imaginaryOutput) {
+#ifdef UNIT_TEST
+  if (!realInput || !imaginaryInput || !realOutput || !imaginaryOutput) {
+    throw std::invalid_argument("Input and output vectors cannot be null");
+  }
+  if (realInput->size() != imaginaryInput->size() ||
+      realInput->size() > transformSize) {
+    throw std::invalid_argument(
+        "Input vectors must have the same size, at most the fixed size");
+  }
+#endif
+
+  for (std::size_t i = 0; i < transformSize; ++i) {
+    workspace[i] = i < realInput->size()
+                       ? std::complex<element_datatype>((*realInput)[i],
+                                                        (*imaginaryInput)[i])
+                       : std::complex<element_datatype>(0, 0);
+  }
+  inverseTransform<transformSize>(workspace);
+
+  realOutput->resize(transformSize);
+  imaginaryOutput->resize(transformSize);
+  for (std::size_t i = 0; i < transformSize; ++i) {
+    (*realOutput)[i] = workspace[i].real();
+    (*imaginaryOutput)[i] = workspace[i].imag();
+  }
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation on real input data and
+ * returns the `transformSize / 2 + 1` non-negative frequency bins.
+ * @param realInput The input data vector.
+ * @param realOutput The output data vector for real part.
+ * @param imaginaryOutput The output data vector for imaginary part.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::
+    realFastFourierTransform(const std::vector<element_datatype>* realInput,
+                             std::vector<element_datatype>* realOutput,
+                             std::vector<element_datatype>* imaginaryOutput) {
+#ifdef UNIT_TEST
+  if (!realInput || !realOutput || !imaginaryOutput) {
+    throw std::invalid_argument("Input and output vectors cannot be null");
+  }
+  if (realInput->size() > transformSize) {
+    throw std::invalid_argument("Input vector is longer than the fixed size");
+  }
+#endif
+
+  const std::size_t binCount = transformSize / 2 + 1;
+  element_datatype* samples = reinterpret_cast<element_datatype*>(workspace);
+  for (std::size_t i = 0; i < 2 * binCount; ++i) {
+    samples[i] = i < realInput->size() ? (*realInput)[i] : 0;
+  }
+  realFastFourierTransformInPlace(workspace, fixedLogBase2(transformSize));
+
+  realOutput->resize(binCount);
+  imaginaryOutput->resize(binCount);
+  for (std::size_t k = 0; k < binCount; ++k) {
+    (*realOutput)[k] = workspace[k].real();
+    (*imaginaryOutput)[k] = workspace[k].imag();
+  }
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation on the
+ * `transformSize / 2 + 1` non-negative frequency bins of a real signal.
+ * @param realInput The input data vector for real part.
+ * @param imaginaryInput The input data vector for imaginary part.
+ * @param realOutput The output data vector, `transformSize` elements.
+ */
+template <typename element_datatype, std::size_t transformSize>
+void FixedFastFourierTransform<element_datatype, transformSize>::
+    inverseRealFastFourierTransform(
+        const std::vector<element_datatype>* realInput,
+        const std::vector<element_datatype>* imaginaryInput,
+        std::vector<element_datatype>* realOutput) {
+  const std::size_t binCount = transformSize / 2 + 1;
+#ifdef UNIT_TEST
+  if (!realInput || !imaginaryInput || !realOutput) {
+    throw std::invalid_argument("Input and output vectors cannot be null");
+  }
+  if (realInput->size() != binCount || imaginaryInput->size() != binCount) {
+    throw std::invalid_argument(
+        "Input vectors must hold half the fixed size plus one bins");
+  }
+#endif
+
+  for (std::size_t k = 0; k < binCount; ++k) {
+    workspace[k] =
+        std::complex<element_datatype>((*realInput)[k], (*imaginaryInput)[k]);
+  }
+  inverseRealFastFourierTransformInPlace(workspace,
+                                         fixedLogBase2(transformSize));
+
+  const element_datatype* samples =
+      reinterpret_cast<const element_datatype*>(workspace);
+  realOutput->assign(samples, samples + transformSize);
+};
@@ -0,0 +1,185 @@
+#ifndef FIXED_FAST_FOURIER_TRANSFORM_H
+#define FIXED_FAST_FOURIER_TRANSFORM_H
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+#include "signal_filter/FastFourierTransformInterface.h"
+
+/**
+ * @brief Fast Fourier Transform of a size fixed at build time.
+ *
+ * The twiddle factors and the bit-reversal permutation are constexpr tables,
+ * computed by the compiler and placed in read-only memory, so on the SAM3X
+ * they live in flash and nothing is set up at run time. The radix-2 stages are
+ * unrolled through templates, so every loop bound and twiddle stride is a
+ * compile-time constant.
+ *
+ * Vector inputs shorter than `transformSize` are zero-padded to it, and the
+ * in-place transforms only accept `log2n == log2(transformSize)` or
+ * `size == transformSize`.
+ *
+ * @tparam element_datatype The data type of the elements in the input and
+ * output vectors.
+ * @tparam transformSize The transform size, a power of two of at least 2.
+ */
+template <typename element_datatype, std::size_t transformSize>
+class FixedFastFourierTransform
+    : public FastFourierTransformInterface<element_datatype> {
+  static_assert(transformSize >= 2 &&
+                    (transformSize & (transformSize - 1)) == 0,
+                "FixedFastFourierTransform size must be a power of two");
+
+ public:
+  /**
+   * @brief Performs the Fast Fourier Transform operation on the input data and
+   * returns `transformSize` elements.
+   * @param realInput The input data vector for real part.
+   * @param imaginaryInput The input data vector for imaginary part.
+   * @param realOutput The output data vector for real part.
+   * @param imaginaryOutput The output data vector for imaginary part.
+   */
+  void fastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation on the input
+   * data and returns `transformSize` elements.
+   * @param realInput The input data vector for real part.
+   * @param imaginaryInput The input data vector for imaginary part.
+   * @param realOutput The output data vector for real part.
+   * @param imaginaryOutput The output data vector for imaginary part.
+   */
+  void inverseFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation on real input data
+   * and returns the `transformSize / 2 + 1` non-negative frequency bins.
+   * @param realInput The input data vector.
+   * @param realOutput The output data vector for real part.
+   * @param imaginaryOutput The output data vector for imaginary part.
+   */
+  void realFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation on the
+   * `transformSize / 2 + 1` non-negative frequency bins of a real signal.
+   * @param realInput The input data vector for real part.
+   * @param imaginaryInput The input data vector for imaginary part.
+   * @param realOutput The output data vector, `transformSize` elements.
+   */
+  void inverseRealFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place.
+   * @param data The interleaved complex data, `transformSize` elements.
+   * @param log2n The base 2 logarithm of `transformSize`.
+   */
+  void fastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                   unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place,
+   * scaled by `1 / transformSize`.
+   * @param data The interleaved complex data, `transformSize` elements.
+   * @param log2n The base 2 logarithm of `transformSize`.
+   */
+  void inverseFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                          unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place.
+   * @param data The interleaved complex data, `transformSize` elements.
+   * @param size The transform size, `transformSize`.
+   */
+  void exactSizeFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, std::size_t size) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place,
+   * scaled by `1 / transformSize`.
+   * @param data The interleaved complex data, `transformSize` elements.
+   * @param size The transform size, `transformSize`.
+   */
+  void inverseExactSizeFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, std::size_t size) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place on real
+   * data.
+   * @param data A buffer of `transformSize / 2 + 1` complex elements, holding
+   * the real samples as scalars on entry and the bins on exit.
+   * @param log2n The base 2 logarithm of `transformSize`.
+   */
+  void realFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                       unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place on
+   * the non-negative frequency half of a Hermitian spectrum.
+   * @param data A buffer of `transformSize / 2 + 1` complex elements, holding
+   * the bins on entry and the real samples as scalars on exit.
+   * @param log2n The base 2 logarithm of `transformSize`.
+   */
+  void inverseRealFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, unsigned int log2n) override;
+
+ private:
+  /**
+   * @brief Computes the FFT of `size` elements in place, `size` being
+   * `transformSize` or half of it.
+   * @tparam size The size of the transform.
+   * @param data The interleaved complex data.
+   */
+  template <std::size_t size>
+  void transform(std::complex<element_datatype>* data);
+
+  /**
+   * @brief Computes the inverse FFT of `size` elements in place, scaled by
+   * `1 / size`.
+   * @tparam size The size of the transform.
+   * @param data The interleaved complex data.
+   */
+  template <std::size_t size>
+  void inverseTransform(std::complex<element_datatype>* data);
+
+  /**
+   * @brief Checks the size requested from an in-place transform.
+   * @param log2n The base 2 logarithm of the requested size.
+   *
+   * If it is not the fixed size, it throws an std::invalid_argument exception
+   * in the unit test build.
+   */
+  void checkLogBase2(unsigned int log2n);
+
+  /**
+   * @brief Checks the size requested from an exact size transform.
+   * @param size The requested size.
+   *
+   * If it is not the fixed size, it throws an std::invalid_argument exception
+   * in the unit test build.
+   */
+  void checkSize(std::size_t size);
+
+  std::complex<element_datatype> workspace[transformSize];  // Vector API
+};
+
+template class FixedFastFourierTransform<float, 64>;
+// Transform size of the PPG histories allocated by `EventController`.
+template class FixedFastFourierTransform<double, 64>;
+
+#endif
@@ -0,0 +1,736 @@
+#include "FixedPointFastFourierTransform.h"
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#ifdef UNIT_TEST
+#include <stdexcept>  // std::invalid_argument
+#endif
+
+namespace {
+
+/**
+ * @brief Arithmetic of a fixed-point format.
+ * @tparam fixed_datatype The storage type of the fractions.
+ */
+template <typename fixed_datatype>
+struct FixedPointFormat;
+
+template <>
+struct FixedPointFormat<int16_t> {
+  typedef int32_t product_datatype;  // Holds a product of two fractions
+  static const unsigned int FRACTIONBITS = 15;
+};
+
+template <>
+struct FixedPointFormat<int32_t> {
+  typedef int64_t product_datatype;  // Holds a product of two fractions
+  static const unsigned int FRACTIONBITS = 31;
+};
+
+/**
+ * @brief Narrows a wide intermediate result, clipping it to the range of the
+ * format.
+ * @param value The wide value.
+ * @return The closest fraction.
+ */
+template <typename fixed_datatype>
+inline fixed_datatype saturate(
+    typename FixedPointFormat<fixed_datatype>::product_datatype value) {
+  if (value > std::numeric_limits<fixed_datatype>::max()) {
+    return std::numeric_limits<fixed_datatype>::max();
+  }
+  if (value < std::numeric_limits<fixed_datatype>::min()) {
+    return std::numeric_limits<fixed_datatype>::min();
+  }
+  return static_cast<fixed_datatype>(value);
+};
+
+/**
+ * @brief Rounds a real number to the nearest integer of the format,
+ * saturating.
+ * @param value The real number, already scaled to the integer range.
+ * @return The integer.
+ */
+template <typename fixed_datatype, typename real_datatype>
+inline fixed_datatype roundToFixed(real_datatype value) {
+  typedef typename FixedPointFormat<fixed_datatype>::product_datatype
+      product_datatype;
+  const real_datatype half = static_cast<real_datatype>(0.5);
+  return saturate<fixed_datatype>(
+      static_cast<product_datatype>(value < 0 ? value - half : value + half));
+};
+
+/**
+ * @brief Divides a value by `2 ^ shift`, rounding to nearest.
+ * @param value The value.
+ * @param shift The number of bits to shift right.
+ * @return The shifted value.
+ */
+template <typename product_datatype>
+inline product_datatype shiftRound(product_datatype value, unsigned int shift) {
+  if (shift == 0) return value;
+  return (value + (static_cast<product_datatype>(1) << (shift - 1))) >> shift;
+};
+
+/**
+ * @brief Brings a sum of products of two fractions back to the scale of one
+ * fraction, rounding to nearest.
+ * @param value The sum of products.
+ * @return The fraction, still held in the wide type.
+ */
+template <typename fixed_datatype>
+inline typename FixedPointFormat<fixed_datatype>::product_datatype
+roundFraction(
+    typename FixedPointFormat<fixed_datatype>::product_datatype value) {
+  return shiftRound(value, FixedPointFormat<fixed_datatype>::FRACTIONBITS);
+};
+
+/**
+ * @brief Computes a value whose highest set bit is the one of the magnitude of
+ * a fraction, without overflowing on the most negative one.
+ * @param value The fraction.
+ * @return `value` if it is not negative, `|value| - 1` otherwise.
+ */
+template <typename fixed_datatype>
+inline fixed_datatype magnitudeBits(fixed_datatype value) {
+  return value < 0 ? static_cast<fixed_datatype>(~value) : value;
+};
+
+}  // namespace
+
+/**
+ * @brief Retrieves the plan of a transform size, building it on first use.
+ * @param log2n The base 2 logarithm of the transform size.
+ * @return The cached plan.
+ */
+template <typename element_datatype, typename fixed_datatype>
+const typename FixedPointFastFourierTransform<
+    element_datatype, fixed_datatype>::fixed_point_fft_plan_data_type&
+FixedPointFastFourierTransform<element_datatype, fixed_datatype>::getPlan(
+    unsigned int log2n) {
+  if (plans.size() <= log2n) {
+    plans.resize(log2n + 1);
+  }
+  fixed_point_fft_plan_data_type& plan = plans[log2n];
+  if (plan.bitReversal.empty()) {
+    plan.log2n = log2n;
+    buildPlan(plan);
+  }
+  return plan;
+};
+
+/**
+ * @brief Computes the fixed-point twiddle table and bit-reversal permutation
+ * of a transform size.
+ * @param plan The plan to fill, its `log2n` must already be set.
+ *
+ * The twiddles are rounded from double precision, `cos(0) = 1` saturates to
+ * the largest fraction below 1.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    buildPlan(fixed_point_fft_plan_data_type& plan) {
+  const unsigned int n = 1u << plan.log2n;
+  const unsigned int halfN = n >> 1;
+
+  plan.bitReversal.assign(n, 0);
+  for (unsigned int i = 1; i < n; ++i) {
+    plan.bitReversal[i] = (plan.bitReversal[i >> 1] >> 1) |
+                          ((i & 1u) << (plan.log2n - 1));
+  }
+
+  const double PI = acos(-1);
+  const double one =
+      std::ldexp(1.0, FixedPointFormat<fixed_datatype>::FRACTIONBITS);
+  plan.twiddleReal.resize(halfN);
+  plan.twiddleImaginary.resize(halfN);
+  for (unsigned int k = 0; k < halfN; ++k) {
+    double angle = 2 * PI * k / n;
+    plan.twiddleReal[k] = roundToFixed<fixed_datatype>(cos(angle) * one);
+    plan.twiddleImaginary[k] = roundToFixed<fixed_datatype>(-sin(angle) * one);
+  }
+};
+
+/**
+ * @brief Converts interleaved complex values to the block, choosing the
+ * exponent that leaves two bits of headroom above the largest component.
+ * @param values The interleaved real and imaginary parts.
+ * @param count The number of complex values.
+ *
+ * With the largest magnitude `m * 2^e`, `0.5 <= m < 1`, every component maps
+ * below a quarter of the full scale and the largest one above an eighth.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    loadBlock(const element_datatype* values, unsigned int count) {
+  element_datatype peak = 0;
+  for (unsigned int i = 0; i < 2 * count; ++i) {
+    element_datatype magnitude = values[i] < 0 ? -values[i] : values[i];
+    if (magnitude > peak) {
+      peak = magnitude;
+    }
+  }
+  int peakExponent = 0;
+  std::frexp(peak, &peakExponent);
+  const int fractionBits =
+      static_cast<int>(FixedPointFormat<fixed_datatype>::FRACTIONBITS);
+  blockExponent = peakExponent + 2 - fractionBits;
+
+  const element_datatype scale =
+      std::ldexp(static_cast<element_datatype>(1), -blockExponent);
+  blockReal.resize(count);
+  blockImaginary.resize(count);
+  blockPeak = 0;
+  for (unsigned int i = 0; i < count; ++i) {
+    blockReal[i] = roundToFixed<fixed_datatype>(values[2 * i] * scale);
+    blockImaginary[i] = roundToFixed<fixed_datatype>(values[2 * i + 1] * scale);
+    blockPeak |= magnitudeBits(blockReal[i]) | magnitudeBits(blockImaginary[i]);
+  }
+};
+
+/**
+ * @brief Converts the block back to interleaved complex values.
+ * @param values The interleaved real and imaginary parts.
+ * @param count The number of complex values.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    storeBlock(element_datatype* values, unsigned int count) const {
+  const element_datatype scale =
+      std::ldexp(static_cast<element_datatype>(1), blockExponent);
+  for (unsigned int i = 0; i < count; ++i) {
+    values[2 * i] = blockReal[i] * scale;
+    values[2 * i + 1] = blockImaginary[i] * scale;
+  }
+};
+
+/**
+ * @brief Negates the imaginary parts of the block.
+ * @param count The number of complex values.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype,
+                                    fixed_datatype>::conjugateBlock(unsigned int
+                                                                        count) {
+  typedef typename FixedPointFormat<fixed_datatype>::product_datatype
+      product_datatype;
+  blockPeak = 0;
+  for (unsigned int i = 0; i < count; ++i) {
+    blockImaginary[i] = saturate<fixed_datatype>(
+        -static_cast<product_datatype>(blockImaginary[i]));
+    blockPeak |= magnitudeBits(blockReal[i]) | magnitudeBits(blockImaginary[i]);
+  }
+};
+
+/**
+ * @brief Computes the right shift that restores the headroom of the block,
+ * and adds it to the block exponent.
+ * @return The shift.
+ *
+ * A radix-2 butterfly grows a component by at most `1 + sqrt(2)`, so inputs
+ * below a quarter of the full scale can never overflow.
+ */
+template <typename element_datatype, typename fixed_datatype>
+unsigned int FixedPointFastFourierTransform<
+    element_datatype, fixed_datatype>::takeHeadroomShift() {
+  const fixed_datatype limit = static_cast<fixed_datatype>(
+      1 << (FixedPointFormat<fixed_datatype>::FRACTIONBITS - 2));
+  unsigned int shift = 0;
+  while ((blockPeak >> shift) >= limit) {
+    ++shift;
+  }
+  blockExponent += static_cast<int>(shift);
+  return shift;
+};
+
+/**
+ * @brief Computes the FFT of the block in place with radix-2 butterflies,
+ * rescaling it before every stage.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * The shift of a stage is applied while its inputs are loaded and the
+ * magnitudes of its outputs are collected while they are stored, so the
+ * block scaling costs no extra pass over the data.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype,
+                                    fixed_datatype>::transformBlock(unsigned int
+                                                                        log2n) {
+  typedef typename FixedPointFormat<fixed_datatype>::product_datatype
+      product_datatype;
+  const fixed_point_fft_plan_data_type& plan = getPlan(log2n);
+  const unsigned int n = 1u << log2n;
+
+  for (unsigned int i = 0; i < n; ++i) {
+    unsigned int reversed = plan.bitReversal[i];
+    if (i < reversed) {
+      std::swap(blockReal[i], blockReal[reversed]);
+      std::swap(blockImaginary[i], blockImaginary[reversed]);
+    }
+  }
+
+  for (unsigned int span = 1; span < n; span <<= 1) {
+    const unsigned int shift = takeHeadroomShift();
+    const unsigned int twiddleStride = n / (2 * span);
+    fixed_datatype peak = 0;
+    for (unsigned int group = 0; group < n; group += 2 * span) {
+      for (unsigned int j = 0; j < span; ++j) {
+        const product_datatype wReal = plan.twiddleReal[j * twiddleStride];
+        const product_datatype wImaginary =
+            plan.twiddleImaginary[j * twiddleStride];
+        const unsigned int top = group + j;
+        const unsigned int bottom = top + span;
+
+        product_datatype uReal = shiftRound<product_datatype>(blockReal[top],
+                                                              shift);
+        product_datatype uImaginary =
+            shiftRound<product_datatype>(blockImaginary[top], shift);
+        product_datatype vReal =
+            shiftRound<product_datatype>(blockReal[bottom], shift);
+        product_datatype vImaginary =
+            shiftRound<product_datatype>(blockImaginary[bottom], shift);
+        product_datatype tReal = roundFraction<fixed_datatype>(
+            vReal * wReal - vImaginary * wImaginary);
+        product_datatype tImaginary = roundFraction<fixed_datatype>(
+            vReal * wImaginary + vImaginary * wReal);
+
+        blockReal[top] = saturate<fixed_datatype>(uReal + tReal);
+        blockImaginary[top] = saturate<fixed_datatype>(uImaginary + tImaginary);
+        blockReal[bottom] = saturate<fixed_datatype>(uReal - tReal);
+        blockImaginary[bottom] =
+            saturate<fixed_datatype>(uImaginary - tImaginary);
+        peak |= magnitudeBits(blockReal[top]) |
+                magnitudeBits(blockImaginary[top]) |
+                magnitudeBits(blockReal[bottom]) |
+                magnitudeBits(blockImaginary[bottom]);
+      }
+    }
+    blockPeak = peak;
+  }
+};
+
+/**
+ * @brief Computes the inverse FFT of the block in place, scaled by `1 / n`.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * The inverse is the conjugate of the forward transform of the conjugate, and
+ * the scaling only lowers the block exponent.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<
+    element_datatype, fixed_datatype>::inverseTransformBlock(unsigned int
+                                                                 log2n) {
+  const unsigned int n = 1u << log2n;
+  conjugateBlock(n);
+  transformBlock(log2n);
+  conjugateBlock(n);
+  blockExponent -= static_cast<int>(log2n);
+};
+
+/**
+ * @brief Computes the smallest power of two holding a number of samples.
+ * @param sampleCount The number of samples.
+ * @return The base 2 logarithm of that power of two.
+ */
+template <typename element_datatype, typename fixed_datatype>
+unsigned int
+FixedPointFastFourierTransform<element_datatype, fixed_datatype>::ceilLog2(
+    std::size_t sampleCount) {
+  unsigned int log2n = 0;
+  while ((static_cast<std::size_t>(1) << log2n) < sampleCount) {
+    ++log2n;
+  }
+  return log2n;
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place.
+ * @param data The interleaved complex data, `2 ^ log2n` elements.
+ * @param log2n The base 2 logarithm of the transform size.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    fastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                unsigned int log2n) {
+  const unsigned int n = 1u << log2n;
+  loadBlock(reinterpret_cast<const element_datatype*>(data), n);
+  transformBlock(log2n);
+  storeBlock(reinterpret_cast<element_datatype*>(data), n);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place,
+ * scaled by `1 / n`.
+ * @param data The interleaved complex data, `2 ^ log2n` elements.
+ * @param log2n The base 2 logarithm of the transform size.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    inverseFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                       unsigned int log2n) {
+  const unsigned int n = 1u << log2n;
+  loadBlock(reinterpret_cast<const element_datatype*>(data), n);
+  inverseTransformBlock(log2n);
+  storeBlock(reinterpret_cast<element_datatype*>(data), n);
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place on a power of
+ * two number of elements.
+ * @param data The interleaved complex data, `size` elements.
+ * @param size The transform size, a power of two.
+ *
+ * Other sizes throw an std::invalid_argument exception in the unit test build.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    exactSizeFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                         std::size_t size) {
+#ifdef UNIT_TEST
+  if ((size & (size - 1)) != 0) {
+    throw std::invalid_argument("size must be a power of two");
+  }
+#endif
+  fastFourierTransformInPlace(data, ceilLog2(size));
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place on a
+ * power of two number of elements, scaled by `1 / size`.
+ * @param data The interleaved complex data, `size` elements.
+ * @param size The transform size, a power of two.
+ *
+ * Other sizes throw an std::invalid_argument exception in the unit test build.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    inverseExactSizeFastFourierTransformInPlace(
+        std::complex<element_datatype>* data, std::size_t size) {
+#ifdef UNIT_TEST
+  if ((size & (size - 1)) != 0) {
+    throw std::invalid_argument("size must be a power of two");
+  }
+#endif
+  inverseFastFourierTransformInPlace(data, ceilLog2(size));
+};
+
+/**
+ * @brief Performs the Fast Fourier Transform operation in place on real data.
+ * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding the
+ * real samples as scalars on entry and the bins on exit.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * Same packing as `FastFourierTransform`: the `n / 2` point FFT of
+ * `z[m] = x[2m] + i x[2m + 1]` is split into the spectrum with
+ * `X[k] = E[k] + W^k O[k]` and `X[n/2 - k] = conj(E[k] - W^k O[k])`. The
+ * split runs on the block too, after one more headroom shift.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    realFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                    unsigned int log2n) {
+  typedef typename FixedPointFormat<fixed_datatype>::product_datatype
+      product_datatype;
+  if (log2n == 0) {
+    data[0] = std::complex<element_datatype>(data[0].real(), 0);
+    return;
+  }
+
+  const unsigned int halfSize = 1u << (log2n - 1);
+  loadBlock(reinterpret_cast<const element_datatype*>(data), halfSize);
+  transformBlock(log2n - 1);
+
+  // The twiddles of the full size transform combine the two half spectra.
+  const fixed_point_fft_plan_data_type& plan = getPlan(log2n);
+  const unsigned int shift = takeHeadroomShift();
+  blockReal.resize(halfSize + 1);
+  blockImaginary.resize(halfSize + 1);
+  product_datatype z0Real = shiftRound<product_datatype>(blockReal[0], shift);
+  product_datatype z0Imaginary =
+      shiftRound<product_datatype>(blockImaginary[0], shift);
+  blockReal[0] = saturate<fixed_datatype>(z0Real + z0Imaginary);
+  blockImaginary[0] = 0;
+  blockReal[halfSize] = saturate<fixed_datatype>(z0Real - z0Imaginary);
+  blockImaginary[halfSize] = 0;
+  for (unsigned int k = 1; k <= halfSize - k; ++k) {
+    product_datatype zReal = shiftRound<product_datatype>(blockReal[k], shift);
+    product_datatype zImaginary =
+        shiftRound<product_datatype>(blockImaginary[k], shift);
+    product_datatype mirroredReal =
+        shiftRound<product_datatype>(blockReal[halfSize - k], shift);
+    product_datatype mirroredImaginary =
+        -shiftRound<product_datatype>(blockImaginary[halfSize - k], shift);
+    // E = (z + mirrored) / 2 and O = (z - mirrored) / 2i
+    product_datatype evenReal = shiftRound(zReal + mirroredReal, 1);
+    product_datatype evenImaginary =
+        shiftRound(zImaginary + mirroredImaginary, 1);
+    product_datatype oddReal = shiftRound(zImaginary - mirroredImaginary, 1);
+    product_datatype oddImaginary = shiftRound(mirroredReal - zReal, 1);
+    const product_datatype wReal = plan.twiddleReal[k];
+    const product_datatype wImaginary = plan.twiddleImaginary[k];
+    product_datatype rotatedReal = roundFraction<fixed_datatype>(
+        oddReal * wReal - oddImaginary * wImaginary);
+    product_datatype rotatedImaginary = roundFraction<fixed_datatype>(
+        oddReal * wImaginary + oddImaginary * wReal);
+
+    blockReal[k] = saturate<fixed_datatype>(evenReal + rotatedReal);
+    blockImaginary[k] =
+        saturate<fixed_datatype>(evenImaginary + rotatedImaginary);
+    blockReal[halfSize - k] = saturate<fixed_datatype>(evenReal - rotatedReal);
+    blockImaginary[halfSize - k] =
+        saturate<fixed_datatype>(rotatedImaginary - evenImaginary);
+  }
+  storeBlock(reinterpret_cast<element_datatype*>(data), halfSize + 1);
+};
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation in place on the
+ * non-negative frequency half of a Hermitian spectrum.
+ * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding the
+ * bins on entry and the real samples as scalars on exit.
+ * @param log2n The base 2 logarithm of the transform size.
+ *
+ * Same merge as `FastFourierTransform`: `Z[k] = E[k] + i O[k]` and
+ * `Z[n/2 - k] = conj(E[k]) + i conj(O[k])`, computed on the block before its
+ * `n / 2` point inverse.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    inverseRealFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                           unsigned int log2n) {
+  typedef typename FixedPointFormat<fixed_datatype>::product_datatype
+      product_datatype;
+  if (log2n == 0) {
+    data[0] = std::complex<element_datatype>(data[0].real(), 0);
+    return;
+  }
+
+  const unsigned int halfSize = 1u << (log2n - 1);
+  loadBlock(reinterpret_cast<const element_datatype*>(data), halfSize + 1);
+
+  const fixed_point_fft_plan_data_type& plan = getPlan(log2n);
+  const unsigned int shift = takeHeadroomShift();
+  product_datatype x0 = shiftRound<product_datatype>(blockReal[0], shift);
+  product_datatype xHalf =
+      shiftRound<product_datatype>(blockReal[halfSize], shift);
+  blockReal[0] = saturate<fixed_datatype>(shiftRound(x0 + xHalf, 1));
+  blockImaginary[0] = saturate<fixed_datatype>(shiftRound(x0 - xHalf, 1));
+  fixed_datatype peak =
+      magnitudeBits(blockReal[0]) | magnitudeBits(blockImaginary[0]);
+  for (unsigned int k = 1; k <= halfSize - k; ++k) {
+    product_datatype binReal =
+        shiftRound<product_datatype>(blockReal[k], shift);
+    product_datatype binImaginary =
+        shiftRound<product_datatype>(blockImaginary[k], shift);
+    product_datatype mirroredReal =
+        shiftRound<product_datatype>(blockReal[halfSize - k], shift);
+    product_datatype mirroredImaginary =
+        -shiftRound<product_datatype>(blockImaginary[halfSize - k], shift);
+    // E = (bin + mirrored) / 2 and O = (bin - mirrored) conj(W^k) / 2
+    product_datatype evenReal = shiftRound(binReal + mirroredReal, 1);
+    product_datatype evenImaginary =
+        shiftRound(binImaginary + mirroredImaginary, 1);
+    product_datatype differenceReal = shiftRound(binReal - mirroredReal, 1);
+    product_datatype differenceImaginary =
+        shiftRound(binImaginary - mirroredImaginary, 1);
+    const product_datatype wReal = plan.twiddleReal[k];
+    const product_datatype wImaginary = plan.twiddleImaginary[k];
+    product_datatype oddReal = roundFraction<fixed_datatype>(
+        differenceReal * wReal + differenceImaginary * wImaginary);
+    product_datatype oddImaginary = roundFraction<fixed_datatype>(
+        differenceImaginary * wReal - differenceReal * wImaginary);
+
+    blockReal[k] = saturate<fixed_datatype>(evenReal - oddImaginary);
+    blockImaginary[k] = saturate<fixed_datatype>(evenImaginary + oddReal);
+    blockReal[halfSize - k] = saturate<fixed_datatype>(evenReal + oddImaginary);
+    blockImaginary[halfSize - k] =
+        saturate<fixed_datatype>(oddReal - evenImaginary);
+    peak |= magnitudeBits(blockReal[k]) | magnitudeBits(blockImaginary[k]) |
+            magnitudeBits(blockReal[halfSize - k]) |
+            magnitudeBits(blockImaginary[halfSize - k]);
+  }
+  blockReal.resize(halfSize);
+  blockImaginary.resize(halfSize);
+  blockPeak = peak;
+  inverseTransformBlock(log2n - 1);
+  storeBlock(reinterpret_cast<element_datatype*>(data), halfSize);
+};
+
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    fastFourierTransform(
+        const std::vector<element_datatype>* realInput,
+        const std::vector<element_datatype>* imaginaryInput,
+        std::vector<element_datatype>* realOutput,
+        std::vector<element_datatype>* imaginaryOutput) {
+#ifdef UNIT_TEST
+  if (!realInput || !imaginaryInput || !realOutput || !imaginaryOutput) {
+    throw std::invalid_argument("Input and output vectors cannot be null");
+  }
+
+  if (realInput->size() != imaginaryInput->size()) {
+    throw std::invalid_argument(
+        "Real and Imaginary input vectors must have the same size");
+  }
+#endif
+
+  unsigned int fftPaddedArraySizeLogBase2 = ceilLog2(realInput->size());
+  unsigned int fftPaddedArraySize = 1u << fftPaddedArraySizeLogBase2;
+
+  workspace.assign(fftPaddedArraySize, 0);
+  for (unsigned int i = 0; i < realInput->size(); i++) {
+    workspace[i] =
+        std::complex<element_datatype>((*realInput)[i], (*imaginaryInput)[i]);
+  }
+
+  this->fastFourierTransformInPlace(workspace.data(),
+                                    fftPaddedArraySizeLogBase2);
+  // Resize realOutput and imaginaryOutput before assigning values
+  realOutput->resize(fftPaddedArraySize);
+  imaginaryOutput->resize(fftPaddedArraySize);
+
+  for (unsigned int i = 0; i < fftPaddedArraySize; i++) {
+    (*realOutput)[i] = workspace[i].real();
+    (*imaginaryOutput)[i] = workspace[i].imag();
+  }
+}
+
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    inverseFastFourierTransform(
+        const std::vector<element_datatype>* realInput,
+        const std::vector<element_datatype>* imaginaryInput,
+        std::vector<element_datatype>* realOutput,
+        std::vector<element_datatype>* imaginaryOutput) {
+#ifdef UNIT_TEST
+  if (!realInput || !imaginaryInput || !realOutput || !imaginaryOutput) {
+    throw std::invalid_argument("Input and output vectors cannot be null");
+  }
+
+  if (realInput->size() != imaginaryInput->size()) {
+    throw std::invalid_argument(
+        "Real and Imaginary input vectors must have the same size");
+  }
+#endif
+
+  unsigned int fftPaddedArraySizeLogBase2 = ceilLog2(realInput->size());
+  unsigned int fftPaddedArraySize = 1u << fftPaddedArraySizeLogBase2;
+
+  workspace.assign(fftPaddedArraySize, 0);
+  for (unsigned int i = 0; i < realInput->size(); i++) {
+    workspace[i] =
+        std::complex<element_datatype>((*realInput)[i], (*imaginaryInput)[i]);
+  }
+
+  this->inverseFastFourierTransformInPlace(workspace.data(),
+                                           fftPaddedArraySizeLogBase2);
+  // Resize realOutput and imaginaryOutput before assigning values
+  realOutput->resize(fftPaddedArraySize);
+  imaginaryOutput->resize(fftPaddedArraySize);
+
+  for (unsigned int i = 0; i < fftPaddedArraySize; i++) {
+    (*realOutput)[i] = workspace[i].real();
+    (*imaginaryOutput)[i] = workspace[i].imag();
+  }
+}
+
+/**
+ * @brief Performs the Fast Fourier Transform operation on real input data and
+ * returns the `n / 2 + 1` non-negative frequency bins, where `n` is the input
+ * size padded to a power of two.
+ * @param realInput The input data vector.
+ * @param realOutput The output data vector for real part.
+ * @param imaginaryOutput The output data vector for imaginary part.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    realFastFourierTransform(
+        const std::vector<element_datatype>* realInput,
+        std::vector<element_datatype>* realOutput,
+        std::vector<element_datatype>* imaginaryOutput) {
+#ifdef UNIT_TEST
+  if (!realInput || !realOutput || !imaginaryOutput) {
+    throw std::invalid_argument("Input and output vectors cannot be null");
+  }
+#endif
+
+  unsigned int fftPaddedArraySizeLogBase2 = ceilLog2(realInput->size());
+  unsigned int binCount = (1u << fftPaddedArraySizeLogBase2) / 2 + 1;
+
+  workspace.assign(binCount, 0);
+  element_datatype* samples =
+      reinterpret_cast<element_datatype*>(workspace.data());
+  for (unsigned int i = 0; i < realInput->size(); i++) {
+    samples[i] = (*realInput)[i];
+  }
+
+  this->realFastFourierTransformInPlace(workspace.data(),
+                                        fftPaddedArraySizeLogBase2);
+  realOutput->resize(binCount);
+  imaginaryOutput->resize(binCount);
+  for (unsigned int k = 0; k < binCount; k++) {
+    (*realOutput)[k] = workspace[k].real();
+    (*imaginaryOutput)[k] = workspace[k].imag();
+  }
+}
+
+/**
+ * @brief Performs the Inverse Fast Fourier Transform operation on the
+ * `n / 2 + 1` non-negative frequency bins of a real signal and returns the `n`
+ * real samples.
+ * @param realInput The input data vector for real part.
+ * @param imaginaryInput The input data vector for imaginary part.
+ * @param realOutput The output data vector.
+ */
+template <typename element_datatype, typename fixed_datatype>
+void FixedPointFastFourierTransform<element_datatype, fixed_datatype>::
+    inverseRealFastFourierTransform(
+        const std::vector<element_datatype>* realInput,
+        const std::vector<element_datatype>* imaginaryInput,
+        std::vector<element_datatype>* realOutput) {
+#ifdef UNIT_TEST
+  if (!realInput || !imaginaryInput || !realOutput) {
+    throw std::invalid_argument("Input and output vectors cannot be null");
+  }
+
+  if (realInput->size() != imaginaryInput->size()) {
+    throw std::invalid_argument(
+        "Real and Imaginary input vectors must have the same size");
+  }
+
+  if (realInput->empty()) {
+    throw std::invalid_argument("Input vectors cannot be empty");
+  }
+#endif
+
+  unsigned int halfSize = static_cast<unsigned int>(realInput->size()) - 1;
+  if (halfSize == 0) {
+    realOutput->assign(1, (*realInput)[0]);
+    return;
+  }
+
+  unsigned int halfSizeLogBase2 = ceilLog2(halfSize);
+#ifdef UNIT_TEST
+  if ((1u << halfSizeLogBase2) != halfSize) {
+    throw std::invalid_argument(
+        "Input vectors must hold a power of two plus one bins");
+  }
+#endif
+
+  workspace.resize(halfSize + 1);
+  for (unsigned int k = 0; k <= halfSize; k++) {
+    workspace[k] =
+        std::complex<element_datatype>((*realInput)[k], (*imaginaryInput)[k]);
+  }
+
+  this->inverseRealFastFourierTransformInPlace(workspace.data(),
+                                               halfSizeLogBase2 + 1);
+  const element_datatype* samples =
+      reinterpret_cast<const element_datatype*>(workspace.data());
+  realOutput->assign(samples, samples + 2 * halfSize);
+}
@@ -0,0 +1,234 @@
+#ifndef FIXED_POINT_FAST_FOURIER_TRANSFORM_H
+#define FIXED_POINT_FAST_FOURIER_TRANSFORM_H
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "signal_filter/FastFourierTransformInterface.h"
+
+typedef int16_t q15_data_type;  // Fraction in [-1, 1) with 15 fraction bits
+typedef int32_t q31_data_type;  // Fraction in [-1, 1) with 31 fraction bits
+
+/**
+ * @brief Fast Fourier Transform computed in fixed-point arithmetic, for
+ * targets without a floating point unit such as the SAM3X.
+ *
+ * The input is converted once to a block floating point format, fixed-point
+ * fractions sharing one exponent, and every butterfly is integer arithmetic.
+ * Before each stage the whole block is shifted right as far as needed to keep
+ * two bits of headroom, so no butterfly can overflow, and the shifts are added
+ * to the exponent. The sums are saturated on top of that, so a rounding corner
+ * case clips instead of wrapping around.
+ *
+ * The element type of the interface stays floating point, so the transform
+ * can replace `FastFourierTransform` behind `FastFourierTransformInterface`.
+ *
+ * @tparam element_datatype The data type of the elements in the input and
+ * output vectors.
+ * @tparam fixed_datatype The fixed-point format of the butterflies,
+ * `q15_data_type` or `q31_data_type`.
+ */
+template <typename element_datatype, typename fixed_datatype>
+class FixedPointFastFourierTransform
+    : public FastFourierTransformInterface<element_datatype> {
+ public:
+  /**
+   * @brief Performs the Fast Fourier Transform operation on the input data and
+   * returns the result to the address with `2 ^ realInput.length()` elements.
+   * @param realInput The input data vector for real part.
+   * @param imaginaryInput The input data vector for imaginary part.
+   * @param realOutput The output data vector for real part.
+   * @param imaginaryOutput The output data vector for imaginary part.
+   */
+  void fastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation on the input
+   * data and returns the result to the address with `2 ^ realInput.length()`
+   * elements.
+   * @param realInput The input data vector for real part.
+   * @param imaginaryInput The input data vector for imaginary part.
+   * @param realOutput The output data vector for real part.
+   * @param imaginaryOutput The output data vector for imaginary part.
+   */
+  void inverseFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation on real input data
+   * and returns the `n / 2 + 1` non-negative frequency bins, where `n` is the
+   * input size padded to a power of two.
+   * @param realInput The input data vector.
+   * @param realOutput The output data vector for real part.
+   * @param imaginaryOutput The output data vector for imaginary part.
+   */
+  void realFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      std::vector<element_datatype>* realOutput,
+      std::vector<element_datatype>* imaginaryOutput) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation on the
+   * `n / 2 + 1` non-negative frequency bins of a real signal and returns the
+   * `n` real samples.
+   * @param realInput The input data vector for real part.
+   * @param imaginaryInput The input data vector for imaginary part.
+   * @param realOutput The output data vector.
+   */
+  void inverseRealFastFourierTransform(
+      const std::vector<element_datatype>* realInput,
+      const std::vector<element_datatype>* imaginaryInput,
+      std::vector<element_datatype>* realOutput) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void fastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                   unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place,
+   * scaled by `1 / n`.
+   * @param data The interleaved complex data, `2 ^ log2n` elements.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void inverseFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                          unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place on a power
+   * of two number of elements.
+   * @param data The interleaved complex data, `size` elements.
+   * @param size The transform size, a power of two.
+   */
+  void exactSizeFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, std::size_t size) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place on a
+   * power of two number of elements, scaled by `1 / size`.
+   * @param data The interleaved complex data, `size` elements.
+   * @param size The transform size, a power of two.
+   */
+  void inverseExactSizeFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, std::size_t size) override;
+
+  /**
+   * @brief Performs the Fast Fourier Transform operation in place on real
+   * data.
+   * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding
+   * the real samples as scalars on entry and the bins on exit.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void realFastFourierTransformInPlace(std::complex<element_datatype>* data,
+                                       unsigned int log2n) override;
+
+  /**
+   * @brief Performs the Inverse Fast Fourier Transform operation in place on
+   * the non-negative frequency half of a Hermitian spectrum.
+   * @param data A buffer of `2 ^ (log2n - 1) + 1` complex elements, holding
+   * the bins on entry and the real samples as scalars on exit.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void inverseRealFastFourierTransformInPlace(
+      std::complex<element_datatype>* data, unsigned int log2n) override;
+
+ private:
+  /**
+   * @brief Precomputed tables of one transform size.
+   */
+  typedef struct FixedPointFFTPlan {
+    unsigned int log2n;  // Base 2 logarithm of the transform size
+    std::vector<unsigned int> bitReversal;  // Input index of every output
+    std::vector<fixed_datatype> twiddleReal;       // cos(2 pi k / n)
+    std::vector<fixed_datatype> twiddleImaginary;  // -sin(2 pi k / n)
+  } fixed_point_fft_plan_data_type;
+
+  /**
+   * @brief Retrieves the plan of a transform size, building it on first use.
+   * @param log2n The base 2 logarithm of the transform size.
+   * @return The cached plan.
+   */
+  const fixed_point_fft_plan_data_type& getPlan(unsigned int log2n);
+
+  /**
+   * @brief Computes the fixed-point twiddle table and bit-reversal permutation
+   * of a transform size.
+   * @param plan The plan to fill, its `log2n` must already be set.
+   */
+  void buildPlan(fixed_point_fft_plan_data_type& plan);
+
+  /**
+   * @brief Converts interleaved complex values to the block, choosing the
+   * exponent that leaves two bits of headroom above the largest component.
+   * @param values The interleaved real and imaginary parts.
+   * @param count The number of complex values.
+   */
+  void loadBlock(const element_datatype* values, unsigned int count);
+
+  /**
+   * @brief Converts the block back to interleaved complex values.
+   * @param values The interleaved real and imaginary parts.
+   * @param count The number of complex values.
+   */
+  void storeBlock(element_datatype* values, unsigned int count) const;
+
+  /**
+   * @brief Negates the imaginary parts of the block.
+   * @param count The number of complex values.
+   */
+  void conjugateBlock(unsigned int count);
+
+  /**
+   * @brief Computes the FFT of the block in place with radix-2 butterflies,
+   * rescaling it before every stage.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void transformBlock(unsigned int log2n);
+
+  /**
+   * @brief Computes the inverse FFT of the block in place, scaled by `1 / n`.
+   * @param log2n The base 2 logarithm of the transform size.
+   */
+  void inverseTransformBlock(unsigned int log2n);
+
+  /**
+   * @brief Computes the right shift that restores the headroom of the block,
+   * and adds it to the block exponent.
+   * @return The shift.
+   */
+  unsigned int takeHeadroomShift();
+
+  /**
+   * @brief Computes the smallest power of two holding a number of samples.
+   * @param sampleCount The number of samples.
+   * @return The base 2 logarithm of that power of two.
+   */
+  static unsigned int ceilLog2(std::size_t sampleCount);
+
+  std::vector<fixed_point_fft_plan_data_type> plans;  // Indexed by log2n
+  std::vector<fixed_datatype> blockReal;       // Real parts of the block
+  std::vector<fixed_datatype> blockImaginary;  // Imaginary parts of the block
+  int blockExponent = 0;  // An integer `v` of the block stands for `v * 2^e`
+  fixed_datatype blockPeak = 0;  // Bitwise or of the block magnitudes
+  std::vector<std::complex<element_datatype>> workspace;  // Vector API buffer
+};
+
+// Explicit instantiation
+template class FixedPointFastFourierTransform<float, q15_data_type>;
+template class FixedPointFastFourierTransform<float, q31_data_type>;
+template class FixedPointFastFourierTransform<double, q15_data_type>;
+template class FixedPointFastFourierTransform<double, q31_data_type>;
+
+#endif
@@ -1,5 +1,6 @@
 #include "HeartRateCalculator.h"
 
+#include "SignalAlgebra.h"
 #include "SignalHistory.h"
 
 /**
@@ -87,8 +88,6 @@ template <class element_type>
 element_type HeartRateCalculator<element_type>::countRisingEdgesPerMinute(
     SignalHistoryInterface<element_type>* ppgSignalHistoryPtr,
     element_type threshold, element_type samplingPeriodUs) {
-  element_type risingEdgeCount = 0;
-
   // Calculate the timeframe in seconds
   double timeFrameSec = static_cast<double>(ppgSignalHistoryPtr->size()) *
                         static_cast<double>(samplingPeriodUs) / 1e6;
@@ -96,24 +95,21 @@ element_type HeartRateCalculator<element_type>::countRisingEdgesPerMinute(
   // Calculate the timeframe in minutes
   double timeFrameMin = timeFrameSec / 60.0;
 
-  for (unsigned int i = 0; i < ppgSignalHistoryPtr->size() - 1; i++) {
-    // Get the first value in the signal history
-    element_type firstValue = ppgSignalHistoryPtr->get(i);
-    // Get the second value in the signal history
-    element_type secondValue = ppgSignalHistoryPtr->get(i + 1);
-
-    bool isFirstValueBelowThreshold =
-        firstValue <
-        threshold;  // Check if the first value is below the threshold
-    bool isSecondValuAboveEqualThreshold =
-        secondValue >= threshold;  // Check if the second value is above or
-                                   // equal to the threshold
-
-    // Check if the second value is greater than the first value and the
-    // threshold, then count it
-    if (isFirstValueBelowThreshold && isSecondValuAboveEqualThreshold)
-      risingEdgeCount++;
-  }
+  // Count the adjacent pairs that rise from below the threshold to above or
+  // equal to it, in a single pass over the history memory
+  std::size_t sampleCount =
+      static_cast<std::size_t>(ppgSignalHistoryPtr->size());
+  SignalView<element_type> signal(
+      ppgSignalHistoryPtr->getBlock(0, sampleCount));
+  element_type risingEdgeCount = reduce(
+      adjacentPairs(signal,
+                    [threshold](element_type previous, element_type current) {
+                      return previous < threshold && !(current < threshold);
+                    }),
+      static_cast<element_type>(0),
+      [](element_type count, bool isRisingEdge) {
+        return isRisingEdge ? count + 1 : count;
+      });
 
   // Calculate the heart rate by dividing the number of rising edges by the
   // timeframe in minutes
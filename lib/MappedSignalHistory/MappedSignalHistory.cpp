@@ -0,0 +1,545 @@
+#include "MappedSignalHistory.h"
+
+#include <algorithm>
+
+#ifdef EXCLUDEARDUINOLIB
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#ifdef UNIT_TEST
+#include <stdexcept>  // std::invalid_argument
+#endif
+
+// Signature written at the start of every history file
+static const char MAPPEDHISTORYMAGIC[8] = {'P', 'P', 'G', 'H',
+                                           'I', 'S', 'T', '1'};
+
+/**
+ * @brief Opens or creates a memory-mapped history.
+ *
+ * The file is sized to hold the header, `capacity` signals and two queues of
+ * `capacity` slots. A new file is sparse, so untouched pages take no space.
+ *
+ * A file that cannot be opened, resized or mapped throws an std::runtime_error
+ * exception in the unit test build. Otherwise the history falls back to an
+ * anonymous mapping of the same layout, which works but is not saved.
+ *
+ * @param filePath The path of the backing file.
+ * @param capacity The maximum size of the history, rounded up to a power of
+ * two. A file whose header or queues point outside the ring, e.g. after a
+ * truncated write, is cleared instead of reopened.
+ */
+template <class element_type>
+MappedSignalHistory<element_type>::MappedSignalHistory(const char* filePath,
+                                                       std::size_t capacity)
+    : fileDescriptor(-1),
+      mapping(MAP_FAILED),
+      mappingSize(0),
+      indexMask(0),
+      header(nullptr),
+      history(nullptr),
+      minSlots(nullptr),
+      maxSlots(nullptr) {
+  // Round the capacity up to a power of two so ring slots can be masked
+  std::size_t slotCount = 1;
+  while (slotCount < capacity) slotCount <<= 1;
+  indexMask = slotCount - 1;
+
+  mappingSize = sizeof(mapped_history_header_data_type) +
+                slotCount * sizeof(element_type) +
+                2 * slotCount * sizeof(std::uint64_t);
+
+  fileDescriptor = open(filePath, O_RDWR | O_CREAT, 0644);
+  struct stat fileStatus;
+  const char* failure = nullptr;
+  bool isFileReusable = false;
+  if (fileDescriptor < 0 || fstat(fileDescriptor, &fileStatus) != 0) {
+    failure = "Cannot open the history file";
+  } else {
+    isFileReusable =
+        static_cast<std::size_t>(fileStatus.st_size) == mappingSize;
+    if (!isFileReusable && ftruncate(fileDescriptor, mappingSize) != 0) {
+      failure = "Cannot resize the history file";
+    }
+  }
+  if (failure == nullptr) {
+    mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                   fileDescriptor, 0);
+    if (mapping == MAP_FAILED) failure = "Cannot map the history file";
+  }
+
+  if (failure != nullptr) {
+    if (fileDescriptor >= 0) close(fileDescriptor);
+    fileDescriptor = -1;
+#ifdef UNIT_TEST
+    throw std::runtime_error(failure);
+#endif
+    // Callers that never check isOpen() keep a working history, only it is
+    // not saved
+    mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    isFileReusable = false;
+  }
+
+  // Lay the header, the signals and the queues out back to back
+  header = static_cast<mapped_history_header_data_type*>(mapping);
+  history = reinterpret_cast<element_type*>(header + 1);
+  minSlots = reinterpret_cast<std::uint64_t*>(history + slotCount);
+  maxSlots = minSlots + slotCount;
+
+  isFileReusable =
+      isFileReusable &&
+      std::memcmp(header->magic, MAPPEDHISTORYMAGIC, sizeof(header->magic)) ==
+          0 &&
+      header->elementSize == sizeof(element_type) &&
+      header->capacity == slotCount && isHeaderConsistent();
+  if (!isFileReusable) {
+    std::memcpy(header->magic, MAPPEDHISTORYMAGIC, sizeof(header->magic));
+    header->elementSize = sizeof(element_type);
+    header->capacity = slotCount;
+    reset();
+  }
+};
+
+/**
+ * @brief Flushes and unmaps the history file.
+ */
+template <class element_type>
+MappedSignalHistory<element_type>::~MappedSignalHistory() {
+  if (mapping != MAP_FAILED) {
+    if (fileDescriptor >= 0) msync(mapping, mappingSize, MS_SYNC);
+    munmap(mapping, mappingSize);
+  }
+  if (fileDescriptor >= 0) close(fileDescriptor);
+};
+
+/**
+ * @brief Checks whether the backing file is mapped.
+ *
+ * @return `true` if the history is saved to its file, `false` if it fell back
+ * to memory.
+ */
+template <class element_type>
+bool MappedSignalHistory<element_type>::isOpen() {
+  return fileDescriptor >= 0;
+};
+
+/**
+ * @brief Schedules the dirty pages of the mapping to be written to the file.
+ */
+template <class element_type>
+void MappedSignalHistory<element_type>::sync() {
+  if (fileDescriptor >= 0) msync(mapping, mappingSize, MS_ASYNC);
+};
+
+/**
+ * @brief Adds a signal to the history.
+ *
+ * If the history is full, the oldest signal is overwritten by the new one.
+ *
+ * @param signal The signal to be added to the history.
+ */
+template <class element_type>
+void MappedSignalHistory<element_type>::put(element_type signal) {
+  std::size_t entrySlot = static_cast<std::size_t>(getEntryPointIndex());
+
+  // Forget the oldest signal in the extremum queues before it is evicted
+  element_type evictedSignal = signal;
+  if (header->elementCount == header->capacity) {
+    std::size_t evictedSlot = static_cast<std::size_t>(header->oldestSlot);
+    evictedSignal = history[evictedSlot];
+    popEvictedSlot(minSlots, header->minHead, header->minCount, evictedSlot);
+    popEvictedSlot(maxSlots, header->maxHead, header->maxCount, evictedSlot);
+  }
+  updateRunningStatistics(signal, evictedSignal);
+
+  // Store the signal at the entry point, then advance the ring
+  history[entrySlot] = signal;
+  pushSlot(minSlots, header->minHead, header->minCount, entrySlot, true);
+  pushSlot(maxSlots, header->maxHead, header->maxCount, entrySlot, false);
+  updateEntryPointIndex();
+
+  // Bound the rounding error of the sliding updates, O(1) amortized
+  if (header->evictionsSinceResync >= header->capacity) {
+    resyncRunningStatistics();
+  }
+};
+
+/**
+ * @brief Retrieves a signal from the history.
+ *
+ * @param nthSample The index of the signal, where 0 is the oldest signal.
+ * @return The signal at the given index.
+ */
+template <class element_type>
+element_type MappedSignalHistory<element_type>::get(element_type nthSample) {
+#ifdef UNIT_TEST
+  // Check if nthSample is a valid index
+  if (nthSample < 0 || nthSample >= header->elementCount) {
+    throw std::invalid_argument("nthSample is out of the history range");
+  }
+#endif
+
+  return history[slotOf(static_cast<std::size_t>(nthSample))];
+};
+
+/**
+ * @brief Retrieves a signal from the history by integer index.
+ *
+ * @param nthSample The index of the signal, where 0 is the oldest signal.
+ * @return The signal at the given index.
+ */
+template <class element_type>
+element_type MappedSignalHistory<element_type>::getSample(
+    std::size_t nthSample) {
+#ifdef UNIT_TEST
+  // Check if nthSample is a valid index
+  if (nthSample >= header->elementCount) {
+    throw std::invalid_argument("nthSample is out of the history range");
+  }
+#endif
+
+  return history[slotOf(nthSample)];
+};
+
+/**
+ * @brief Exposes consecutive signals of the mapping without copying them.
+ *
+ * Only the pages covered by the returned spans are faulted in when read.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals in the block.
+ * @return One or two contiguous spans covering the signals, oldest first.
+ */
+template <class element_type>
+SignalBlock<element_type> MappedSignalHistory<element_type>::getBlock(
+    std::size_t firstSample, std::size_t sampleCount) {
+#ifdef UNIT_TEST
+  // Check if the block lies inside the history
+  if (firstSample > header->elementCount ||
+      sampleCount > header->elementCount - firstSample) {
+    throw std::invalid_argument("Block is out of the history range");
+  }
+#endif
+
+  std::size_t startSlot = slotOf(firstSample);
+  std::size_t firstLength = static_cast<std::size_t>(header->capacity) -
+                            startSlot;
+  if (firstLength > sampleCount) firstLength = sampleCount;
+
+  SignalBlock<element_type> block;
+  block.first.data = history + startSlot;
+  block.first.length = firstLength;
+  block.second.data = history;
+  block.second.length = sampleCount - firstLength;
+  return block;
+};
+
+/**
+ * @brief Copies consecutive signals of the history to a buffer.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals to copy.
+ * @param destination The buffer receiving the signals, oldest first.
+ */
+template <class element_type>
+void MappedSignalHistory<element_type>::copyBlock(std::size_t firstSample,
+                                                  std::size_t sampleCount,
+                                                  element_type* destination) {
+  SignalBlock<element_type> block = getBlock(firstSample, sampleCount);
+  std::copy(block.first.data, block.first.data + block.first.length,
+            destination);
+  std::copy(block.second.data, block.second.data + block.second.length,
+            destination + block.first.length);
+};
+
+/**
+ * @brief Retrieves the smallest signal from the history.
+ *
+ * @return The smallest signal value.
+ */
+template <class element_type>
+element_type MappedSignalHistory<element_type>::min() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (header->elementCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  return history[minSlots[header->minHead]];
+};
+
+/**
+ * @brief Retrieves the largest signal from the history.
+ *
+ * @return The largest signal value.
+ */
+template <class element_type>
+element_type MappedSignalHistory<element_type>::max() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (header->elementCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  return history[maxSlots[header->maxHead]];
+};
+
+/**
+ * @brief Retrieves the sum of the signals in the history.
+ *
+ * @return The sum of the signals.
+ */
+template <class element_type>
+element_type MappedSignalHistory<element_type>::sum() {
+  return header->runningMean * static_cast<element_type>(header->elementCount);
+};
+
+/**
+ * @brief Retrieves the mean of the signals in the history.
+ *
+ * @return The mean of the signals.
+ */
+template <class element_type>
+element_type MappedSignalHistory<element_type>::mean() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (header->elementCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  return header->runningMean;
+};
+
+/**
+ * @brief Retrieves the sum of the squared signals in the history.
+ *
+ * @return The sum of the squared signals.
+ */
+template <class element_type>
+element_type MappedSignalHistory<element_type>::sumOfSquares() {
+  return header->runningSquaredError +
+         header->runningMean * header->runningMean *
+             static_cast<element_type>(header->elementCount);
+};
+
+/**
+ * @brief Retrieves the population variance of the signals in the history.
+ *
+ * @return The variance of the signals.
+ */
+template <class element_type>
+element_type MappedSignalHistory<element_type>::variance() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (header->elementCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  return header->runningSquaredError /
+         static_cast<element_type>(header->elementCount);
+};
+
+/**
+ * @brief Retrieves the number of samples stored for history.
+ *
+ * @return The number of samples stored for history.
+ */
+template <class element_type>
+element_type MappedSignalHistory<element_type>::size() {
+  return static_cast<element_type>(header->elementCount);
+};
+
+/**
+ * @brief Resets the history.
+ *
+ * The file keeps its size, only the header is cleared.
+ */
+template <class element_type>
+void MappedSignalHistory<element_type>::reset() {
+  header->oldestSlot = 0;
+  header->elementCount = 0;
+  header->minHead = 0;
+  header->minCount = 0;
+  header->maxHead = 0;
+  header->maxCount = 0;
+  header->evictionsSinceResync = 0;
+  header->runningMean = 0;
+  header->runningSquaredError = 0;
+};
+
+/**
+ * @brief Gets the entry point index.
+ *
+ * @return The ring buffer slot where the next signal will be stored.
+ */
+template <class element_type>
+element_type MappedSignalHistory<element_type>::getEntryPointIndex() {
+  return static_cast<element_type>(
+      slotOf(static_cast<std::size_t>(header->elementCount)));
+};
+
+/**
+ * @brief Updates the entry point index.
+ *
+ * This function grows the history by one signal, or drops the oldest signal
+ * when the history is full.
+ */
+template <class element_type>
+void MappedSignalHistory<element_type>::updateEntryPointIndex() {
+  if (header->elementCount == header->capacity) {
+    header->oldestSlot = (header->oldestSlot + 1) & indexMask;
+  } else {
+    ++header->elementCount;
+  }
+};
+
+/**
+ * @brief Checks that the state read from a reopened file stays inside the
+ * ring.
+ *
+ * Runs once per open, in O(capacity).
+ *
+ * @return `true` if every position, length and queued slot is in range.
+ */
+template <class element_type>
+bool MappedSignalHistory<element_type>::isHeaderConsistent() const {
+  std::uint64_t elementCount = header->elementCount;
+  if (header->oldestSlot > indexMask || elementCount > header->capacity ||
+      header->minHead > indexMask || header->maxHead > indexMask ||
+      header->minCount > elementCount || header->maxCount > elementCount ||
+      (elementCount != 0 &&
+       (header->minCount == 0 || header->maxCount == 0))) {
+    return false;
+  }
+  for (std::uint64_t i = 0; i < header->minCount; ++i) {
+    if (minSlots[(header->minHead + i) & indexMask] > indexMask) return false;
+  }
+  for (std::uint64_t i = 0; i < header->maxCount; ++i) {
+    if (maxSlots[(header->maxHead + i) & indexMask] > indexMask) return false;
+  }
+  return true;
+};
+
+/**
+ * @brief Maps a position counted from the oldest signal to a ring slot.
+ *
+ * @param nthSample The position counted from the oldest signal.
+ * @return The ring buffer slot holding that signal.
+ */
+template <class element_type>
+std::size_t MappedSignalHistory<element_type>::slotOf(
+    std::size_t nthSample) const {
+  return (static_cast<std::size_t>(header->oldestSlot) + nthSample) &
+         indexMask;
+};
+
+/**
+ * @brief Removes an evicted slot from the front of an extremum queue.
+ *
+ * @param slots The ring of queued slots.
+ * @param head The front of the queue.
+ * @param count The length of the queue.
+ * @param evictedSlot The history slot of the signal being evicted.
+ */
+template <class element_type>
+void MappedSignalHistory<element_type>::popEvictedSlot(
+    std::uint64_t* slots, std::uint64_t& head, std::uint64_t& count,
+    std::size_t evictedSlot) {
+  if (count != 0 && slots[head] == evictedSlot) {
+    head = (head + 1) & indexMask;
+    --count;
+  }
+};
+
+/**
+ * @brief Appends a slot to an extremum queue.
+ *
+ * Only the back of the queue is touched, so the pages of the queue that are
+ * read stay near its two ends.
+ *
+ * @param slots The ring of queued slots.
+ * @param head The front of the queue.
+ * @param count The length of the queue.
+ * @param newSlot The history slot of the newest signal.
+ * @param keepSmallest `true` for the min() queue, `false` for max().
+ */
+template <class element_type>
+void MappedSignalHistory<element_type>::pushSlot(std::uint64_t* slots,
+                                                 std::uint64_t& head,
+                                                 std::uint64_t& count,
+                                                 std::size_t newSlot,
+                                                 bool keepSmallest) {
+  element_type newSignal = history[newSlot];
+  while (count != 0) {
+    element_type backSignal = history[slots[(head + count - 1) & indexMask]];
+    bool backIsDominated =
+        keepSmallest ? !(backSignal < newSignal) : !(newSignal < backSignal);
+    if (!backIsDominated) break;
+    --count;
+  }
+  slots[(head + count) & indexMask] = newSlot;
+  ++count;
+};
+
+/**
+ * @brief Updates the running mean and sum of squared deviations.
+ *
+ * Same sliding-window Welford update as `SignalHistory`.
+ *
+ * @param newSignal The signal being added.
+ * @param evictedSignal The signal being evicted, ignored if the history is not
+ * full.
+ */
+template <class element_type>
+void MappedSignalHistory<element_type>::updateRunningStatistics(
+    element_type newSignal, element_type evictedSignal) {
+  element_type previousMean = header->runningMean;
+
+  if (header->elementCount < header->capacity) {
+    element_type count = static_cast<element_type>(header->elementCount + 1);
+    header->runningMean += (newSignal - previousMean) / count;
+    header->runningSquaredError +=
+        (newSignal - previousMean) * (newSignal - header->runningMean);
+  } else {
+    element_type count = static_cast<element_type>(header->elementCount);
+    header->runningMean += (newSignal - evictedSignal) / count;
+    header->runningSquaredError +=
+        (newSignal - evictedSignal) *
+        (newSignal - header->runningMean + evictedSignal - previousMean);
+    ++header->evictionsSinceResync;
+  }
+
+  // Rounding may push the sum of squared deviations slightly below zero
+  if (header->runningSquaredError < 0) header->runningSquaredError = 0;
+};
+
+/**
+ * @brief Recomputes the running statistics from the stored signals.
+ *
+ * This is called once per `capacity` evictions, so its O(n) cost is O(1)
+ * amortized per put().
+ */
+template <class element_type>
+void MappedSignalHistory<element_type>::resyncRunningStatistics() {
+  std::size_t count = static_cast<std::size_t>(header->elementCount);
+
+  element_type total = 0;
+  for (std::size_t i = 0; i < count; ++i) total += history[slotOf(i)];
+  header->runningMean = total / static_cast<element_type>(count);
+
+  element_type squaredError = 0;
+  for (std::size_t i = 0; i < count; ++i) {
+    element_type deviation = history[slotOf(i)] - header->runningMean;
+    squaredError += deviation * deviation;
+  }
+  header->runningSquaredError = squaredError;
+  header->evictionsSinceResync = 0;
+};
+
+#endif  // EXCLUDEARDUINOLIB
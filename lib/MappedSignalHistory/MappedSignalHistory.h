@@ -0,0 +1,263 @@
+#ifndef MAPPED_SIGNAL_HISTORY_H
+#define MAPPED_SIGNAL_HISTORY_H
+
+// Memory-mapped files are only available on the native (host) build.
+#ifdef EXCLUDEARDUINOLIB
+
+#include <cstddef>
+#include <cstdint>
+
+#include "signal_history/SignalHistoryInterface.h"
+
+/**
+ * @brief Template class for storing history of discrete signal intensity in a
+ * memory-mapped file.
+ *
+ * The file holds a header, the ring buffer of signals and the two extremum
+ * queues, laid out like `SignalHistory`. All state lives in the mapping, so a
+ * history can be closed and reopened without re-reading the samples, and the
+ * operating system only pages in the parts of the file that are touched.
+ *
+ * @tparam element_type The type of the signals.
+ */
+template <class element_type>
+class MappedSignalHistory : public SignalHistoryInterface<element_type> {
+ public:
+  /**
+   * @brief Opens or creates a memory-mapped history.
+   *
+   * @param filePath The path of the backing file.
+   * @param capacity The maximum size of the history, rounded up to a power of
+   * two. An existing file with the same capacity and signal type is reopened
+   * with its signals, any other file, or one whose state is out of range, is
+   * overwritten with an empty history. If the file cannot be mapped, the
+   * history is kept in memory instead.
+   */
+  MappedSignalHistory(const char* filePath, std::size_t capacity);
+
+  /**
+   * @brief Flushes and unmaps the history file.
+   */
+  ~MappedSignalHistory();
+
+  // The mapping and the file descriptor are owned by one history only
+  MappedSignalHistory(const MappedSignalHistory&) = delete;
+  MappedSignalHistory& operator=(const MappedSignalHistory&) = delete;
+
+  /**
+   * @brief Checks whether the backing file is mapped.
+   *
+   * @return `true` if the history is saved to its file, `false` if it fell
+   * back to memory.
+   */
+  bool isOpen();
+
+  /**
+   * @brief Schedules the dirty pages of the mapping to be written to the file.
+   */
+  void sync();
+
+  /**
+   * @brief Adds a signal to the history.
+   *
+   * @param signal The signal to be added to the history.
+   *
+   * If the history is full, the oldest signal is overwritten by the new one.
+   */
+  void put(element_type signal) override;
+
+  /**
+   * @brief Retrieves a signal from the history.
+   *
+   * @param nthSample The index of the signal, where 0 is the oldest signal.
+   * @return The signal at the given index.
+   */
+  element_type get(element_type nthSample) override;
+
+  /**
+   * @brief Retrieves a signal from the history by integer index.
+   *
+   * @param nthSample The index of the signal, where 0 is the oldest signal.
+   * @return The signal at the given index.
+   */
+  element_type getSample(std::size_t nthSample) override;
+
+  /**
+   * @brief Exposes consecutive signals of the mapping without copying them.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the block.
+   * @return One or two contiguous spans covering the signals, oldest first.
+   */
+  SignalBlock<element_type> getBlock(std::size_t firstSample,
+                                     std::size_t sampleCount) override;
+
+  /**
+   * @brief Copies consecutive signals of the history to a buffer.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals to copy.
+   * @param destination The buffer receiving the signals, oldest first.
+   */
+  void copyBlock(std::size_t firstSample, std::size_t sampleCount,
+                 element_type* destination) override;
+
+  /**
+   * @brief Retrieves the smallest signal from the history in O(1).
+   *
+   * @return The smallest signal value.
+   */
+  element_type min() override;
+
+  /**
+   * @brief Retrieves the largest signal from the history in O(1).
+   *
+   * @return The largest signal value.
+   */
+  element_type max() override;
+
+  /**
+   * @brief Retrieves the sum of the signals in the history in O(1).
+   *
+   * @return The sum of the signals.
+   */
+  element_type sum() override;
+
+  /**
+   * @brief Retrieves the mean of the signals in the history in O(1).
+   *
+   * @return The mean of the signals.
+   */
+  element_type mean() override;
+
+  /**
+   * @brief Retrieves the sum of the squared signals in the history in O(1).
+   *
+   * @return The sum of the squared signals.
+   */
+  element_type sumOfSquares() override;
+
+  /**
+   * @brief Retrieves the population variance of the signals in O(1).
+   *
+   * @return The variance of the signals.
+   */
+  element_type variance() override;
+
+  /**
+   * @brief Retrieves the number of samples stored for history.
+   *
+   * @return The number of samples stored for history.
+   */
+  element_type size() override;
+
+  /**
+   * @brief Resets the history.
+   *
+   * The file keeps its size, only the header is cleared.
+   */
+  void reset() override;
+
+ private:
+  /**
+   * @brief Gets the entry point index.
+   *
+   * @return The ring buffer slot where the next signal will be stored.
+   */
+  element_type getEntryPointIndex() override;
+
+  /**
+   * @brief Updates the entry point index, evicting the oldest signal when the
+   * history is full.
+   */
+  void updateEntryPointIndex() override;
+
+  /**
+   * @brief Header at the start of the history file.
+   */
+  typedef struct MappedHistoryHeader {
+    char magic[8];                       // File signature
+    std::uint64_t elementSize;           // sizeof(element_type)
+    std::uint64_t capacity;              // Number of ring slots
+    std::uint64_t oldestSlot;            // Ring slot of the oldest signal
+    std::uint64_t elementCount;          // Number of signals in the history
+    std::uint64_t minHead;               // Front of the min() queue
+    std::uint64_t minCount;              // Length of the min() queue
+    std::uint64_t maxHead;               // Front of the max() queue
+    std::uint64_t maxCount;              // Length of the max() queue
+    std::uint64_t evictionsSinceResync;  // Evictions since the last resync
+    element_type runningMean;            // Mean of the signals
+    element_type runningSquaredError;    // Sum of squared deviations
+  } mapped_history_header_data_type;
+
+  /**
+   * @brief Checks that the state read from a reopened file stays inside the
+   * ring.
+   *
+   * @return `true` if every position, length and queued slot is in range.
+   */
+  bool isHeaderConsistent() const;
+
+  /**
+   * @brief Maps a position counted from the oldest signal to a ring slot.
+   *
+   * @param nthSample The position counted from the oldest signal.
+   * @return The ring buffer slot holding that signal.
+   */
+  std::size_t slotOf(std::size_t nthSample) const;
+
+  /**
+   * @brief Removes an evicted slot from the front of an extremum queue.
+   *
+   * @param slots The ring of queued slots.
+   * @param head The front of the queue.
+   * @param count The length of the queue.
+   * @param evictedSlot The history slot of the signal being evicted.
+   */
+  void popEvictedSlot(std::uint64_t* slots, std::uint64_t& head,
+                      std::uint64_t& count, std::size_t evictedSlot);
+
+  /**
+   * @brief Appends a slot to an extremum queue, dropping every queued signal
+   * that can no longer be the extremum of the window.
+   *
+   * @param slots The ring of queued slots.
+   * @param head The front of the queue.
+   * @param count The length of the queue.
+   * @param newSlot The history slot of the newest signal.
+   * @param keepSmallest `true` for the min() queue, `false` for max().
+   */
+  void pushSlot(std::uint64_t* slots, std::uint64_t& head,
+                std::uint64_t& count, std::size_t newSlot, bool keepSmallest);
+
+  /**
+   * @brief Updates the running mean and sum of squared deviations.
+   *
+   * @param newSignal The signal being added.
+   * @param evictedSignal The signal being evicted, ignored if the history is
+   * not full.
+   */
+  void updateRunningStatistics(element_type newSignal,
+                               element_type evictedSignal);
+
+  /**
+   * @brief Recomputes the running statistics from the stored signals.
+   */
+  void resyncRunningStatistics();
+
+ private:
+  int fileDescriptor;                       // The backing file
+  void* mapping;                            // Start of the mapping
+  std::size_t mappingSize;                  // Length of the mapping in bytes
+  std::size_t indexMask;                    // capacity - 1
+  mapped_history_header_data_type* header;  // State of the history
+  element_type* history;                    // The ring buffer of signals
+  std::uint64_t* minSlots;                  // The min() queue slots
+  std::uint64_t* maxSlots;                  // The max() queue slots
+};
+
+template class MappedSignalHistory<double>;
+
+#endif  // EXCLUDEARDUINOLIB
+
+#endif
@@ -0,0 +1,209 @@
+#include "MultiChannelSignalHistory.h"
+
+#ifdef UNIT_TEST
+#include <stdexcept>  // std::invalid_argument
+#endif
+
+/**
+ * @brief Constructs a new MultiChannelSignalHistory object.
+ *
+ * This constructor initializes an empty history that keeps up to `capacity`
+ * frames.
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+MultiChannelSignalHistory<element_type, time_data_type, laneCount,
+                          capacity>::MultiChannelSignalHistory()
+    : oldestSlot(0), elementCount(0), maxElementsCount(capacity){};
+
+/**
+ * @brief Constructs a new MultiChannelSignalHistory object with a shorter
+ * window.
+ *
+ * Every lane is given the same window so that the lanes evict together.
+ *
+ * @param maxElementsCount The number of frames kept before the oldest one is
+ * evicted. It is clamped to the range [1, capacity].
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+MultiChannelSignalHistory<element_type, time_data_type, laneCount, capacity>::
+    MultiChannelSignalHistory(std::size_t maxElementsCount)
+    : oldestSlot(0), elementCount(0), maxElementsCount(maxElementsCount) {
+#ifdef UNIT_TEST
+  if (maxElementsCount == 0 || maxElementsCount > capacity) {
+    throw std::invalid_argument(
+        "maxElementsCount must be between 1 and the history capacity");
+  }
+#endif
+  if (this->maxElementsCount == 0) this->maxElementsCount = 1;
+  if (this->maxElementsCount > capacity) this->maxElementsCount = capacity;
+
+  for (std::size_t channel = 0; channel < laneCount; ++channel) {
+    lanes[channel] =
+        SignalHistory<element_type, capacity>(this->maxElementsCount);
+  }
+};
+
+/**
+ * @brief Destructs a MultiChannelSignalHistory object.
+ *
+ * The lanes and the timestamp ring buffer are member arrays, so there's no
+ * need to free anything.
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+MultiChannelSignalHistory<element_type, time_data_type, laneCount,
+                          capacity>::~MultiChannelSignalHistory(){};
+
+/**
+ * @brief Adds a frame to the history.
+ *
+ * Every lane and the timestamp ring advance by one slot together.
+ *
+ * @param channelSignals One signal per channel, indexed by channel.
+ * @param timestampUs The time the frame was sampled in microseconds.
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+void MultiChannelSignalHistory<element_type, time_data_type, laneCount,
+                               capacity>::put(const element_type*
+                                                  channelSignals,
+                                              time_data_type timestampUs) {
+  // The lanes keep the nth frame ever put in slot n, so the timestamp goes to
+  // the slot of the current version as well
+  std::size_t entrySlot = version() & INDEXMASK;
+  for (std::size_t channel = 0; channel < laneCount; ++channel) {
+    lanes[channel].put(channelSignals[channel]);
+  }
+
+  // Store the timestamp at the entry point, then advance the ring
+  timestampsUs[entrySlot] = timestampUs;
+  if (elementCount == maxElementsCount) {
+    oldestSlot = (oldestSlot + 1) & INDEXMASK;
+  } else {
+    ++elementCount;
+  }
+};
+
+/**
+ * @brief Retrieves the history of one channel.
+ *
+ * @param channel The index of the channel.
+ * @return The channel history, only to be read from.
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+SignalHistoryInterface<element_type>*
+MultiChannelSignalHistory<element_type, time_data_type, laneCount,
+                          capacity>::getChannel(std::size_t channel) {
+#ifdef UNIT_TEST
+  if (channel >= laneCount) {
+    throw std::invalid_argument("channel is out of range");
+  }
+#endif
+  return &lanes[channel];
+};
+
+/**
+ * @brief Retrieves the timestamp of a frame.
+ *
+ * @param nthSample The index of the frame, where 0 is the oldest frame.
+ * @return The time the frame was sampled in microseconds.
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+time_data_type MultiChannelSignalHistory<
+    element_type, time_data_type, laneCount,
+    capacity>::getTimestampUs(std::size_t nthSample) {
+#ifdef UNIT_TEST
+  if (nthSample >= elementCount) {
+    throw std::invalid_argument("nthSample is out of the history range");
+  }
+#endif
+  return timestampsUs[(oldestSlot + nthSample) & INDEXMASK];
+};
+
+/**
+ * @brief Exposes consecutive frame timestamps without copying them.
+ *
+ * @param firstSample The index of the first frame, where 0 is the oldest.
+ * @param sampleCount The number of frames in the block.
+ * @return One or two contiguous spans covering the timestamps, oldest first.
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+SignalBlock<time_data_type> MultiChannelSignalHistory<
+    element_type, time_data_type, laneCount,
+    capacity>::getTimestampBlock(std::size_t firstSample,
+                                 std::size_t sampleCount) {
+#ifdef UNIT_TEST
+  if (firstSample > elementCount || sampleCount > elementCount - firstSample) {
+    throw std::invalid_argument("Block is out of the history range");
+  }
+#endif
+
+  std::size_t startSlot = (oldestSlot + firstSample) & INDEXMASK;
+  std::size_t firstLength = capacity - startSlot;
+  if (firstLength > sampleCount) firstLength = sampleCount;
+
+  SignalBlock<time_data_type> block;
+  block.first.data = timestampsUs + startSlot;
+  block.first.length = firstLength;
+  block.second.data = timestampsUs;
+  block.second.length = sampleCount - firstLength;
+  return block;
+};
+
+/**
+ * @brief Retrieves the number of channels in every frame.
+ *
+ * @return The number of channels.
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+std::size_t MultiChannelSignalHistory<element_type, time_data_type,
+                                      laneCount, capacity>::channelCount() {
+  return laneCount;
+};
+
+/**
+ * @brief Retrieves the number of frames stored for history.
+ *
+ * @return The number of frames stored for history.
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+std::size_t MultiChannelSignalHistory<element_type, time_data_type,
+                                      laneCount, capacity>::size() {
+  return elementCount;
+};
+
+/**
+ * @brief Retrieves the number of frames ever put into the history.
+ *
+ * Every lane is put and reset together, so the first lane speaks for all.
+ *
+ * @return The version of the history.
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+unsigned int MultiChannelSignalHistory<element_type, time_data_type,
+                                       laneCount, capacity>::version() {
+  return lanes[0].version();
+};
+
+/**
+ * @brief Resets the history of every channel.
+ */
+template <class element_type, class time_data_type, std::size_t laneCount,
+          std::size_t capacity>
+void MultiChannelSignalHistory<element_type, time_data_type, laneCount,
+                               capacity>::reset() {
+  for (std::size_t channel = 0; channel < laneCount; ++channel) {
+    lanes[channel].reset();
+  }
+  // Restart the timestamp ring at the slot the lanes restart at
+  oldestSlot = version() & INDEXMASK;
+  elementCount = 0;
+};
@@ -0,0 +1,129 @@
+#ifndef MULTI_CHANNEL_SIGNAL_HISTORY_H
+#define MULTI_CHANNEL_SIGNAL_HISTORY_H
+
+#include <cstddef>
+
+#include "SignalHistory.h"
+#include "signal_history/MultiChannelSignalHistoryInterface.h"
+
+/**
+ * @brief Template class for storing frames of simultaneously sampled signals
+ * as a structure of arrays.
+ *
+ * Each channel is a `SignalHistory` lane with its own contiguous ring buffer,
+ * next to a ring buffer of frame timestamps. Frames are only written through
+ * put(), which advances every lane together, so all lanes hold the same ring
+ * layout and kernels can stream through them in lockstep.
+ *
+ * @tparam element_type The type of the signals.
+ * @tparam time_data_type The type of the timestamps.
+ * @tparam laneCount The number of channels in every frame.
+ * @tparam capacity The maximum number of frames, must be a power of two.
+ */
+template <class element_type, class time_data_type,
+          std::size_t laneCount = PPGChannelTotal,
+          std::size_t capacity = 512>
+class MultiChannelSignalHistory
+    : public MultiChannelSignalHistoryInterface<element_type, time_data_type> {
+ public:
+  /**
+   * @brief Constructs a new MultiChannelSignalHistory object.
+   *
+   * This constructor initializes an empty history that keeps up to `capacity`
+   * frames.
+   */
+  MultiChannelSignalHistory();
+
+  /**
+   * @brief Constructs a new MultiChannelSignalHistory object with a shorter
+   * window.
+   *
+   * @param maxElementsCount The number of frames kept before the oldest one is
+   * evicted. It is clamped to the range [1, capacity].
+   */
+  explicit MultiChannelSignalHistory(std::size_t maxElementsCount);
+
+  /**
+   * @brief Destructs a MultiChannelSignalHistory object.
+   */
+  ~MultiChannelSignalHistory();
+
+  /**
+   * @brief Adds a frame to the history.
+   *
+   * @param channelSignals One signal per channel, indexed by channel.
+   * @param timestampUs The time the frame was sampled in microseconds.
+   *
+   * If the history is full, the oldest frame is overwritten by the new one.
+   */
+  void put(const element_type* channelSignals,
+           time_data_type timestampUs) override;
+
+  /**
+   * @brief Retrieves the history of one channel.
+   *
+   * @param channel The index of the channel.
+   * @return The channel history, only to be read from.
+   */
+  SignalHistoryInterface<element_type>* getChannel(
+      std::size_t channel) override;
+
+  /**
+   * @brief Retrieves the timestamp of a frame.
+   *
+   * @param nthSample The index of the frame, where 0 is the oldest frame.
+   * @return The time the frame was sampled in microseconds.
+   */
+  time_data_type getTimestampUs(std::size_t nthSample) override;
+
+  /**
+   * @brief Exposes consecutive frame timestamps without copying them.
+   *
+   * @param firstSample The index of the first frame, where 0 is the oldest.
+   * @param sampleCount The number of frames in the block.
+   * @return One or two contiguous spans covering the timestamps, oldest first.
+   */
+  SignalBlock<time_data_type> getTimestampBlock(
+      std::size_t firstSample, std::size_t sampleCount) override;
+
+  /**
+   * @brief Retrieves the number of channels in every frame.
+   *
+   * @return The number of channels.
+   */
+  std::size_t channelCount() override;
+
+  /**
+   * @brief Retrieves the number of frames stored for history.
+   *
+   * @return The number of frames stored for history.
+   */
+  std::size_t size() override;
+
+  /**
+   * @brief Retrieves the number of frames ever put into the history.
+   *
+   * @return The version of the history, shared by every lane.
+   */
+  unsigned int version() override;
+
+  /**
+   * @brief Resets the history of every channel.
+   */
+  void reset() override;
+
+ private:
+  static const std::size_t INDEXMASK = capacity - 1;
+
+  SignalHistory<element_type, capacity> lanes[laneCount];  // Channel lanes
+  time_data_type timestampsUs[capacity];  // The ring buffer of timestamps
+  std::size_t oldestSlot;                 // Ring slot of the oldest frame
+  std::size_t elementCount;               // Number of frames in the history
+  std::size_t maxElementsCount;  // Number of frames kept before eviction
+};
+
+// Red and infrared lanes of the raw PPG history allocated by
+// `EventController`.
+template class MultiChannelSignalHistory<double, int, AmbientChannel, 64>;
+
+#endif
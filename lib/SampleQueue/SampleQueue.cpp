@@ -0,0 +1,91 @@
+#include "SampleQueue.h"
+
+/**
+ * @brief Constructs an empty SampleQueue object.
+ */
+template <class element_type, std::size_t capacity>
+SampleQueue<element_type, capacity>::SampleQueue()
+    : headCount(0), tailCount(0), droppedTotal(0){};
+
+/**
+ * @brief Destructs a SampleQueue object.
+ *
+ * The ring buffer is a member array, so there's no need to free anything.
+ */
+template <class element_type, std::size_t capacity>
+SampleQueue<element_type, capacity>::~SampleQueue(){};
+
+/**
+ * @brief Adds a sample to the queue. Only the producer may call this.
+ *
+ * The sample is written before `tailCount` is released, so the consumer never
+ * sees a slot before its sample is complete.
+ *
+ * @param sample The sample to be added to the queue.
+ * @return `true` if the sample was queued, `false` if the queue was full.
+ */
+template <class element_type, std::size_t capacity>
+bool SampleQueue<element_type, capacity>::push(const element_type& sample) {
+  unsigned int tail = tailCount.load(std::memory_order_relaxed);
+  unsigned int head = headCount.load(std::memory_order_acquire);
+
+  // Drop the sample rather than overwrite one the consumer has not read
+  if (tail - head == capacity) {
+    droppedTotal.store(droppedTotal.load(std::memory_order_relaxed) + 1,
+                       std::memory_order_relaxed);
+    return false;
+  }
+
+  samples[tail & INDEXMASK] = sample;
+  tailCount.store(tail + 1, std::memory_order_release);
+  return true;
+};
+
+/**
+ * @brief Removes the oldest sample from the queue. Only the consumer may call
+ * this.
+ *
+ * The sample is read before `headCount` is released, so the producer never
+ * reuses a slot that is still being read.
+ *
+ * @param sample Receives the oldest sample if there is one.
+ * @return `true` if a sample was removed, `false` if the queue was empty.
+ */
+template <class element_type, std::size_t capacity>
+bool SampleQueue<element_type, capacity>::pop(element_type& sample) {
+  unsigned int head = headCount.load(std::memory_order_relaxed);
+  unsigned int tail = tailCount.load(std::memory_order_acquire);
+
+  if (head == tail) return false;
+
+  sample = samples[head & INDEXMASK];
+  headCount.store(head + 1, std::memory_order_release);
+  return true;
+};
+
+/**
+ * @brief Retrieves the number of queued samples.
+ *
+ * `headCount` is loaded first. The tail loaded after it can only be further
+ * ahead, so the difference never wraps around. It can count samples pushed
+ * after slots were freed by pops it missed, so it is clamped to `capacity`.
+ *
+ * @return The number of queued samples, at most `capacity`.
+ */
+template <class element_type, std::size_t capacity>
+std::size_t SampleQueue<element_type, capacity>::size() {
+  unsigned int head = headCount.load(std::memory_order_acquire);
+  unsigned int tail = tailCount.load(std::memory_order_acquire);
+  std::size_t count = tail - head;
+  return count < capacity ? count : capacity;
+};
+
+/**
+ * @brief Retrieves the number of samples dropped because the queue was full.
+ *
+ * @return The number of dropped samples.
+ */
+template <class element_type, std::size_t capacity>
+std::size_t SampleQueue<element_type, capacity>::droppedCount() {
+  return droppedTotal.load(std::memory_order_relaxed);
+};
@@ -0,0 +1,82 @@
+#ifndef SAMPLE_QUEUE_H
+#define SAMPLE_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+#include "signal_history/SampleQueueInterface.h"
+
+/**
+ * @brief Wait-free single-producer single-consumer ring buffer.
+ *
+ * The producer only writes `tailCount` and the consumer only writes
+ * `headCount`, so neither side ever waits for the other and no lock is taken.
+ * Both counters run freely and are masked into the ring, which lets a full
+ * queue use every slot. Every operation is a bounded number of loads and
+ * stores, so push() is safe to call from an interrupt handler.
+ *
+ * @tparam element_type The type of the samples.
+ * @tparam capacity The number of slots, must be a power of two.
+ */
+template <class element_type, std::size_t capacity>
+class SampleQueue : public SampleQueueInterface<element_type> {
+  static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0,
+                "SampleQueue capacity must be a power of two");
+  static_assert(ATOMIC_INT_LOCK_FREE == 2,
+                "SampleQueue needs lock-free unsigned int atomics");
+
+ public:
+  /**
+   * @brief Constructs an empty SampleQueue object.
+   */
+  SampleQueue();
+
+  /**
+   * @brief Destructs a SampleQueue object.
+   */
+  ~SampleQueue();
+
+  /**
+   * @brief Adds a sample to the queue. Only the producer may call this.
+   *
+   * @param sample The sample to be added to the queue.
+   * @return `true` if the sample was queued, `false` if the queue was full.
+   */
+  bool push(const element_type& sample) override;
+
+  /**
+   * @brief Removes the oldest sample from the queue. Only the consumer may
+   * call this.
+   *
+   * @param sample Receives the oldest sample if there is one.
+   * @return `true` if a sample was removed, `false` if the queue was empty.
+   */
+  bool pop(element_type& sample) override;
+
+  /**
+   * @brief Retrieves the number of queued samples.
+   *
+   * @return The number of queued samples.
+   */
+  std::size_t size() override;
+
+  /**
+   * @brief Retrieves the number of samples dropped because the queue was full.
+   *
+   * @return The number of dropped samples.
+   */
+  std::size_t droppedCount() override;
+
+ private:
+  static const unsigned int INDEXMASK = capacity - 1;
+
+  element_type samples[capacity];          // The ring buffer of samples
+  std::atomic<unsigned int> headCount;     // Samples popped, consumer owned
+  std::atomic<unsigned int> tailCount;     // Samples pushed, producer owned
+  std::atomic<unsigned int> droppedTotal;  // Samples dropped, producer owned
+};
+
+// Sample queue between the acquisition interrupt and the main loop.
+template class SampleQueue<double, 64>;
+
+#endif
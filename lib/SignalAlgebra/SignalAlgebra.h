@@ -0,0 +1,274 @@
+#ifndef SIGNAL_ALGEBRA_H
+#define SIGNAL_ALGEBRA_H
+
+#include <cstddef>
+#include <utility>  // for std::declval
+
+#include "signal_history/SignalHistoryInterface.h"
+
+/**
+ * @file SignalAlgebra.h
+ * @brief Lazy expressions over history blocks.
+ *
+ * mapEach(), zipWith() and adjacentPairs() only describe a computation.
+ * Nothing is evaluated until reduce() walks the expression once, so a chain
+ * like "subtract the mean, square, sum" is a single loop with no temporary
+ * buffer, and every call is visible to the compiler for inlining.
+ *
+ * @code
+ * SignalView<double> signal(history.getBlock(0, sampleCount));
+ * auto squaredDeviation = [mean](double x) {
+ *   return (x - mean) * (x - mean);
+ * };
+ * double squaredError =
+ *     reduce(mapEach(signal, squaredDeviation), 0.0,
+ *            [](double total, double x) { return total + x; });
+ * @endcode
+ *
+ * The factories are not named map() and zip() to stay clear of the Arduino
+ * map() function.
+ *
+ * The expressions are templates of their operands, so unlike the rest of the
+ * library they are defined here rather than instantiated in a .cpp file.
+ */
+
+/**
+ * @brief Read-only view of the signals of a history block.
+ *
+ * @tparam element_type The type of the signals.
+ */
+template <class element_type>
+class SignalView {
+ public:
+  typedef element_type value_type;
+
+  /**
+   * @brief Constructs a view of a history block.
+   *
+   * @param block The block, which must stay valid while the view is used.
+   */
+  explicit SignalView(const SignalBlock<element_type>& block)
+      : first(block.first), second(block.second) {}
+
+  /**
+   * @brief Retrieves the number of signals in the view.
+   *
+   * @return The number of signals.
+   */
+  std::size_t size() const { return first.length + second.length; }
+
+  /**
+   * @brief Retrieves a signal of the view.
+   *
+   * @param i The index of the signal, where 0 is the oldest.
+   * @return The signal at the given index.
+   */
+  element_type operator[](std::size_t i) const {
+    return i < first.length ? first.data[i] : second.data[i - first.length];
+  }
+
+ private:
+  SignalSpan<element_type> first;   // The older part of the block
+  SignalSpan<element_type> second;  // The newer part of the block
+};
+
+/**
+ * @brief Lazy element-wise transform of an expression.
+ *
+ * @tparam source_type The transformed expression.
+ * @tparam function_type The transform, called with one value.
+ */
+template <class source_type, class function_type>
+class MapExpression {
+ public:
+  typedef decltype(std::declval<function_type>()(
+      std::declval<typename source_type::value_type>())) value_type;
+
+  /**
+   * @brief Constructs the expression.
+   *
+   * @param source The transformed expression.
+   * @param function The transform.
+   */
+  MapExpression(const source_type& source, function_type function)
+      : source(source), function(function) {}
+
+  /**
+   * @brief Retrieves the number of values of the expression.
+   *
+   * @return The number of values.
+   */
+  std::size_t size() const { return source.size(); }
+
+  /**
+   * @brief Evaluates one value of the expression.
+   *
+   * @param i The index of the value.
+   * @return The transformed value.
+   */
+  value_type operator[](std::size_t i) const { return function(source[i]); }
+
+ private:
+  source_type source;      // The transformed expression
+  function_type function;  // The transform
+};
+
+/**
+ * @brief Lazy element-wise combination of two expressions of the same size.
+ *
+ * @tparam left_type The first expression.
+ * @tparam right_type The second expression.
+ * @tparam function_type The combination, called with one value of each.
+ */
+template <class left_type, class right_type, class function_type>
+class ZipExpression {
+ public:
+  typedef decltype(std::declval<function_type>()(
+      std::declval<typename left_type::value_type>(),
+      std::declval<typename right_type::value_type>())) value_type;
+
+  /**
+   * @brief Constructs the expression.
+   *
+   * @param left The first expression.
+   * @param right The second expression.
+   * @param function The combination.
+   */
+  ZipExpression(const left_type& left, const right_type& right,
+                function_type function)
+      : left(left), right(right), function(function) {}
+
+  /**
+   * @brief Retrieves the number of values of the expression.
+   *
+   * @return The size of the shorter expression.
+   */
+  std::size_t size() const {
+    return left.size() < right.size() ? left.size() : right.size();
+  }
+
+  /**
+   * @brief Evaluates one value of the expression.
+   *
+   * @param i The index of the value.
+   * @return The combined value.
+   */
+  value_type operator[](std::size_t i) const {
+    return function(left[i], right[i]);
+  }
+
+ private:
+  left_type left;          // The first expression
+  right_type right;        // The second expression
+  function_type function;  // The combination
+};
+
+/**
+ * @brief Lazy combination of every value of an expression with the next one.
+ *
+ * @tparam source_type The expression.
+ * @tparam function_type The combination, called with the previous and the
+ * current value.
+ */
+template <class source_type, class function_type>
+class AdjacentPairsExpression {
+ public:
+  typedef decltype(std::declval<function_type>()(
+      std::declval<typename source_type::value_type>(),
+      std::declval<typename source_type::value_type>())) value_type;
+
+  /**
+   * @brief Constructs the expression.
+   *
+   * @param source The expression.
+   * @param function The combination.
+   */
+  AdjacentPairsExpression(const source_type& source, function_type function)
+      : source(source), function(function) {}
+
+  /**
+   * @brief Retrieves the number of values of the expression.
+   *
+   * @return One less than the size of the source, or 0.
+   */
+  std::size_t size() const {
+    return source.size() == 0 ? 0 : source.size() - 1;
+  }
+
+  /**
+   * @brief Evaluates one value of the expression.
+   *
+   * @param i The index of the pair, made of values i and i + 1.
+   * @return The combined value.
+   */
+  value_type operator[](std::size_t i) const {
+    return function(source[i], source[i + 1]);
+  }
+
+ private:
+  source_type source;      // The expression
+  function_type function;  // The combination
+};
+
+/**
+ * @brief Transforms every value of an expression lazily.
+ *
+ * @param source The expression.
+ * @param function The transform, called with one value.
+ * @return The lazy expression.
+ */
+template <class source_type, class function_type>
+MapExpression<source_type, function_type> mapEach(const source_type& source,
+                                                  function_type function) {
+  return MapExpression<source_type, function_type>(source, function);
+}
+
+/**
+ * @brief Combines two expressions value by value lazily.
+ *
+ * @param left The first expression.
+ * @param right The second expression.
+ * @param function The combination, called with one value of each.
+ * @return The lazy expression.
+ */
+template <class left_type, class right_type, class function_type>
+ZipExpression<left_type, right_type, function_type> zipWith(
+    const left_type& left, const right_type& right, function_type function) {
+  return ZipExpression<left_type, right_type, function_type>(left, right,
+                                                             function);
+}
+
+/**
+ * @brief Combines every value of an expression with the next one lazily.
+ *
+ * @param source The expression.
+ * @param function The combination, called with the previous and the current
+ * value.
+ * @return The lazy expression.
+ */
+template <class source_type, class function_type>
+AdjacentPairsExpression<source_type, function_type> adjacentPairs(
+    const source_type& source, function_type function) {
+  return AdjacentPairsExpression<source_type, function_type>(source, function);
+}
+
+/**
+ * @brief Evaluates an expression in a single pass and folds its values.
+ *
+ * @param source The expression.
+ * @param initialValue The value of an empty fold.
+ * @param function The fold, called with the running result and one value.
+ * @return The folded result.
+ */
+template <class source_type, class result_type, class function_type>
+result_type reduce(const source_type& source, result_type initialValue,
+                   function_type function) {
+  result_type result = initialValue;
+  std::size_t valueCount = source.size();
+  for (std::size_t i = 0; i < valueCount; ++i) {
+    result = function(result, source[i]);
+  }
+  return result;
+}
+
+#endif
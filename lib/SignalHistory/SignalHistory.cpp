@@ -1,9 +1,6 @@
 #include "SignalHistory.h"
 
-// if needed, `#include <stdexcept>` can Include this header file to use
-// the `std::out_of_range`
 #include <algorithm>
-#include <vector>
 
 #ifdef UNIT_TEST
 #include <stdexcept>  // std::invalid_argument
@@ -12,39 +9,134 @@
 /**
  * @brief Constructs a new SignalHistory object.
  *
- * This constructor initializes an empty vector with a size of arraySize.
+ * This constructor initializes an empty history that keeps up to `capacity`
+ * signals.
  *
  */
-template <class element_type>
-SignalHistory<element_type>::SignalHistory(){};
+template <class element_type, std::size_t capacity>
+SignalHistory<element_type, capacity>::SignalHistory()
+    : oldestSlot(0),
+      elementCount(0),
+      maxElementsCount(capacity),
+      writeVersion(0),
+      putVersion(0),
+      resetVersion(0) {
+  reset();
+};
+
+/**
+ * @brief Constructs a new SignalHistory object with a shorter window.
+ *
+ * @param maxElementsCount The number of signals kept before the oldest one is
+ * evicted. It is clamped to the range [1, capacity].
+ */
+template <class element_type, std::size_t capacity>
+SignalHistory<element_type, capacity>::SignalHistory(
+    std::size_t maxElementsCount)
+    : oldestSlot(0),
+      elementCount(0),
+      maxElementsCount(maxElementsCount),
+      writeVersion(0),
+      putVersion(0),
+      resetVersion(0) {
+#ifdef UNIT_TEST
+  if (maxElementsCount == 0 || maxElementsCount > capacity) {
+    throw std::invalid_argument(
+        "maxElementsCount must be between 1 and the history capacity");
+  }
+#endif
+  if (this->maxElementsCount == 0) this->maxElementsCount = 1;
+  if (this->maxElementsCount > capacity) this->maxElementsCount = capacity;
+  reset();
+};
+
+/**
+ * @brief Constructs a copy of another history, including its version.
+ *
+ * @param other The history to copy.
+ */
+template <class element_type, std::size_t capacity>
+SignalHistory<element_type, capacity>::SignalHistory(const SignalHistory& other)
+    : SignalHistory() {
+  *this = other;
+};
+
+/**
+ * @brief Replaces this history with a copy of another one.
+ *
+ * The atomics cannot be copied implicitly, so every member is copied here.
+ * Neither history may be written by another context meanwhile.
+ *
+ * @param other The history to copy.
+ * @return This history.
+ */
+template <class element_type, std::size_t capacity>
+SignalHistory<element_type, capacity>&
+SignalHistory<element_type, capacity>::operator=(const SignalHistory& other) {
+  for (std::size_t i = 0; i < capacity; ++i) history[i] = other.history[i];
+  oldestSlot = other.oldestSlot;
+  elementCount = other.elementCount;
+  maxElementsCount = other.maxElementsCount;
+  minSlotQueue = other.minSlotQueue;
+  maxSlotQueue = other.maxSlotQueue;
+  runningMean = other.runningMean;
+  runningSquaredError = other.runningSquaredError;
+  evictionsSinceResync = other.evictionsSinceResync;
+  writeVersion.store(other.writeVersion.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+  resetVersion.store(other.resetVersion.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+  putVersion.store(other.putVersion.load(std::memory_order_relaxed),
+                   std::memory_order_release);
+  return *this;
+};
 
 /**
  * @brief Destructs a new SignalHistory object.
  *
- * This destructor is automatically called when the vector goes out of scope,
- * so there's no need to manually call the destructor of the vector.
+ * The ring buffer is a member array, so there's no need to free anything.
  */
-template <class element_type>
-SignalHistory<element_type>::~SignalHistory(){
-    // The destructor of the vector is automatically called when the vector goes
-    // out of scope
+template <class element_type, std::size_t capacity>
+SignalHistory<element_type, capacity>::~SignalHistory(){
+    // The ring buffer is released together with the object
 };
 
 /**
  * @brief Adds a signal to the history.
  *
- * If the history is full, remove the oldest signal before adding the new one.
+ * If the history is full, the oldest signal is overwritten by the new one.
  *
  * @param signal The signal to be added to the history.
  */
-template <class element_type>
-void SignalHistory<element_type>::put(element_type signal) {
-  // If the history is full, remove the oldest signal
-  if (history.size() == history.max_size()) {
-    history.erase(history.begin());
+template <class element_type, std::size_t capacity>
+void SignalHistory<element_type, capacity>::put(element_type signal) {
+  std::size_t entrySlot = static_cast<std::size_t>(getEntryPointIndex());
+
+  // Announce the overwrite to snapshot readers before touching the slot
+  unsigned int nextVersion = putVersion.load(std::memory_order_relaxed) + 1;
+  writeVersion.store(nextVersion, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  // Forget the oldest signal in the extremum queues before it is evicted
+  element_type evictedSignal = signal;
+  if (elementCount == maxElementsCount) {
+    evictedSignal = history[oldestSlot];
+    popEvictedSlot(minSlotQueue, oldestSlot);
+    popEvictedSlot(maxSlotQueue, oldestSlot);
   }
-  // Add the new signal to the history
-  history.push_back(signal);
+  updateRunningStatistics(signal, evictedSignal);
+
+  // Store the signal at the entry point, then advance the ring
+  history[entrySlot] = signal;
+  pushSlot(minSlotQueue, entrySlot, true);
+  pushSlot(maxSlotQueue, entrySlot, false);
+  updateEntryPointIndex();
+
+  // Publish the signal to snapshot readers only once it is stored
+  putVersion.store(nextVersion, std::memory_order_release);
+
+  // Bound the rounding error of the sliding updates, O(1) amortized
+  if (evictionsSinceResync >= maxElementsCount) resyncRunningStatistics();
 };
 
 /**
@@ -53,21 +145,94 @@ void SignalHistory<element_type>::put(element_type signal) {
  * @param nthSample The index of the signal to be retrieved from the history.
  * @return The signal at the given index.
  *
- * This function checks if nthSample is a valid index before calling the at
- * function. If nthSample is not a valid index, it throws an std::out_of_range
+ * This function checks if nthSample is a valid index in the unit test build.
+ * If nthSample is not a valid index, it throws an std::invalid_argument
  * exception.
  */
-template <class element_type>
-element_type SignalHistory<element_type>::get(element_type nthSample) {
+template <class element_type, std::size_t capacity>
+element_type SignalHistory<element_type, capacity>::get(
+    element_type nthSample) {
 #ifdef UNIT_TEST
   // Check if nthSample is a valid index
-  if (nthSample >= history.size()) {
-    throw std::invalid_argument(
-        "Input and output vectors must be of the same size");
+  if (nthSample < 0 || nthSample >= elementCount) {
+    throw std::invalid_argument("nthSample is out of the history range");
+  }
+#endif
+
+  return history[slotOf(static_cast<std::size_t>(nthSample))];
+};
+
+/**
+ * @brief Retrieves a signal from the history by integer index.
+ *
+ * @param nthSample The index of the signal, where 0 is the oldest signal.
+ * @return The signal at the given index.
+ *
+ * This function checks if nthSample is a valid index in the unit test build.
+ * If nthSample is not a valid index, it throws an std::invalid_argument
+ * exception.
+ */
+template <class element_type, std::size_t capacity>
+element_type SignalHistory<element_type, capacity>::getSample(
+    std::size_t nthSample) {
+#ifdef UNIT_TEST
+  // Check if nthSample is a valid index
+  if (nthSample >= elementCount) {
+    throw std::invalid_argument("nthSample is out of the history range");
+  }
+#endif
+
+  return history[slotOf(nthSample)];
+};
+
+/**
+ * @brief Exposes consecutive signals of the ring buffer without copying them.
+ *
+ * The run starts at the ring slot of `firstSample` and continues to the end of
+ * the array, the remainder (if any) wraps around to the start of the array.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals in the block.
+ * @return One or two contiguous spans covering the signals, oldest first.
+ */
+template <class element_type, std::size_t capacity>
+SignalBlock<element_type> SignalHistory<element_type, capacity>::getBlock(
+    std::size_t firstSample, std::size_t sampleCount) {
+#ifdef UNIT_TEST
+  // Check if the block lies inside the history
+  if (firstSample > elementCount || sampleCount > elementCount - firstSample) {
+    throw std::invalid_argument("Block is out of the history range");
   }
 #endif
 
-  return history.at(nthSample);
+  std::size_t startSlot = slotOf(firstSample);
+  std::size_t firstLength = capacity - startSlot;
+  if (firstLength > sampleCount) firstLength = sampleCount;
+
+  SignalBlock<element_type> block;
+  block.first.data = history + startSlot;
+  block.first.length = firstLength;
+  block.second.data = history;
+  block.second.length = sampleCount - firstLength;
+  return block;
+};
+
+/**
+ * @brief Copies consecutive signals of the history to a buffer.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals to copy.
+ * @param destination The buffer receiving the signals, oldest first.
+ */
+template <class element_type, std::size_t capacity>
+void SignalHistory<element_type, capacity>::copyBlock(
+    std::size_t firstSample, std::size_t sampleCount,
+    element_type* destination) {
+  SignalBlock<element_type> block = getBlock(firstSample, sampleCount);
+  std::copy(block.first.data, block.first.data + block.first.length,
+            destination);
+  std::copy(block.second.data, block.second.data + block.second.length,
+            destination + block.first.length);
 };
 
 /**
@@ -76,16 +241,16 @@ element_type SignalHistory<element_type>::get(element_type nthSample) {
  * @return The smallest signal value.
  *
  */
-template <class element_type>
-element_type SignalHistory<element_type>::min() {
+template <class element_type, std::size_t capacity>
+element_type SignalHistory<element_type, capacity>::min() {
 #ifdef UNIT_TEST
   // Check if history is empty
-  if (history.empty()) {
+  if (elementCount == 0) {
     throw std::runtime_error("History is empty");
   }
 #endif
-  // Return the smallest signal in the history
-  return *std::min_element(history.begin(), history.end());
+  // The front of the increasing queue is the smallest signal in the window
+  return history[minSlotQueue.slots[minSlotQueue.head]];
 };
 
 /**
@@ -94,16 +259,73 @@ element_type SignalHistory<element_type>::min() {
  * @return The largest signal value.
  *
  */
-template <class element_type>
-element_type SignalHistory<element_type>::max() {
+template <class element_type, std::size_t capacity>
+element_type SignalHistory<element_type, capacity>::max() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (elementCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  // The front of the decreasing queue is the largest signal in the window
+  return history[maxSlotQueue.slots[maxSlotQueue.head]];
+};
+
+/**
+ * @brief Retrieves the sum of the signals in the history.
+ *
+ * @return The sum of the signals.
+ *
+ */
+template <class element_type, std::size_t capacity>
+element_type SignalHistory<element_type, capacity>::sum() {
+  return runningMean * static_cast<element_type>(elementCount);
+};
+
+/**
+ * @brief Retrieves the mean (DC component) of the signals in the history.
+ *
+ * @return The mean of the signals.
+ *
+ */
+template <class element_type, std::size_t capacity>
+element_type SignalHistory<element_type, capacity>::mean() {
 #ifdef UNIT_TEST
   // Check if history is empty
-  if (history.empty()) {
+  if (elementCount == 0) {
     throw std::runtime_error("History is empty");
   }
 #endif
-  // Return the largest signal in the history
-  return *std::max_element(history.begin(), history.end());
+  return runningMean;
+};
+
+/**
+ * @brief Retrieves the sum of the squared signals in the history.
+ *
+ * @return The sum of the squared signals.
+ *
+ */
+template <class element_type, std::size_t capacity>
+element_type SignalHistory<element_type, capacity>::sumOfSquares() {
+  return runningSquaredError +
+         runningMean * runningMean * static_cast<element_type>(elementCount);
+};
+
+/**
+ * @brief Retrieves the population variance of the signals in the history.
+ *
+ * @return The variance of the signals.
+ *
+ */
+template <class element_type, std::size_t capacity>
+element_type SignalHistory<element_type, capacity>::variance() {
+#ifdef UNIT_TEST
+  // Check if history is empty
+  if (elementCount == 0) {
+    throw std::runtime_error("History is empty");
+  }
+#endif
+  return runningSquaredError / static_cast<element_type>(elementCount);
 };
 
 /**
@@ -112,9 +334,9 @@ element_type SignalHistory<element_type>::max() {
  * @return The number of samples stored for history.
  *
  */
-template <class element_type>
-element_type SignalHistory<element_type>::size() {
-  return history.size();
+template <class element_type, std::size_t capacity>
+element_type SignalHistory<element_type, capacity>::size() {
+  return elementCount;
 }
 
 /**
@@ -122,10 +344,169 @@ element_type SignalHistory<element_type>::size() {
  *
  * This function clears the history.
  */
-template <class element_type>
-void SignalHistory<element_type>::reset() {
-  // Clear the history
-  history.clear();
+template <class element_type, std::size_t capacity>
+void SignalHistory<element_type, capacity>::reset() {
+  // A reset of a non-empty history is a change readers must see. Skipping
+  // one sequence number keeps the nth signal ever put in slot n.
+  unsigned int currentVersion = putVersion.load(std::memory_order_relaxed);
+  if (elementCount != 0) ++currentVersion;
+
+  // Forget every stored signal, the ring slots are simply overwritten later
+  oldestSlot = currentVersion & INDEXMASK;
+  elementCount = 0;
+  minSlotQueue.head = 0;
+  minSlotQueue.count = 0;
+  maxSlotQueue.head = 0;
+  maxSlotQueue.count = 0;
+  runningMean = 0;
+  runningSquaredError = 0;
+  evictionsSinceResync = 0;
+  writeVersion.store(currentVersion, std::memory_order_relaxed);
+  resetVersion.store(currentVersion, std::memory_order_relaxed);
+  putVersion.store(currentVersion, std::memory_order_release);
+};
+
+/**
+ * @brief Retrieves the number of signals ever put into the history.
+ *
+ * @return The version of the history.
+ */
+template <class element_type, std::size_t capacity>
+unsigned int SignalHistory<element_type, capacity>::version() {
+  return putVersion.load(std::memory_order_acquire);
+};
+
+/**
+ * @brief Takes a snapshot of the newest signals without copying them.
+ *
+ * Only the published version is read, so this is safe while another context
+ * puts signals. The nth signal ever put lives in slot `n & INDEXMASK`.
+ *
+ * @param sampleCount The number of signals wanted, clamped to the window.
+ * @return The snapshot.
+ */
+template <class element_type, std::size_t capacity>
+SignalSnapshot<element_type> SignalHistory<element_type, capacity>::getSnapshot(
+    std::size_t sampleCount) {
+  SignalSnapshot<element_type> snapshot;
+  snapshot.version = putVersion.load(std::memory_order_acquire);
+
+  std::size_t availableCount =
+      snapshot.version - resetVersion.load(std::memory_order_relaxed);
+  if (availableCount > maxElementsCount) availableCount = maxElementsCount;
+  if (sampleCount > availableCount) sampleCount = availableCount;
+  snapshot.sampleCount = sampleCount;
+
+  std::size_t startSlot = (snapshot.version - sampleCount) & INDEXMASK;
+  std::size_t firstLength = capacity - startSlot;
+  if (firstLength > sampleCount) firstLength = sampleCount;
+  snapshot.block.first.data = history + startSlot;
+  snapshot.block.first.length = firstLength;
+  snapshot.block.second.data = history;
+  snapshot.block.second.length = sampleCount - firstLength;
+  return snapshot;
+};
+
+/**
+ * @brief Checks that none of the signals of a snapshot has been overwritten.
+ *
+ * Every signal put since the snapshot, including one still being put,
+ * overwrote the signal `capacity` sequence numbers older. The snapshot is
+ * intact while none of those reached its oldest signal.
+ *
+ * @param snapshot A snapshot of this history.
+ * @return `true` if everything read from the snapshot so far is consistent.
+ */
+template <class element_type, std::size_t capacity>
+bool SignalHistory<element_type, capacity>::isSnapshotValid(
+    const SignalSnapshot<element_type>& snapshot) {
+  // Order the reads of the block before the version check
+  std::atomic_thread_fence(std::memory_order_acquire);
+  unsigned int writtenVersion = writeVersion.load(std::memory_order_relaxed);
+  unsigned int oldestSequence =
+      snapshot.version - static_cast<unsigned int>(snapshot.sampleCount);
+  return writtenVersion - oldestSequence <= capacity;
+};
+
+/**
+ * @brief Creates a cursor positioned at the oldest signal of the history.
+ *
+ * @return The cursor.
+ */
+template <class element_type, std::size_t capacity>
+SignalCursor SignalHistory<element_type, capacity>::openCursor() {
+  SignalCursor cursor;
+  cursor.nextSequence =
+      putVersion.load(std::memory_order_relaxed) -
+      static_cast<unsigned int>(elementCount);
+  cursor.overrunCount = 0;
+  return cursor;
+};
+
+/**
+ * @brief Counts the signals a cursor has not read yet.
+ *
+ * @param cursor The cursor of the consumer.
+ * @return The number of unread signals still in the history.
+ */
+template <class element_type, std::size_t capacity>
+std::size_t SignalHistory<element_type, capacity>::pendingCount(
+    const SignalCursor& cursor) {
+  std::size_t unreadCount =
+      putVersion.load(std::memory_order_relaxed) - cursor.nextSequence;
+  return unreadCount < elementCount ? unreadCount : elementCount;
+};
+
+/**
+ * @brief Reads the unread signals of a cursor without copying them and
+ * advances the cursor past them.
+ *
+ * The nth signal ever put lives in slot `n & INDEXMASK`, so the block starts
+ * at the slot of the cursor sequence number.
+ *
+ * @param cursor The cursor of the consumer.
+ * @param maxCount The maximum number of signals to read.
+ * @return One or two contiguous spans covering the signals, oldest first.
+ */
+template <class element_type, std::size_t capacity>
+SignalBlock<element_type> SignalHistory<element_type, capacity>::readNew(
+    SignalCursor& cursor, std::size_t maxCount) {
+  skipEvictedSignals(cursor);
+
+  std::size_t sampleCount = pendingCount(cursor);
+  if (sampleCount > maxCount) sampleCount = maxCount;
+
+  std::size_t startSlot = cursor.nextSequence & INDEXMASK;
+  std::size_t firstLength = capacity - startSlot;
+  if (firstLength > sampleCount) firstLength = sampleCount;
+
+  SignalBlock<element_type> block;
+  block.first.data = history + startSlot;
+  block.first.length = firstLength;
+  block.second.data = history;
+  block.second.length = sampleCount - firstLength;
+
+  cursor.nextSequence += static_cast<unsigned int>(sampleCount);
+  return block;
+};
+
+/**
+ * @brief Moves a cursor that fell behind the window to the oldest signal.
+ *
+ * Signals dropped by reset() count as overrun as well.
+ *
+ * @param cursor The cursor to check.
+ */
+template <class element_type, std::size_t capacity>
+void SignalHistory<element_type, capacity>::skipEvictedSignals(
+    SignalCursor& cursor) {
+  unsigned int newestSequence = putVersion.load(std::memory_order_relaxed);
+  unsigned int oldestSequence =
+      newestSequence - static_cast<unsigned int>(elementCount);
+  if (newestSequence - cursor.nextSequence > elementCount) {
+    cursor.overrunCount += oldestSequence - cursor.nextSequence;
+    cursor.nextSequence = oldestSequence;
+  }
 };
 
 /**
@@ -133,29 +514,140 @@ void SignalHistory<element_type>::reset() {
  *
  * @return The entry point index.
  *
- * This function returns the index where the next signal will be stored in the
- * history. If the history is not full, it returns the current size of the
- * history. Otherwise, it returns 0.
+ * This function returns the ring buffer slot where the next signal will be
+ * stored in the history, which is the slot right after the newest signal.
+ */
+template <class element_type, std::size_t capacity>
+element_type SignalHistory<element_type, capacity>::getEntryPointIndex() {
+  return slotOf(elementCount);
+};
+
+/**
+ * @brief Updates the entry point index.
+ *
+ * This function grows the history by one signal, or drops the oldest signal
+ * when the history already holds `maxElementsCount` signals.
  */
-template <class element_type>
-element_type SignalHistory<element_type>::getEntryPointIndex() {
-  // Return the index where the next signal will be stored in the history
-  // If the history is full, return 0
-  if (history.size() == history.max_size()) {
-    return 0;
+template <class element_type, std::size_t capacity>
+void SignalHistory<element_type, capacity>::updateEntryPointIndex() {
+  if (elementCount == maxElementsCount) {
+    oldestSlot = (oldestSlot + 1) & INDEXMASK;
   } else {
-    return history.size();
+    ++elementCount;
   }
 };
 
 /**
- * @brief Updates the entry point index.
+ * @brief Maps a position counted from the oldest signal to a ring slot.
  *
- * This function is not needed because the entry point index is automatically
- * updated when a signal is added to the history.
+ * @param nthSample The position counted from the oldest signal.
+ * @return The ring buffer slot holding that signal.
  */
-template <class element_type>
-void SignalHistory<element_type>::updateEntryPointIndex(){
-    // The entry point index is automatically updated when a signal is added to
-    // the history
+template <class element_type, std::size_t capacity>
+std::size_t SignalHistory<element_type, capacity>::slotOf(
+    std::size_t nthSample) const {
+  return (oldestSlot + nthSample) & INDEXMASK;
+};
+
+/**
+ * @brief Removes an evicted history slot from the front of an extremum queue.
+ *
+ * Only the front of the queue can hold the oldest signal, so the evicted slot
+ * is dropped if and only if it is at the front.
+ *
+ * @param queue The extremum queue to update.
+ * @param evictedSlot The history slot of the signal being evicted.
+ */
+template <class element_type, std::size_t capacity>
+void SignalHistory<element_type, capacity>::popEvictedSlot(
+    monotonic_slot_queue_data_type& queue, std::size_t evictedSlot) {
+  if (queue.count != 0 && queue.slots[queue.head] == evictedSlot) {
+    queue.head = (queue.head + 1) & INDEXMASK;
+    --queue.count;
+  }
+};
+
+/**
+ * @brief Appends a history slot to an extremum queue.
+ *
+ * Every queued signal that is not smaller (or not larger) than the newest
+ * signal is dropped from the back first, because it will leave the window
+ * before the newest signal and can never be the extremum again. Each slot is
+ * pushed and popped once, so the cost is O(1) amortized per put().
+ *
+ * @param queue The extremum queue to update.
+ * @param newSlot The history slot of the newest signal.
+ * @param keepSmallest `true` for the min() queue, `false` for the max() queue.
+ */
+template <class element_type, std::size_t capacity>
+void SignalHistory<element_type, capacity>::pushSlot(
+    monotonic_slot_queue_data_type& queue, std::size_t newSlot,
+    bool keepSmallest) {
+  element_type newSignal = history[newSlot];
+  while (queue.count != 0) {
+    element_type backSignal =
+        history[queue.slots[(queue.head + queue.count - 1) & INDEXMASK]];
+    bool backIsDominated =
+        keepSmallest ? !(backSignal < newSignal) : !(newSignal < backSignal);
+    if (!backIsDominated) break;
+    --queue.count;
+  }
+  queue.slots[(queue.head + queue.count) & INDEXMASK] = newSlot;
+  ++queue.count;
+};
+
+/**
+ * @brief Updates the running mean and sum of squared deviations.
+ *
+ * This uses Welford's update while the history grows, and its sliding-window
+ * form (replace the evicted signal with the new one at a constant count) once
+ * the history is full. Both avoid the cancellation of a plain sum of squares.
+ *
+ * @param newSignal The signal being added.
+ * @param evictedSignal The signal being evicted, ignored if the history is not
+ * full.
+ */
+template <class element_type, std::size_t capacity>
+void SignalHistory<element_type, capacity>::updateRunningStatistics(
+    element_type newSignal, element_type evictedSignal) {
+  element_type previousMean = runningMean;
+
+  if (elementCount < maxElementsCount) {
+    element_type count = static_cast<element_type>(elementCount + 1);
+    runningMean += (newSignal - previousMean) / count;
+    runningSquaredError +=
+        (newSignal - previousMean) * (newSignal - runningMean);
+  } else {
+    element_type count = static_cast<element_type>(elementCount);
+    runningMean += (newSignal - evictedSignal) / count;
+    runningSquaredError += (newSignal - evictedSignal) *
+                           (newSignal - runningMean + evictedSignal -
+                            previousMean);
+    ++evictionsSinceResync;
+  }
+
+  // Rounding may push the sum of squared deviations slightly below zero
+  if (runningSquaredError < 0) runningSquaredError = 0;
+};
+
+/**
+ * @brief Recomputes the running mean and sum of squared deviations from the
+ * stored signals.
+ *
+ * This is called once per `maxElementsCount` evictions, so its O(n) cost is
+ * O(1) amortized per put().
+ */
+template <class element_type, std::size_t capacity>
+void SignalHistory<element_type, capacity>::resyncRunningStatistics() {
+  element_type total = 0;
+  for (std::size_t i = 0; i < elementCount; ++i) total += history[slotOf(i)];
+  runningMean = total / static_cast<element_type>(elementCount);
+
+  element_type squaredError = 0;
+  for (std::size_t i = 0; i < elementCount; ++i) {
+    element_type deviation = history[slotOf(i)] - runningMean;
+    squaredError += deviation * deviation;
+  }
+  runningSquaredError = squaredError;
+  evictionsSinceResync = 0;
 };
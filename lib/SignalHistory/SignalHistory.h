@@ -1,31 +1,72 @@
 #ifndef SIGNAL_HISTORY_H
 #define SIGNAL_HISTORY_H
 
-#include <deque>
-#include <vector>
+#include <atomic>
+#include <cstddef>
 
+#include "signal_history/SignalCursorInterface.h"
 #include "signal_history/SignalHistoryInterface.h"
+#include "signal_history/SignalSnapshotInterface.h"
 
 /**
  * @brief Template class for storing history of discrete signal intensity.
  *
+ * The history is a fixed-capacity ring buffer that lives inside the object, so
+ * no heap allocation happens after construction and the RAM used by a history
+ * is known at compile time. Once the history holds `maxElementsCount` signals,
+ * every new signal overwrites the oldest one.
+ *
+ * The nth signal ever put is stored in ring slot `n & (capacity - 1)`, so the
+ * `capacity - maxElementsCount` slots outside the window delay overwriting.
+ * Snapshots of the whole window stay valid for that many put() calls, and a
+ * snapshot of fewer signals for longer.
+ *
  * @tparam element_type The type of the signals.
- * @tparam ARRAYSIZE The maximum size of the history.
+ * @tparam capacity The maximum size of the history, must be a power of two.
  */
-template <class element_type>
-class SignalHistory : public SignalHistoryInterface<element_type> {
+template <class element_type, std::size_t capacity = 512>
+class SignalHistory : public SignalHistoryInterface<element_type>,
+                      public SignalSnapshotInterface<element_type>,
+                      public SignalCursorInterface<element_type> {
+  static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0,
+                "SignalHistory capacity must be a power of two");
+
  public:
   /**
    * @brief Constructs a new SignalHistory object.
    *
-   * This constructor initializes an empty vector with a capacity of ARRAYSIZE.
+   * This constructor initializes an empty history that keeps up to `capacity`
+   * signals.
    */
   SignalHistory();
 
+  /**
+   * @brief Constructs a new SignalHistory object with a shorter window.
+   *
+   * @param maxElementsCount The number of signals kept before the oldest one
+   * is evicted. It is clamped to the range [1, capacity].
+   */
+  explicit SignalHistory(std::size_t maxElementsCount);
+
+  /**
+   * @brief Constructs a copy of another history, including its version.
+   *
+   * @param other The history to copy.
+   */
+  SignalHistory(const SignalHistory& other);
+
+  /**
+   * @brief Replaces this history with a copy of another one.
+   *
+   * @param other The history to copy.
+   * @return This history.
+   */
+  SignalHistory& operator=(const SignalHistory& other);
+
   /**
    * @brief Destructs a new SignalHistory object.
    *
-   * This Destructor deletes vector attributes of the class instance.
+   * The ring buffer is a member array, so nothing has to be freed.
    */
   ~SignalHistory();
 
@@ -34,26 +75,58 @@ class SignalHistory : public SignalHistoryInterface<element_type> {
    *
    * @param signal The signal to be added to the history.
    *
-   * If the history is full, remove the oldest signal before adding the new one.
+   * If the history is full, the oldest signal is overwritten by the new one.
    */
   void put(element_type signal) override;
 
   /**
    * @brief Retrieves a signal from the history.
    *
-   * @param nthSample The index of the signal to be retrieved from the history.
+   * @param nthSample The index of the signal to be retrieved from the history,
+   * where 0 is the oldest signal.
    * @return The signal at the given index.
    *
-   * This function uses the at function to access the signal at the given index.
-   * If the index is out of range, it throws an std::out_of_range exception.
+   * If the index is out of range, it throws an std::invalid_argument exception
+   * in the unit test build.
    */
   element_type get(element_type nthSample) override;
 
+  /**
+   * @brief Retrieves a signal from the history by integer index.
+   *
+   * @param nthSample The index of the signal, where 0 is the oldest signal.
+   * @return The signal at the given index.
+   */
+  element_type getSample(std::size_t nthSample) override;
+
+  /**
+   * @brief Exposes consecutive signals of the ring buffer without copying
+   * them.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the block.
+   * @return One or two contiguous spans covering the signals, oldest first.
+   */
+  SignalBlock<element_type> getBlock(std::size_t firstSample,
+                                     std::size_t sampleCount) override;
+
+  /**
+   * @brief Copies consecutive signals of the history to a buffer.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals to copy.
+   * @param destination The buffer receiving the signals, oldest first.
+   */
+  void copyBlock(std::size_t firstSample, std::size_t sampleCount,
+                 element_type* destination) override;
+
   /**
    * @brief Retrieves the smallest signal from the history.
    *
    * @return The smallest signal value.
    *
+   * The smallest signal is kept at the front of a monotonic queue, so this
+   * function runs in O(1).
    */
   element_type min() override;
 
@@ -62,9 +135,48 @@ class SignalHistory : public SignalHistoryInterface<element_type> {
    *
    * @return The largest signal value.
    *
+   * The largest signal is kept at the front of a monotonic queue, so this
+   * function runs in O(1).
    */
   element_type max() override;
 
+  /**
+   * @brief Retrieves the sum of the signals in the history.
+   *
+   * @return The sum of the signals.
+   *
+   * Derived from the running mean, so this function runs in O(1).
+   */
+  element_type sum() override;
+
+  /**
+   * @brief Retrieves the mean (DC component) of the signals in the history.
+   *
+   * @return The mean of the signals.
+   *
+   * The mean is updated on every put(), so this function runs in O(1).
+   */
+  element_type mean() override;
+
+  /**
+   * @brief Retrieves the sum of the squared signals in the history.
+   *
+   * @return The sum of the squared signals.
+   *
+   * Derived from the running mean and variance, so this function runs in O(1).
+   */
+  element_type sumOfSquares() override;
+
+  /**
+   * @brief Retrieves the population variance of the signals in the history.
+   *
+   * @return The variance of the signals.
+   *
+   * The sum of squared deviations is updated on every put(), so this function
+   * runs in O(1).
+   */
+  element_type variance() override;
+
   /**
    * @brief Retrieves the number of samples stored for history.
    *
@@ -80,30 +192,163 @@ class SignalHistory : public SignalHistoryInterface<element_type> {
    */
   void reset() override;
 
+  /**
+   * @brief Retrieves the number of signals ever put into the history.
+   *
+   * @return The version of the history, it changes on every put() and
+   * reset(). Safe to call while another context puts signals.
+   */
+  unsigned int version() override;
+
+  /**
+   * @brief Takes a snapshot of the newest signals without copying them.
+   *
+   * @param sampleCount The number of signals wanted, clamped to the window.
+   * @return The snapshot. Safe to call while another context puts signals.
+   */
+  SignalSnapshot<element_type> getSnapshot(std::size_t sampleCount) override;
+
+  /**
+   * @brief Checks that none of the signals of a snapshot has been overwritten.
+   *
+   * @param snapshot A snapshot of this history.
+   * @return `true` if everything read from the snapshot so far is consistent.
+   * Safe to call while another context puts signals.
+   */
+  bool isSnapshotValid(const SignalSnapshot<element_type>& snapshot) override;
+
+  /**
+   * @brief Creates a cursor positioned at the oldest signal of the history.
+   *
+   * @return The cursor.
+   */
+  SignalCursor openCursor() override;
+
+  /**
+   * @brief Counts the signals a cursor has not read yet.
+   *
+   * @param cursor The cursor of the consumer.
+   * @return The number of unread signals still in the history.
+   */
+  std::size_t pendingCount(const SignalCursor& cursor) override;
+
+  /**
+   * @brief Reads the unread signals of a cursor without copying them and
+   * advances the cursor past them.
+   *
+   * @param cursor The cursor of the consumer.
+   * @param maxCount The maximum number of signals to read.
+   * @return One or two contiguous spans covering the signals, oldest first.
+   */
+  SignalBlock<element_type> readNew(SignalCursor& cursor,
+                                    std::size_t maxCount) override;
+
  private:
   /**
    * @brief Gets the entry point index.
    *
    * @return The entry point index.
    *
-   * This function returns the index where the next signal will be stored in the
-   * history. If the history is not full, it returns the current size of the
-   * history. Otherwise, it returns 0.
+   * This function returns the ring buffer slot where the next signal will be
+   * stored in the history.
    */
   element_type getEntryPointIndex() override;
 
   /**
    * @brief Updates the entry point index.
    *
-   * This function is not needed because the entry point index is automatically
-   * updated when a signal is added to the history.
+   * This function advances the ring buffer after a signal has been written to
+   * the entry point, evicting the oldest signal when the history is full.
    */
   void updateEntryPointIndex() override;
 
+  /**
+   * @brief Maps a position counted from the oldest signal to a ring slot.
+   *
+   * @param nthSample The position counted from the oldest signal.
+   * @return The ring buffer slot holding that signal.
+   */
+  std::size_t slotOf(std::size_t nthSample) const;
+
+  /**
+   * @brief Moves a cursor that fell behind the window to the oldest signal.
+   *
+   * @param cursor The cursor to check, its overrun count grows by the number
+   * of skipped signals.
+   */
+  void skipEvictedSignals(SignalCursor& cursor);
+
+  /**
+   * @brief Ring of history slots whose signals are monotonic from front to
+   * back, used to answer min() and max() of the sliding window in O(1).
+   */
+  typedef struct MonotonicSlotQueue {
+    std::size_t slots[capacity];  // Ring of history slots, oldest first
+    std::size_t head;             // Position of the front slot
+    std::size_t count;            // Number of queued slots
+  } monotonic_slot_queue_data_type;
+
+  /**
+   * @brief Removes an evicted history slot from the front of an extremum
+   * queue.
+   *
+   * @param queue The extremum queue to update.
+   * @param evictedSlot The history slot of the signal being evicted.
+   */
+  void popEvictedSlot(monotonic_slot_queue_data_type& queue,
+                      std::size_t evictedSlot);
+
+  /**
+   * @brief Appends a history slot to an extremum queue, dropping every queued
+   * signal that can no longer be the extremum of the window.
+   *
+   * @param queue The extremum queue to update.
+   * @param newSlot The history slot of the newest signal.
+   * @param keepSmallest `true` for the min() queue, `false` for the max()
+   * queue.
+   */
+  void pushSlot(monotonic_slot_queue_data_type& queue, std::size_t newSlot,
+                bool keepSmallest);
+
+  /**
+   * @brief Updates the running mean and sum of squared deviations for a new
+   * signal, replacing the evicted signal when the history is full.
+   *
+   * @param newSignal The signal being added.
+   * @param evictedSignal The signal being evicted, ignored if the history is
+   * not full.
+   */
+  void updateRunningStatistics(element_type newSignal,
+                               element_type evictedSignal);
+
+  /**
+   * @brief Recomputes the running mean and sum of squared deviations from the
+   * stored signals with a two-pass sum, discarding accumulated rounding error.
+   */
+  void resyncRunningStatistics();
+
  private:
-  std::deque<element_type> history;  // The history of signals
+  static const std::size_t INDEXMASK = capacity - 1;
+
+  element_type history[capacity];  // The ring buffer of signals
+  std::size_t oldestSlot;          // Ring slot of the oldest signal
+  std::size_t elementCount;        // Number of signals in the history
+  std::size_t maxElementsCount;    // Number of signals kept before eviction
+
+  monotonic_slot_queue_data_type minSlotQueue;  // Increasing signals
+  monotonic_slot_queue_data_type maxSlotQueue;  // Decreasing signals
+
+  element_type runningMean;          // Mean of the signals in the window
+  element_type runningSquaredError;  // Sum of squared deviations from the mean
+  std::size_t evictionsSinceResync;  // Evictions since the last resync
+
+  std::atomic<unsigned int> writeVersion;  // Signals ever put or being put
+  std::atomic<unsigned int> putVersion;    // Signals ever put, published last
+  std::atomic<unsigned int> resetVersion;  // Version at the last reset()
 };
 
 template class SignalHistory<double>;
+// Capacity of the PPG histories allocated by `EventController`.
+template class SignalHistory<double, 64>;
 
 #endif
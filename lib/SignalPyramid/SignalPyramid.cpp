@@ -0,0 +1,229 @@
+#include "SignalPyramid.h"
+
+#ifdef UNIT_TEST
+#include <stdexcept>  // std::invalid_argument
+#endif
+
+/**
+ * @brief Constructs an empty SignalPyramid object that keeps up to `capacity`
+ * signals.
+ */
+template <class element_type, std::size_t capacity>
+SignalPyramid<element_type, capacity>::SignalPyramid()
+    : oldestSlot(0), elementCount(0), maxElementsCount(capacity) {
+  reset();
+};
+
+/**
+ * @brief Constructs an empty SignalPyramid object with a shorter window.
+ *
+ * @param maxElementsCount The number of signals kept before the oldest one is
+ * evicted. It is clamped to the range [1, capacity].
+ */
+template <class element_type, std::size_t capacity>
+SignalPyramid<element_type, capacity>::SignalPyramid(
+    std::size_t maxElementsCount)
+    : oldestSlot(0), elementCount(0), maxElementsCount(maxElementsCount) {
+#ifdef UNIT_TEST
+  if (maxElementsCount == 0 || maxElementsCount > capacity) {
+    throw std::invalid_argument(
+        "maxElementsCount must be between 1 and the pyramid capacity");
+  }
+#endif
+  if (this->maxElementsCount == 0) this->maxElementsCount = 1;
+  if (this->maxElementsCount > capacity) this->maxElementsCount = capacity;
+  reset();
+};
+
+/**
+ * @brief Destructs a SignalPyramid object.
+ *
+ * The tree is a member array, so there's no need to free anything.
+ */
+template <class element_type, std::size_t capacity>
+SignalPyramid<element_type, capacity>::~SignalPyramid(){
+    // The tree is released together with the object
+};
+
+/**
+ * @brief Adds a signal to the window, evicting the oldest one when full.
+ *
+ * The leaf of the entry slot is overwritten and its ancestors are recomputed
+ * from their two children.
+ *
+ * @param signal The signal to be added.
+ */
+template <class element_type, std::size_t capacity>
+void SignalPyramid<element_type, capacity>::put(element_type signal) {
+  std::size_t node = capacity + ((oldestSlot + elementCount) & INDEXMASK);
+  minTree[node] = signal;
+  maxTree[node] = signal;
+  sumTree[node] = signal;
+
+  for (node >>= 1; node != 0; node >>= 1) {
+    std::size_t left = 2 * node;
+    std::size_t right = left + 1;
+    minTree[node] = minTree[right] < minTree[left] ? minTree[right]
+                                                   : minTree[left];
+    maxTree[node] = maxTree[left] < maxTree[right] ? maxTree[right]
+                                                   : maxTree[left];
+    sumTree[node] = sumTree[left] + sumTree[right];
+  }
+
+  if (elementCount == maxElementsCount) {
+    oldestSlot = (oldestSlot + 1) & INDEXMASK;
+  } else {
+    ++elementCount;
+  }
+};
+
+/**
+ * @brief Retrieves the smallest signal of a range.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals in the range, at least 1.
+ * @return The smallest signal of the range.
+ */
+template <class element_type, std::size_t capacity>
+element_type SignalPyramid<element_type, capacity>::rangeMin(
+    std::size_t firstSample, std::size_t sampleCount) {
+  return summarize(firstSample, sampleCount).min;
+};
+
+/**
+ * @brief Retrieves the largest signal of a range.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals in the range, at least 1.
+ * @return The largest signal of the range.
+ */
+template <class element_type, std::size_t capacity>
+element_type SignalPyramid<element_type, capacity>::rangeMax(
+    std::size_t firstSample, std::size_t sampleCount) {
+  return summarize(firstSample, sampleCount).max;
+};
+
+/**
+ * @brief Retrieves the mean of a range.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals in the range, at least 1.
+ * @return The mean of the range.
+ */
+template <class element_type, std::size_t capacity>
+element_type SignalPyramid<element_type, capacity>::rangeMean(
+    std::size_t firstSample, std::size_t sampleCount) {
+  return summarize(firstSample, sampleCount).sum /
+         static_cast<element_type>(sampleCount);
+};
+
+/**
+ * @brief Retrieves the number of signals in the window.
+ *
+ * @return The number of signals in the window.
+ */
+template <class element_type, std::size_t capacity>
+std::size_t SignalPyramid<element_type, capacity>::size() {
+  return elementCount;
+};
+
+/**
+ * @brief Clears the window.
+ */
+template <class element_type, std::size_t capacity>
+void SignalPyramid<element_type, capacity>::reset() {
+  for (std::size_t i = 0; i < 2 * capacity; ++i) {
+    minTree[i] = 0;
+    maxTree[i] = 0;
+    sumTree[i] = 0;
+  }
+  oldestSlot = 0;
+  elementCount = 0;
+};
+
+/**
+ * @brief Checks that a range lies inside the window in the unit test build.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals in the range.
+ */
+template <class element_type, std::size_t capacity>
+void SignalPyramid<element_type, capacity>::checkRange(
+    std::size_t firstSample, std::size_t sampleCount) {
+#ifdef UNIT_TEST
+  if (sampleCount == 0 || firstSample > elementCount ||
+      sampleCount > elementCount - firstSample) {
+    throw std::invalid_argument("Range is out of the pyramid window");
+  }
+#else
+  (void)firstSample;
+  (void)sampleCount;
+#endif
+};
+
+/**
+ * @brief Combines the nodes covering a range of the window.
+ *
+ * A range that wraps around the end of the ring is split into two runs of
+ * slots.
+ *
+ * @param firstSample The index of the first signal, where 0 is the oldest.
+ * @param sampleCount The number of signals in the range, at least 1.
+ * @return The summary of the range.
+ */
+template <class element_type, std::size_t capacity>
+typename SignalPyramid<element_type, capacity>::pyramid_summary_data_type
+SignalPyramid<element_type, capacity>::summarize(std::size_t firstSample,
+                                                 std::size_t sampleCount) {
+  checkRange(firstSample, sampleCount);
+
+  std::size_t firstSlot = (oldestSlot + firstSample) & INDEXMASK;
+  pyramid_summary_data_type summary;
+  summary.min = minTree[capacity + firstSlot];
+  summary.max = maxTree[capacity + firstSlot];
+  summary.sum = 0;
+
+  if (firstSlot + sampleCount <= capacity) {
+    summarizeSlots(summary, firstSlot, firstSlot + sampleCount);
+  } else {
+    summarizeSlots(summary, firstSlot, capacity);
+    summarizeSlots(summary, 0, firstSlot + sampleCount - capacity);
+  }
+  return summary;
+};
+
+/**
+ * @brief Combines the nodes covering a run of slots that does not wrap.
+ *
+ * Walks both ends of the run up the tree, merging a node whenever it is a
+ * right child on the left end or a left child on the right end.
+ *
+ * @param summary The summary to merge the run into.
+ * @param firstSlot The first slot of the run.
+ * @param endSlot The slot after the last slot of the run.
+ */
+template <class element_type, std::size_t capacity>
+void SignalPyramid<element_type, capacity>::summarizeSlots(
+    pyramid_summary_data_type& summary, std::size_t firstSlot,
+    std::size_t endSlot) {
+  std::size_t left = capacity + firstSlot;
+  std::size_t right = capacity + endSlot;
+  for (; left < right; left >>= 1, right >>= 1) {
+    if (left & 1) mergeNode(summary, left++);
+    if (right & 1) mergeNode(summary, --right);
+  }
+};
+
+/**
+ * @brief Merges a tree node into a summary.
+ *
+ * @param summary The summary to update.
+ * @param node The index of the tree node.
+ */
+template <class element_type, std::size_t capacity>
+void SignalPyramid<element_type, capacity>::mergeNode(
+    pyramid_summary_data_type& summary, std::size_t node) {
+  if (minTree[node] < summary.min) summary.min = minTree[node];
+  if (summary.max < maxTree[node]) summary.max = maxTree[node];
+  summary.sum += sumTree[node];
+};
@@ -0,0 +1,162 @@
+#ifndef SIGNAL_PYRAMID_H
+#define SIGNAL_PYRAMID_H
+
+#include <cstddef>
+
+#include "signal_history/SignalPyramidInterface.h"
+
+/**
+ * @brief Min/max/sum pyramid over a sliding window of signals.
+ *
+ * The pyramid is a complete binary tree over the ring buffer slots. Level 0
+ * holds the signals themselves and every node above holds the min, max and
+ * sum of the 2^k slots below it. put() rewrites one leaf and its log2(capacity)
+ * ancestors, and a range query combines at most two nodes per level. Sums are
+ * recomputed from the children on every update, so they never drift.
+ *
+ * It is meant to be fed next to a `SignalHistory` with the same window, e.g.
+ * to draw a zoomed-out waveform envelope one column per range query.
+ *
+ * @tparam element_type The type of the signals.
+ * @tparam capacity The maximum size of the window, must be a power of two.
+ */
+template <class element_type, std::size_t capacity = 512>
+class SignalPyramid : public SignalPyramidInterface<element_type> {
+  static_assert(capacity > 0 && (capacity & (capacity - 1)) == 0,
+                "SignalPyramid capacity must be a power of two");
+
+ public:
+  /**
+   * @brief Constructs an empty SignalPyramid object that keeps up to
+   * `capacity` signals.
+   */
+  SignalPyramid();
+
+  /**
+   * @brief Constructs an empty SignalPyramid object with a shorter window.
+   *
+   * @param maxElementsCount The number of signals kept before the oldest one
+   * is evicted. It is clamped to the range [1, capacity].
+   */
+  explicit SignalPyramid(std::size_t maxElementsCount);
+
+  /**
+   * @brief Destructs a SignalPyramid object.
+   */
+  ~SignalPyramid();
+
+  /**
+   * @brief Adds a signal to the window, evicting the oldest one when full.
+   *
+   * @param signal The signal to be added.
+   *
+   * This function runs in O(log capacity).
+   */
+  void put(element_type signal) override;
+
+  /**
+   * @brief Retrieves the smallest signal of a range in O(log capacity).
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the range, at least 1.
+   * @return The smallest signal of the range.
+   */
+  element_type rangeMin(std::size_t firstSample,
+                        std::size_t sampleCount) override;
+
+  /**
+   * @brief Retrieves the largest signal of a range in O(log capacity).
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the range, at least 1.
+   * @return The largest signal of the range.
+   */
+  element_type rangeMax(std::size_t firstSample,
+                        std::size_t sampleCount) override;
+
+  /**
+   * @brief Retrieves the mean of a range in O(log capacity).
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the range, at least 1.
+   * @return The mean of the range.
+   */
+  element_type rangeMean(std::size_t firstSample,
+                         std::size_t sampleCount) override;
+
+  /**
+   * @brief Retrieves the number of signals in the window.
+   *
+   * @return The number of signals in the window.
+   */
+  std::size_t size() override;
+
+  /**
+   * @brief Clears the window.
+   */
+  void reset() override;
+
+ private:
+  /**
+   * @brief Summary of a run of slots.
+   */
+  typedef struct PyramidSummary {
+    element_type min;  // Smallest signal of the run
+    element_type max;  // Largest signal of the run
+    element_type sum;  // Sum of the signals of the run
+  } pyramid_summary_data_type;
+
+  /**
+   * @brief Checks that a range lies inside the window in the unit test build.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the range.
+   */
+  void checkRange(std::size_t firstSample, std::size_t sampleCount);
+
+  /**
+   * @brief Combines the nodes covering a range of the window.
+   *
+   * @param firstSample The index of the first signal, where 0 is the oldest.
+   * @param sampleCount The number of signals in the range, at least 1.
+   * @return The summary of the range.
+   */
+  pyramid_summary_data_type summarize(std::size_t firstSample,
+                                      std::size_t sampleCount);
+
+  /**
+   * @brief Combines the nodes covering a run of slots that does not wrap.
+   *
+   * @param summary The summary to merge the run into.
+   * @param firstSlot The first slot of the run.
+   * @param endSlot The slot after the last slot of the run.
+   */
+  void summarizeSlots(pyramid_summary_data_type& summary,
+                      std::size_t firstSlot, std::size_t endSlot);
+
+  /**
+   * @brief Merges a tree node into a summary.
+   *
+   * @param summary The summary to update.
+   * @param node The index of the tree node.
+   */
+  void mergeNode(pyramid_summary_data_type& summary, std::size_t node);
+
+ private:
+  static const std::size_t INDEXMASK = capacity - 1;
+
+  // Tree nodes, 1 is the root and the leaves start at `capacity`. Node 0 is
+  // unused.
+  element_type minTree[2 * capacity];  // Smallest signal below each node
+  element_type maxTree[2 * capacity];  // Largest signal below each node
+  element_type sumTree[2 * capacity];  // Sum of the signals below each node
+
+  std::size_t oldestSlot;        // Ring slot of the oldest signal
+  std::size_t elementCount;      // Number of signals in the window
+  std::size_t maxElementsCount;  // Number of signals kept before eviction
+};
+
+template class SignalPyramid<double>;
+template class SignalPyramid<double, 64>;
+
+#endif
@@ -5,8 +5,7 @@
 
 #endif
 
-#include <cmath>    // for std::sqrt
-#include <numeric>  // for std::accumulate
+#include <cmath>  // for std::sqrt
 
 #include "signal_history/SignalHistoryInterface.h"
 
@@ -57,13 +56,6 @@ element_type SpO2Calculator<element_type>::calculateRValue(
   }
 #endif
 
-  // Define the literal
-  const element_type DEFAULTINITIALVALUE = 0;
-
-  // declare the variables
-  element_type sumOfRedSignals = DEFAULTINITIALVALUE;
-  element_type sumOfInfraRedSignals = DEFAULTINITIALVALUE;
-
 #ifdef UNIT_TEST
   // Check if the size of the objects is not zero before accessing their
   // elements
@@ -72,18 +64,9 @@ element_type SpO2Calculator<element_type>::calculateRValue(
   }
 #endif
 
-  // Populate the redData and infraredData vectors with data from the signal
-  // history objects
-  for (element_type i = 0; i < redInfraredSignalPtr->size(); i++) {
-    sumOfRedSignals += redInfraredSignalPtr->get(i);
-    sumOfInfraRedSignals += infraredSignalPtr->get(i);
-  }
-
-  // Calculate the DC component for red and infrared values
-  element_type redSignalAverage =
-      sumOfRedSignals / redInfraredSignalPtr->size();
-  element_type rinfraRedSignalAverage =
-      sumOfInfraRedSignals / infraredSignalPtr->size();
+  // The DC component of each channel is its running mean, O(1) per channel
+  element_type redSignalAverage = redInfraredSignalPtr->mean();
+  element_type rinfraRedSignalAverage = infraredSignalPtr->mean();
 
   // Calculate the ACrms for red and infrared values
   element_type redACrms =
@@ -129,6 +112,11 @@ element_type SpO2Calculator<element_type>::findSpO2Value(element_type RValue) {
 /**
  * @brief Calculate the root mean square of the AC component from the given
  * values and DC component.
+ *
+ * The mean square around `signalOffset` equals the variance plus the squared
+ * distance between the mean and the offset, so it comes straight from the
+ * running statistics of the history without another pass over the samples.
+ *
  * @param ppgSignalHistoryObjectPtr Pointer to the signal history object.
  * @param signalOffset The DC component of the signal.
  * @return The calculated root mean square of the AC component.
@@ -137,19 +125,8 @@ template <class element_type>
 element_type SpO2Calculator<element_type>::rootMeanSquare(
     SignalHistoryInterface<element_type>* ppgSignalHistoryObjectPtr,
     element_type signalOffset) {
-  // Define the literal
-  const element_type DEFAULTINITIALVALUE = 0;
-
-  element_type sum = DEFAULTINITIALVALUE;
-  element_type elementCountInHistoryObjectPtr =
-      ppgSignalHistoryObjectPtr->size();
-
-  for (size_t i = DEFAULTINITIALVALUE; i < elementCountInHistoryObjectPtr;
-       i++) {
-    element_type offsetted_element =
-        ppgSignalHistoryObjectPtr->get(i) - signalOffset;
-    sum += offsetted_element * offsetted_element;
-  }
+  element_type meanOffset = ppgSignalHistoryObjectPtr->mean() - signalOffset;
 
-  return std::sqrt(sum / elementCountInHistoryObjectPtr);
+  return std::sqrt(ppgSignalHistoryObjectPtr->variance() +
+                   meanOffset * meanOffset);
 };
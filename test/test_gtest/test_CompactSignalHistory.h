@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+
+#include "CompactSignalHistory.h"
+#include "SignalAlgebra.h"
+#include "SignalHistory.h"
+
+// Test case for signals surviving the conversion to codes
+TEST(CompactSignalHistoryTestCase1, PutAndGet) {
+  // Arrange
+  double adcStep = 3.3 / 4096;
+  CompactSignalHistory<double, std::uint16_t, 64> signalHistory(adcStep);
+
+  // Act
+  signalHistory.put(1.0);
+  signalHistory.putCode(4095);
+
+  // Assert
+  EXPECT_EQ(signalHistory.size(), 2);
+  EXPECT_NEAR(signalHistory.get(0), 1.0, adcStep / 2);
+  EXPECT_EQ(signalHistory.getCode(0), 1241);
+  EXPECT_DOUBLE_EQ(signalHistory.getSample(1), 4095 * adcStep);
+  EXPECT_THROW(signalHistory.getSample(2), std::invalid_argument);
+}
+
+// Test case for signals outside the code range being saturated
+TEST(CompactSignalHistoryTestCase2, PutSaturates) {
+  // Arrange
+  double fullScale = 2.0;
+  CompactSignalHistory<double, std::int16_t, 64> signalHistory(fullScale /
+                                                               32768);
+
+  // Act
+  signalHistory.put(5.0);
+  signalHistory.put(-5.0);
+  signalHistory.put(-0.5);
+
+  // Assert
+  EXPECT_EQ(signalHistory.getCode(0), 32767);
+  EXPECT_EQ(signalHistory.getCode(1), -32768);
+  EXPECT_EQ(signalHistory.getCode(2), -8192);
+}
+
+// Test case for Q31 codes matching a double history within a code step
+TEST(CompactSignalHistoryTestCase3, MatchesDoubleHistory) {
+  // Arrange
+  double codeStep = 4.0 / 2147483648.0;
+  CompactSignalHistory<double, std::int32_t, 64> compactHistory(codeStep, 0,
+                                                                50);
+  SignalHistory<double, 64> doubleHistory(50);
+
+  // Act and Assert
+  for (int i = 0; i < 300; ++i) {
+    double signal = 1.5 + 0.1 * std::sin(i * 0.3) - 0.05 * (i % 5);
+    compactHistory.put(signal);
+    doubleHistory.put(signal);
+    ASSERT_NEAR(compactHistory.min(), doubleHistory.min(), codeStep);
+    ASSERT_NEAR(compactHistory.max(), doubleHistory.max(), codeStep);
+    ASSERT_NEAR(compactHistory.mean(), doubleHistory.mean(), codeStep);
+    ASSERT_NEAR(compactHistory.variance(), doubleHistory.variance(), 1e-9);
+    ASSERT_NEAR(compactHistory.sum(), doubleHistory.sum(), 1e-6);
+    ASSERT_NEAR(compactHistory.sumOfSquares(), doubleHistory.sumOfSquares(),
+                1e-6);
+  }
+  EXPECT_EQ(compactHistory.size(), 50);
+}
+
+// Test case for block reads of a wrapped history
+TEST(CompactSignalHistoryTestCase4, CopyBlockWithWrap) {
+  // Arrange
+  CompactSignalHistory<double, std::uint16_t, 64> signalHistory(0.5, -10.0);
+  for (int i = 0; i < 100; ++i) {
+    signalHistory.putCode(static_cast<std::uint16_t>(i));
+  }
+  double copiedSignals[64];
+
+  // Act
+  signalHistory.copyBlock(0, 64, copiedSignals);
+  SignalBlock<std::uint16_t> codeBlock = signalHistory.getCodeBlock(0, 64);
+  SignalBlock<double> signalBlock = signalHistory.getBlock(0, 64);
+
+  // Assert
+  EXPECT_EQ(codeBlock.first.length + codeBlock.second.length, 64u);
+  EXPECT_EQ(codeBlock.first.data[0], 36);
+  ASSERT_EQ(signalBlock.first.length + signalBlock.second.length, 64u);
+  SignalView<double> signal(signalBlock);
+  for (std::size_t i = 0; i < 64; ++i) {
+    EXPECT_EQ(copiedSignals[i], -10.0 + 0.5 * (36 + i));
+    EXPECT_EQ(signal[i], copiedSignals[i]);
+  }
+}
+
+// Test case for invalid construction arguments
+TEST(CompactSignalHistoryTestCase5, InvalidArguments) {
+  // Act and Assert
+  typedef CompactSignalHistory<double, std::uint16_t, 64> AdcHistory;
+  EXPECT_THROW(AdcHistory(0.0), std::invalid_argument);
+  EXPECT_THROW(AdcHistory(1.0, 0.0, 65), std::invalid_argument);
+  EXPECT_THROW(AdcHistory(1.0).min(), std::runtime_error);
+}
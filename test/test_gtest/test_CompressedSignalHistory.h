@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "CompressedSignalHistory.h"
+
+// Builds ADC codes of a PPG-like waveform with a slow drift
+static std::vector<std::uint16_t> ppgLikeCodes(int codeCount) {
+  std::vector<std::uint16_t> codes;
+  for (int i = 0; i < codeCount; ++i) {
+    double wave = 40 * std::sin(2 * M_PI * i / 50.0) +
+                  10 * std::sin(2 * M_PI * i / 7.0) + 0.01 * i;
+    codes.push_back(static_cast<std::uint16_t>(2000 + std::lround(wave)));
+  }
+  return codes;
+}
+
+// Test case for signals surviving the conversion and the packing
+TEST(CompressedSignalHistoryTestCase1, PutAndGet) {
+  // Arrange
+  CompressedSignalHistory<double, 16, 8, 64> signalHistory(0.5, 1.0);
+  double signals[] = {1.0, 2.5, 1.5, 100.0, -3.0};
+
+  // Act
+  for (int i = 0; i < 4; ++i) {
+    for (double signal : signals) signalHistory.put(signal);
+  }
+
+  // Assert
+  ASSERT_EQ(signalHistory.size(), 20);
+  for (std::size_t i = 0; i < 20; ++i) {
+    double expected = signals[i % 5] < 1.0 ? 1.0 : signals[i % 5];
+    EXPECT_DOUBLE_EQ(signalHistory.getSample(i), expected);
+  }
+  EXPECT_DOUBLE_EQ(signalHistory.get(3), 100.0);
+  EXPECT_THROW(signalHistory.getSample(20), std::invalid_argument);
+  SignalBlock<double> block = signalHistory.getBlock(0, 20);
+  ASSERT_EQ(block.first.length + block.second.length, 20u);
+  for (std::size_t i = 0; i < block.first.length; ++i) {
+    EXPECT_DOUBLE_EQ(block.first.data[i], signalHistory.getSample(i));
+  }
+}
+
+// Test case for a full pool evicting the oldest blocks
+TEST(CompressedSignalHistoryTestCase2, EvictOldestBlocks) {
+  // Arrange
+  CompressedSignalHistory<double, 16, 8, 64> signalHistory(1.0);
+  std::vector<std::uint16_t> codes = ppgLikeCodes(1000);
+
+  // Act and Assert
+  for (std::size_t i = 0; i < codes.size(); ++i) {
+    signalHistory.putCode(codes[i]);
+
+    std::size_t size = static_cast<std::size_t>(signalHistory.size());
+    ASSERT_GE(size, 1u);
+    ASSERT_LE(signalHistory.packedByteCount(), 64u);
+    std::size_t first = i + 1 - size;
+    for (std::size_t j = 0; j < size; j += 5) {
+      ASSERT_EQ(signalHistory.getCode(j), codes[first + j]);
+    }
+    ASSERT_EQ(signalHistory.getCode(size - 1), codes[i]);
+  }
+}
+
+// Test case for statistics matching a scan of the stored signals
+TEST(CompressedSignalHistoryTestCase3, Statistics) {
+  // Arrange
+  double codeStep = 3.3 / 4096;
+  CompressedSignalHistory<double> signalHistory(codeStep);
+  std::vector<std::uint16_t> codes = ppgLikeCodes(5000);
+  for (std::uint16_t code : codes) signalHistory.putCode(code);
+  std::size_t size = static_cast<std::size_t>(signalHistory.size());
+  std::vector<double> signals(size);
+
+  // Act
+  signalHistory.copyBlock(0, size, signals.data());
+
+  // Assert
+  double expectedMin = signals[0];
+  double expectedMax = signals[0];
+  double expectedSum = 0;
+  double expectedSumOfSquares = 0;
+  for (double signal : signals) {
+    if (signal < expectedMin) expectedMin = signal;
+    if (signal > expectedMax) expectedMax = signal;
+    expectedSum += signal;
+    expectedSumOfSquares += signal * signal;
+  }
+  double expectedMean = expectedSum / size;
+  double expectedVariance = 0;
+  for (double signal : signals) {
+    expectedVariance += (signal - expectedMean) * (signal - expectedMean);
+  }
+  expectedVariance /= size;
+  EXPECT_EQ(signalHistory.min(), expectedMin);
+  EXPECT_EQ(signalHistory.max(), expectedMax);
+  EXPECT_NEAR(signalHistory.sum(), expectedSum, 1e-9);
+  EXPECT_NEAR(signalHistory.mean(), expectedMean, 1e-12);
+  EXPECT_NEAR(signalHistory.sumOfSquares(), expectedSumOfSquares, 1e-8);
+  EXPECT_NEAR(signalHistory.variance(), expectedVariance, 1e-12);
+}
+
+// Test case for PPG codes taking well under a byte per signal
+TEST(CompressedSignalHistoryTestCase4, CompressionRatio) {
+  // Arrange
+  CompressedSignalHistory<double> signalHistory(1.0);
+  std::vector<std::uint16_t> codes = ppgLikeCodes(4000);
+
+  // Act
+  for (std::uint16_t code : codes) signalHistory.putCode(code);
+
+  // Assert
+  // 64 closed blocks of 64 signals are kept, 8 bytes each as doubles
+  EXPECT_EQ(signalHistory.size(), 64 * 62 + 32);
+  double packedBytesPerSignal =
+      static_cast<double>(signalHistory.packedByteCount()) / (64 * 62);
+  EXPECT_LT(packedBytesPerSignal, 1.0);
+}
+
+// Test case for reset method
+TEST(CompressedSignalHistoryTestCase5, Reset) {
+  // Arrange
+  CompressedSignalHistory<double, 16, 8, 64> signalHistory(1.0);
+  for (int i = 0; i < 100; ++i) signalHistory.putCode(i);
+
+  // Act
+  signalHistory.reset();
+
+  // Assert
+  EXPECT_EQ(signalHistory.size(), 0);
+  EXPECT_EQ(signalHistory.packedByteCount(), 0u);
+  EXPECT_THROW(signalHistory.min(), std::runtime_error);
+}
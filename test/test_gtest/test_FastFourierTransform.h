@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "FastFourierTransform.h"
 
 // Test case for fastFourierTransform method
@@ -172,4 +175,563 @@ TEST(InverseFastFourierTransformTestCase2, FastFourierTransform) {
     EXPECT_EQ(realOutput, expectedRealOutput);
     EXPECT_EQ(imaginaryOutput, expectedImaginaryOutput);
   }
-}
\ No newline at end of file
+}
+
+// Test case for large transforms against a direct DFT
+TEST(FastFourierTransformTestCase4, FastFourierTransform) {
+  // Arrange
+  const unsigned int n = 256;
+  const double PI = acos(-1);
+  std::vector<double> realInput(n);
+  std::vector<double> imaginaryInput(n);
+  for (unsigned int i = 0; i < n; i++) {
+    realInput[i] = std::sin(0.3 * i) + 0.01 * i;
+    imaginaryInput[i] = std::cos(0.7 * i);
+  }
+  std::vector<double> realOutput;
+  std::vector<double> imaginaryOutput;
+
+  // Act
+  FastFourierTransform<double>* transform = new FastFourierTransform<double>();
+  transform->fastFourierTransform(&realInput, &imaginaryInput, &realOutput,
+                                  &imaginaryOutput);
+  delete transform;
+
+  // Assert
+  ASSERT_EQ(realOutput.size(), n);
+  for (unsigned int k = 0; k < n; k++) {
+    double expectedReal = 0;
+    double expectedImaginary = 0;
+    for (unsigned int i = 0; i < n; i++) {
+      double angle = -2 * PI * k * i / n;
+      expectedReal += realInput[i] * std::cos(angle) -
+                      imaginaryInput[i] * std::sin(angle);
+      expectedImaginary += realInput[i] * std::sin(angle) +
+                           imaginaryInput[i] * std::cos(angle);
+    }
+    EXPECT_NEAR(realOutput[k], expectedReal, 1e-9);
+    EXPECT_NEAR(imaginaryOutput[k], expectedImaginary, 1e-9);
+  }
+}
+
+// Test case for reusing cached plans across transform sizes
+TEST(FastFourierTransformTestCase5, FastFourierTransform) {
+  // Arrange
+  std::vector<double> shortInput = {1.0, 2.0, 3.0, 4.0};
+  std::vector<double> shortZeros(4, 0.0);
+  std::vector<double> longInput = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+  std::vector<double> longZeros(8, 0.0);
+  std::vector<double> firstReal, firstImaginary;
+  std::vector<double> longReal, longImaginary;
+  std::vector<double> secondReal, secondImaginary;
+  std::vector<double> pairInput = {1.0, 3.0};
+  std::vector<double> pairZeros(2, 0.0);
+  std::vector<double> pairReal, pairImaginary;
+
+  // Act
+  FastFourierTransform<double> transform;
+  transform.fastFourierTransform(&shortInput, &shortZeros, &firstReal,
+                                 &firstImaginary);
+  transform.fastFourierTransform(&longInput, &longZeros, &longReal,
+                                 &longImaginary);
+  transform.fastFourierTransform(&shortInput, &shortZeros, &secondReal,
+                                 &secondImaginary);
+  transform.fastFourierTransform(&pairInput, &pairZeros, &pairReal,
+                                 &pairImaginary);
+
+  // Assert
+  EXPECT_EQ(firstReal, secondReal);
+  EXPECT_EQ(firstImaginary, secondImaginary);
+  EXPECT_NEAR(longReal[0], 36.0, 1e-12);
+  EXPECT_NEAR(longReal[4], -4.0, 1e-12);
+  EXPECT_NEAR(longImaginary[2], 4.0, 1e-12);
+  ASSERT_EQ(pairReal.size(), 2u);
+  EXPECT_EQ(pairReal[0], 4.0);
+  EXPECT_EQ(pairReal[1], -2.0);
+}
+
+// Test case for realFastFourierTransform against the complex transform
+TEST(RealFastFourierTransformTestCase1, FastFourierTransform) {
+  // Arrange
+  std::vector<double> realInput = {1.0, 2.0, 3.0, 4.0, 5.0,
+                                   6.0, 7.0, 8.0, 9.0};
+  std::vector<double> imaginaryInput(realInput.size(), 0.0);
+  std::vector<double> expectedRealOutput, expectedImaginaryOutput;
+  std::vector<double> realOutput, imaginaryOutput;
+
+  // Act
+  FastFourierTransform<double> transform;
+  transform.fastFourierTransform(&realInput, &imaginaryInput,
+                                 &expectedRealOutput, &expectedImaginaryOutput);
+  transform.realFastFourierTransform(&realInput, &realOutput,
+                                     &imaginaryOutput);
+
+  // Assert
+  ASSERT_EQ(realOutput.size(), 9u);
+  ASSERT_EQ(imaginaryOutput.size(), 9u);
+  for (unsigned int i = 0; i < realOutput.size(); i++) {
+    EXPECT_NEAR(realOutput[i], expectedRealOutput[i], 1e-9);
+    EXPECT_NEAR(imaginaryOutput[i], expectedImaginaryOutput[i], 1e-9);
+  }
+}
+
+// Test case for realFastFourierTransform of the smallest inputs
+TEST(RealFastFourierTransformTestCase2, FastFourierTransform) {
+  // Arrange
+  std::vector<float> singleInput = {3.0f};
+  std::vector<float> pairInput = {1.0f, 3.0f};
+  std::vector<float> singleReal, singleImaginary, pairReal, pairImaginary;
+
+  // Act
+  FastFourierTransform<float> transform;
+  transform.realFastFourierTransform(&singleInput, &singleReal,
+                                     &singleImaginary);
+  transform.realFastFourierTransform(&pairInput, &pairReal, &pairImaginary);
+
+  // Assert
+  ASSERT_EQ(singleReal.size(), 1u);
+  EXPECT_EQ(singleReal[0], 3.0f);
+  EXPECT_EQ(singleImaginary[0], 0.0f);
+  ASSERT_EQ(pairReal.size(), 2u);
+  EXPECT_NEAR(pairReal[0], 4.0f, 1e-6);
+  EXPECT_NEAR(pairReal[1], -2.0f, 1e-6);
+  EXPECT_NEAR(pairImaginary[1], 0.0f, 1e-6);
+}
+
+// Test case for a round trip through the real transforms
+TEST(InverseRealFastFourierTransformTestCase1, FastFourierTransform) {
+  // Arrange
+  std::vector<double> realInput(64);
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    realInput[i] = std::sin(0.2 * i) + 0.5 * std::cos(1.3 * i) + 2.0;
+  }
+  std::vector<double> realSpectrum, imaginarySpectrum, realOutput;
+
+  // Act
+  FastFourierTransform<double> transform;
+  transform.realFastFourierTransform(&realInput, &realSpectrum,
+                                     &imaginarySpectrum);
+  transform.inverseRealFastFourierTransform(&realSpectrum, &imaginarySpectrum,
+                                            &realOutput);
+
+  // Assert
+  ASSERT_EQ(realSpectrum.size(), 33u);
+  ASSERT_EQ(realOutput.size(), realInput.size());
+  for (unsigned int i = 0; i < realOutput.size(); i++) {
+    EXPECT_NEAR(realOutput[i], realInput[i], 1e-12);
+  }
+}
+
+// Test case for inverseRealFastFourierTransform of a malformed spectrum
+TEST(InverseRealFastFourierTransformTestCase2, FastFourierTransform) {
+  // Arrange
+  std::vector<double> realInput = {1.0, 2.0, 3.0, 4.0};
+  std::vector<double> imaginaryInput = {0.0, 0.0, 0.0, 0.0};
+  std::vector<double> realOutput;
+
+  // Act & Assert
+  FastFourierTransform<double> transform;
+  EXPECT_THROW(transform.inverseRealFastFourierTransform(
+                   &realInput, &imaginaryInput, &realOutput),
+               std::invalid_argument);
+}
+
+// Test case for the radix-4 kernel with and without the radix-2 pass
+TEST(FastFourierTransformTestCase6, FastFourierTransform) {
+  // Arrange
+  const double PI = acos(-1);
+  FastFourierTransform<double> transform;
+
+  for (unsigned int n = 2; n <= 512; n *= 2) {
+    std::vector<double> realInput(n), imaginaryInput(n);
+    for (unsigned int i = 0; i < n; i++) {
+      realInput[i] = std::sin(1.1 * i) + 0.3;
+      imaginaryInput[i] = std::cos(0.4 * i * i);
+    }
+    std::vector<double> realOutput, imaginaryOutput;
+
+    // Act
+    transform.fastFourierTransform(&realInput, &imaginaryInput, &realOutput,
+                                   &imaginaryOutput);
+
+    // Assert
+    ASSERT_EQ(realOutput.size(), n);
+    for (unsigned int k = 0; k < n; k++) {
+      double expectedReal = 0;
+      double expectedImaginary = 0;
+      for (unsigned int i = 0; i < n; i++) {
+        double angle = -2 * PI * ((k * i) % n) / n;
+        expectedReal += realInput[i] * std::cos(angle) -
+                        imaginaryInput[i] * std::sin(angle);
+        expectedImaginary += realInput[i] * std::sin(angle) +
+                             imaginaryInput[i] * std::cos(angle);
+      }
+      EXPECT_NEAR(realOutput[k], expectedReal, 1e-9) << "n = " << n;
+      EXPECT_NEAR(imaginaryOutput[k], expectedImaginary, 1e-9) << "n = " << n;
+    }
+  }
+}
+
+// Test case for the split-radix kernel of large transforms
+TEST(FastFourierTransformTestCase7, FastFourierTransform) {
+  // Arrange
+  const double PI = acos(-1);
+  FastFourierTransform<double> transform;
+
+  for (unsigned int n = 1024; n <= 2048; n *= 2) {
+    std::vector<double> realInput(n), imaginaryInput(n);
+    for (unsigned int i = 0; i < n; i++) {
+      realInput[i] = std::sin(0.01 * i * i);
+      imaginaryInput[i] = std::cos(2.5 * i) - 0.2;
+    }
+    std::vector<double> realOutput, imaginaryOutput;
+
+    // Act
+    transform.fastFourierTransform(&realInput, &imaginaryInput, &realOutput,
+                                   &imaginaryOutput);
+
+    // Assert
+    ASSERT_EQ(realOutput.size(), n);
+    for (unsigned int k = 0; k < n; k += 7) {
+      double expectedReal = 0;
+      double expectedImaginary = 0;
+      for (unsigned int i = 0; i < n; i++) {
+        double angle = -2 * PI * ((k * i) % n) / n;
+        expectedReal += realInput[i] * std::cos(angle) -
+                        imaginaryInput[i] * std::sin(angle);
+        expectedImaginary += realInput[i] * std::sin(angle) +
+                             imaginaryInput[i] * std::cos(angle);
+      }
+      EXPECT_NEAR(realOutput[k], expectedReal, 1e-8) << "n = " << n;
+      EXPECT_NEAR(imaginaryOutput[k], expectedImaginary, 1e-8) << "n = " << n;
+    }
+  }
+}
+
+// Builds the bit-reversed split input and the twiddle table of a transform
+static void prepareButterflyKernelInput(unsigned int log2n,
+                                        std::vector<double>& real,
+                                        std::vector<double>& imaginary,
+                                        std::vector<double>& passTwiddles) {
+  const double PI = acos(-1);
+  const unsigned int n = 1u << log2n;
+  std::vector<std::complex<double>> twiddles(n / 2);
+  for (unsigned int k = 0; k < n / 2; k++) {
+    twiddles[k] = std::polar(1.0, -2 * PI * k / n);
+  }
+  passTwiddles.resize(radix4SplitTwiddleCount(log2n));
+  buildRadix4SplitTwiddles(twiddles.data(), log2n, passTwiddles.data());
+
+  real.assign(n, 0);
+  imaginary.assign(n, 0);
+  for (unsigned int i = 0; i < n; i++) {
+    unsigned int reversed = 0;
+    for (unsigned int bit = 0; bit < log2n; bit++) {
+      reversed |= ((i >> bit) & 1u) << (log2n - 1 - bit);
+    }
+    real[reversed] = std::sin(0.37 * i) + 0.1 * (i % 5);
+    imaginary[reversed] = std::cos(0.11 * i * i);
+  }
+}
+
+// Test case for the vector butterfly kernels against the scalar kernel
+TEST(ButterflyKernelsTestCase1, BitExactness) {
+  for (unsigned int log2n = 1; log2n <= 12; log2n++) {
+    // Arrange
+    std::vector<double> scalarReal, scalarImaginary, passTwiddles;
+    prepareButterflyKernelInput(log2n, scalarReal, scalarImaginary,
+                                passTwiddles);
+    radix4SplitButterflies(ScalarButterflyKernel, scalarReal.data(),
+                           scalarImaginary.data(), log2n, passTwiddles.data());
+
+    for (int level = SSE2ButterflyKernel; level <= activeButterflyKernelLevel();
+         level++) {
+      std::vector<double> real, imaginary;
+      prepareButterflyKernelInput(log2n, real, imaginary, passTwiddles);
+
+      // Act
+      radix4SplitButterflies(static_cast<ButterflyKernelLevel>(level),
+                             real.data(), imaginary.data(), log2n,
+                             passTwiddles.data());
+
+      // Assert
+      EXPECT_EQ(real, scalarReal) << "log2n = " << log2n;
+      EXPECT_EQ(imaginary, scalarImaginary) << "log2n = " << log2n;
+    }
+  }
+}
+
+// Test case for the dispatched transform against the scalar kernel
+TEST(ButterflyKernelsTestCase2, Tolerance) {
+  for (unsigned int log2n = 8; log2n <= 12; log2n++) {
+    // Arrange
+    const unsigned int n = 1u << log2n;
+    std::vector<double> expectedReal, expectedImaginary, passTwiddles;
+    prepareButterflyKernelInput(log2n, expectedReal, expectedImaginary,
+                                passTwiddles);
+    radix4SplitButterflies(ScalarButterflyKernel, expectedReal.data(),
+                           expectedImaginary.data(), log2n,
+                           passTwiddles.data());
+    std::vector<double> realInput(n), imaginaryInput(n);
+    for (unsigned int i = 0; i < n; i++) {
+      realInput[i] = std::sin(0.37 * i) + 0.1 * (i % 5);
+      imaginaryInput[i] = std::cos(0.11 * i * i);
+    }
+    std::vector<double> realOutput, imaginaryOutput;
+
+    // Act
+    FastFourierTransform<double> transform;
+    transform.fastFourierTransform(&realInput, &imaginaryInput, &realOutput,
+                                   &imaginaryOutput);
+
+    // Assert
+    ASSERT_EQ(realOutput.size(), n);
+    for (unsigned int k = 0; k < n; k++) {
+      EXPECT_NEAR(realOutput[k], expectedReal[k], 1e-10) << "n = " << n;
+      EXPECT_NEAR(imaginaryOutput[k], expectedImaginary[k], 1e-10)
+          << "n = " << n;
+    }
+  }
+}
+
+// Test case for the in-place transforms on a caller-owned buffer
+TEST(FastFourierTransformInPlaceTestCase1, FastFourierTransform) {
+  // Arrange
+  const unsigned int log2n = 5;
+  const unsigned int n = 1u << log2n;
+  std::vector<double> realInput(n), imaginaryInput(n);
+  std::complex<double> data[n];
+  for (unsigned int i = 0; i < n; i++) {
+    realInput[i] = std::sin(0.5 * i);
+    imaginaryInput[i] = 0.1 * i;
+    data[i] = std::complex<double>(realInput[i], imaginaryInput[i]);
+  }
+  std::vector<double> expectedReal, expectedImaginary;
+  FastFourierTransform<double> transform;
+  transform.fastFourierTransform(&realInput, &imaginaryInput, &expectedReal,
+                                 &expectedImaginary);
+
+  // Act
+  transform.fastFourierTransformInPlace(data, log2n);
+
+  // Assert
+  for (unsigned int k = 0; k < n; k++) {
+    EXPECT_EQ(data[k].real(), expectedReal[k]);
+    EXPECT_EQ(data[k].imag(), expectedImaginary[k]);
+  }
+
+  // Act
+  transform.inverseFastFourierTransformInPlace(data, log2n);
+
+  // Assert
+  for (unsigned int i = 0; i < n; i++) {
+    EXPECT_NEAR(data[i].real(), realInput[i], 1e-12);
+    EXPECT_NEAR(data[i].imag(), imaginaryInput[i], 1e-12);
+  }
+}
+
+// Test case for the in-place real transforms on a caller-owned buffer
+TEST(FastFourierTransformInPlaceTestCase2, FastFourierTransform) {
+  for (unsigned int log2n = 0; log2n <= 7; log2n++) {
+    // Arrange
+    const unsigned int n = 1u << log2n;
+    std::vector<double> realInput(n);
+    for (unsigned int i = 0; i < n; i++) {
+      realInput[i] = std::cos(0.9 * i) + 0.05 * i;
+    }
+    std::vector<std::complex<double>> data(n / 2 + 1);
+    double* samples = reinterpret_cast<double*>(data.data());
+    std::copy(realInput.begin(), realInput.end(), samples);
+    std::vector<double> expectedReal, expectedImaginary;
+    FastFourierTransform<double> transform;
+    transform.realFastFourierTransform(&realInput, &expectedReal,
+                                       &expectedImaginary);
+
+    // Act
+    transform.realFastFourierTransformInPlace(data.data(), log2n);
+
+    // Assert
+    ASSERT_EQ(expectedReal.size(), data.size());
+    for (unsigned int k = 0; k < data.size(); k++) {
+      EXPECT_NEAR(data[k].real(), expectedReal[k], 1e-12) << "n = " << n;
+      EXPECT_NEAR(data[k].imag(), expectedImaginary[k], 1e-12) << "n = " << n;
+    }
+
+    // Act
+    transform.inverseRealFastFourierTransformInPlace(data.data(), log2n);
+
+    // Assert
+    for (unsigned int i = 0; i < n; i++) {
+      EXPECT_NEAR(samples[i], realInput[i], 1e-12) << "n = " << n;
+    }
+  }
+}
+
+// Test case for large transforms split over a worker pool
+TEST(ParallelFastFourierTransformTestCase1, FastFourierTransform) {
+  // Arrange
+  const unsigned int log2n = 17;
+  const unsigned int n = 1u << log2n;
+  const double PI = std::acos(-1);
+  std::vector<std::complex<double>> input(n);
+  for (unsigned int i = 0; i < n; i++) {
+    double angle = 2 * PI * i / n;
+    input[i] = std::polar(1.0, 5 * angle) + std::polar(0.5, -300 * angle) +
+               std::complex<double>(0.25, 0);
+  }
+  std::vector<double> expectedReal(n, 0);
+  expectedReal[0] = 0.25 * n;
+  expectedReal[5] = n;
+  expectedReal[n - 300] = 0.5 * n;
+  std::vector<std::complex<double>> serialData(input), parallelData(input);
+  FastFourierTransform<double> serialTransform;
+  FastFourierTransform<double> parallelTransform(4);
+
+  // Act
+  serialTransform.fastFourierTransformInPlace(serialData.data(), log2n);
+  parallelTransform.fastFourierTransformInPlace(parallelData.data(), log2n);
+
+  // Assert
+  for (unsigned int k = 0; k < n; k++) {
+    ASSERT_NEAR(serialData[k].real(), expectedReal[k], 1e-6) << "k = " << k;
+    ASSERT_NEAR(serialData[k].imag(), 0, 1e-6) << "k = " << k;
+    ASSERT_EQ(parallelData[k], serialData[k]) << "k = " << k;
+  }
+
+  // Act
+  parallelTransform.inverseFastFourierTransformInPlace(parallelData.data(),
+                                                       log2n);
+
+  // Assert
+  for (unsigned int i = 0; i < n; i++) {
+    ASSERT_NEAR(parallelData[i].real(), input[i].real(), 1e-12);
+    ASSERT_NEAR(parallelData[i].imag(), input[i].imag(), 1e-12);
+  }
+}
+
+// Test case for large transforms on the scalar kernels split over a worker pool
+TEST(ParallelFastFourierTransformTestCase2, FastFourierTransform) {
+  // Arrange
+  const unsigned int log2n = 16;
+  const unsigned int n = 1u << log2n;
+  const double PI = std::acos(-1);
+  std::vector<std::complex<float>> input(n);
+  for (unsigned int i = 0; i < n; i++) {
+    input[i] = std::complex<float>(
+        static_cast<float>(std::cos(2 * PI * 7 * i / n)), 0);
+  }
+  std::vector<std::complex<float>> serialData(input), parallelData(input);
+  FastFourierTransform<float> serialTransform;
+  FastFourierTransform<float> parallelTransform(3);
+
+  // Act
+  serialTransform.fastFourierTransformInPlace(serialData.data(), log2n);
+  parallelTransform.fastFourierTransformInPlace(parallelData.data(), log2n);
+
+  // Assert
+  for (unsigned int k = 0; k < n; k++) {
+    float expected = k == 7 || k == n - 7 ? 0.5f * n : 0;
+    ASSERT_NEAR(serialData[k].real(), expected, 0.05) << "k = " << k;
+    ASSERT_NEAR(serialData[k].imag(), 0, 0.05) << "k = " << k;
+    ASSERT_EQ(parallelData[k], serialData[k]) << "k = " << k;
+  }
+}
+
+// Test case for exact size transforms against a direct DFT, covering the
+// mixed-radix sizes, the Bluestein sizes and a power of two
+TEST(ExactSizeFastFourierTransformTestCase1, FastFourierTransform) {
+  const double PI = std::acos(-1);
+  const unsigned int sizes[] = {1, 3, 5, 6, 7, 12, 15, 45, 50, 64, 97, 100};
+  FastFourierTransform<double> transform;
+  for (unsigned int n : sizes) {
+    // Arrange
+    std::vector<std::complex<double>> input(n);
+    for (unsigned int i = 0; i < n; i++) {
+      input[i] = std::complex<double>(std::sin(0.37 * i) + 0.1 * (i % 5),
+                                      std::cos(0.11 * i * i));
+    }
+    std::vector<std::complex<double>> data(input);
+
+    // Act
+    transform.exactSizeFastFourierTransformInPlace(data.data(), n);
+
+    // Assert
+    for (unsigned int k = 0; k < n; k++) {
+      std::complex<double> expected = 0;
+      for (unsigned int i = 0; i < n; i++) {
+        double angle = -2 * PI * ((static_cast<unsigned long>(i) * k) % n) / n;
+        expected += input[i] * std::polar(1.0, angle);
+      }
+      EXPECT_NEAR(data[k].real(), expected.real(), 1e-9) << "n = " << n;
+      EXPECT_NEAR(data[k].imag(), expected.imag(), 1e-9) << "n = " << n;
+    }
+
+    // Act
+    transform.inverseExactSizeFastFourierTransformInPlace(data.data(), n);
+
+    // Assert
+    for (unsigned int i = 0; i < n; i++) {
+      EXPECT_NEAR(data[i].real(), input[i].real(), 1e-12) << "n = " << n;
+      EXPECT_NEAR(data[i].imag(), input[i].imag(), 1e-12) << "n = " << n;
+    }
+  }
+}
+
+// Test case for the frequency grid of a 50 sample history, which a zero-padded
+// transform would spread over the bins of 64 points
+TEST(ExactSizeFastFourierTransformTestCase2, FastFourierTransform) {
+  // Arrange
+  const unsigned int n = 50;
+  const double PI = std::acos(-1);
+  std::vector<std::complex<float>> data(n);
+  for (unsigned int i = 0; i < n; i++) {
+    data[i] = std::complex<float>(
+        static_cast<float>(std::cos(2 * PI * 3 * i / n)), 0);
+  }
+  FastFourierTransform<float> fastFourierTransform;
+  FastFourierTransformInterface<float>* transform = &fastFourierTransform;
+
+  // Act
+  transform->exactSizeFastFourierTransformInPlace(data.data(), n);
+
+  // Assert
+  for (unsigned int k = 0; k < n; k++) {
+    float expected = k == 3 || k == n - 3 ? 0.5f * n : 0;
+    EXPECT_NEAR(data[k].real(), expected, 1e-4) << "k = " << k;
+    EXPECT_NEAR(data[k].imag(), 0, 1e-4) << "k = " << k;
+  }
+}
+
+// Test case for the four-step transform against the radix-2 one, with a square
+// and a rectangular matrix and with worker threads
+TEST(FourStepFastFourierTransformTestCase1, FastFourierTransform) {
+  for (unsigned int log2n = 12; log2n <= 13; log2n++) {
+    // Arrange
+    const unsigned int n = 1u << log2n;
+    std::vector<std::complex<double>> input(n);
+    for (unsigned int i = 0; i < n; i++) {
+      input[i] = std::complex<double>(std::sin(0.37 * i) + 0.1 * (i % 5),
+                                      std::cos(0.011 * i));
+    }
+    std::vector<std::complex<double>> expected(input), serialData(input),
+        parallelData(input);
+    FastFourierTransform<double> serialTransform;
+    FastFourierTransform<double> parallelTransform(3);
+    serialTransform.fastFourierTransformInPlace(expected.data(), log2n);
+
+    // Act
+    serialTransform.fourStepFastFourierTransformInPlace(serialData.data(),
+                                                        log2n);
+    parallelTransform.fourStepFastFourierTransformInPlace(parallelData.data(),
+                                                          log2n);
+
+    // Assert
+    for (unsigned int k = 0; k < n; k++) {
+      ASSERT_NEAR(serialData[k].real(), expected[k].real(), 1e-9)
+          << "n = " << n << ", k = " << k;
+      ASSERT_NEAR(serialData[k].imag(), expected[k].imag(), 1e-9)
+          << "n = " << n << ", k = " << k;
+      ASSERT_EQ(parallelData[k], serialData[k]) << "n = " << n;
+    }
+  }
+}
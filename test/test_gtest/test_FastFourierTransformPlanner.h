@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "FastFourierTransform.h"
+#include "FastFourierTransformPlanner.h"
+
+// Builds a fresh wisdom file path in the test temporary directory
+static std::string plannerWisdomPath(const char* name) {
+  std::string path = ::testing::TempDir() + name;
+  std::remove(path.c_str());
+  return path;
+}
+
+// Test case for the planned transforms against the radix-4 transform
+TEST(FastFourierTransformPlannerTestCase1, PlannedTransformsMatch) {
+  for (unsigned int log2n = 3; log2n <= 8; log2n++) {
+    // Arrange
+    const unsigned int n = 1u << log2n;
+    std::vector<std::complex<double>> input(n);
+    for (unsigned int i = 0; i < n; i++) {
+      input[i] = std::complex<double>(2.5 + std::sin(0.21 * i),
+                                      0.8 * std::sin(0.05 * i * i));
+    }
+    std::vector<std::complex<double>> expected = input;
+    FastFourierTransform<double> reference;
+    reference.fastFourierTransformInPlace(expected.data(), log2n);
+    std::vector<std::complex<double>> spectrum = input;
+    FastFourierTransformPlanner<double> planner;
+
+    // Act
+    planner.fastFourierTransformInPlace(spectrum.data(), log2n);
+    std::vector<std::complex<double>> roundTrip = spectrum;
+    planner.inverseFastFourierTransformInPlace(roundTrip.data(), log2n);
+
+    // Assert
+    double peak = 0;
+    for (unsigned int i = 0; i < n; i++) {
+      peak = std::max(peak, std::abs(expected[i]));
+    }
+    for (unsigned int i = 0; i < n; i++) {
+      EXPECT_NEAR(std::abs(spectrum[i] - expected[i]) / peak, 0, 1e-6)
+          << "log2n " << log2n << " kernel "
+          << FastFourierTransformPlanner<double>::getKernelName(
+                 planner.getKernel(log2n));
+      EXPECT_NEAR(std::abs(roundTrip[i] - input[i]), 0, 1e-5);
+    }
+  }
+}
+
+// Test case for the kernel of a size being measured once and kept
+TEST(FastFourierTransformPlannerTestCase2, KernelIsKept) {
+  // Arrange
+  FastFourierTransformPlanner<float> planner;
+
+  // Act
+  FastFourierTransformKernel fixedSizeKernel = planner.getKernel(6);
+  FastFourierTransformKernel otherKernel = planner.getKernel(5);
+
+  // Assert
+  EXPECT_EQ(planner.getKernel(6), fixedSizeKernel);
+  EXPECT_EQ(planner.getKernel(5), otherKernel);
+  EXPECT_NE(otherKernel, FixedSizeKernel);
+  EXPECT_NE(otherKernel, FourStepKernel);
+}
+
+// Test case for the choices read from and appended to the wisdom file
+TEST(FastFourierTransformPlannerTestCase3, WisdomFile) {
+  // Arrange
+  std::string path = plannerWisdomPath("fft_wisdom_3.txt");
+  std::FILE* file = std::fopen(path.c_str(), "w");
+  ASSERT_NE(file, nullptr);
+  std::fputs("8 7 FixedPoint\n", file);  // Kept
+  std::fputs("4 8 FixedPoint\n", file);  // Float choice, skipped
+  std::fputs("8 9 FixedSize\n", file);   // Not a candidate, skipped
+  std::fputs("8 4 Unknown\n", file);     // Unknown kernel, skipped
+  std::fputs("corrupted line\n", file);  // Skipped
+  std::fclose(file);
+
+  // Act
+  FastFourierTransformPlanner<double> planner(path.c_str());
+  FastFourierTransformKernel loadedKernel = planner.getKernel(7);
+  FastFourierTransformKernel measuredKernel = planner.getKernel(5);
+  FastFourierTransformPlanner<double> reopenedPlanner(path.c_str());
+
+  // Assert
+  EXPECT_EQ(loadedKernel, FixedPointKernel);
+  EXPECT_EQ(reopenedPlanner.getKernel(7), FixedPointKernel);
+  EXPECT_EQ(reopenedPlanner.getKernel(5), measuredKernel);
+  file = std::fopen(path.c_str(), "r");
+  ASSERT_NE(file, nullptr);
+  char line[64];
+  std::string lastLine;
+  while (std::fgets(line, sizeof(line), file) != nullptr) {
+    lastLine = line;
+  }
+  std::fclose(file);
+  EXPECT_EQ(lastLine,
+            std::string("8 5 ") +
+                FastFourierTransformPlanner<double>::getKernelName(
+                    measuredKernel) +
+                "\n");
+}
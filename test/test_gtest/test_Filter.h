@@ -121,3 +121,55 @@ TEST_F(FilterTest, ProcessTestMixed) {
   delete input;
   delete output;
 }
+
+// Records the transforms a filter runs before running them
+class RecordingFastFourierTransform : public FastFourierTransform<double> {
+ public:
+  void exactSizeFastFourierTransformInPlace(std::complex<double>* data,
+                                            std::size_t size) override {
+    complexTransformCount++;
+    lastInput.assign(data, data + size);
+    FastFourierTransform<double>::exactSizeFastFourierTransformInPlace(data,
+                                                                       size);
+  }
+
+  void realFastFourierTransformInPlace(std::complex<double>* data,
+                                       unsigned int log2n) override {
+    realTransformCount++;
+    FastFourierTransform<double>::realFastFourierTransformInPlace(data, log2n);
+  }
+
+  int complexTransformCount = 0;
+  int realTransformCount = 0;
+  std::vector<std::complex<double>> lastInput;
+};
+
+// Test case for filtering two channels with one transform
+TEST(FilterPairTest, ProcessPairSharesOneTransform) {
+  // Arrange
+  std::vector<std::pair<double, double>> passbands = {{0, 1}};
+  std::vector<std::pair<double, double>> stopbands = {{0, 1}};
+  RecordingFastFourierTransform fft;
+  Filter<double, double> filter(passbands, stopbands, 0.01, &fft);
+  SignalHistory<double, 64> red;
+  SignalHistory<double, 64> infraRed;
+  for (int i = 0; i < 10; ++i) {
+    red.put(i);
+    infraRed.put(100 - i);
+  }
+  infraRed.put(90);
+  SignalHistory<double, 64> filteredRed;
+  SignalHistory<double, 64> filteredInfraRed;
+
+  // Act
+  filter.processPair(&red, &infraRed, &filteredRed, &filteredInfraRed);
+
+  // Assert
+  EXPECT_EQ(fft.complexTransformCount, 1);
+  EXPECT_EQ(fft.realTransformCount, 0);
+  ASSERT_EQ(fft.lastInput.size(), 11u);
+  for (int i = 0; i < 11; ++i) {
+    EXPECT_EQ(fft.lastInput[i].real(), i < 10 ? i : 0.0);
+    EXPECT_EQ(fft.lastInput[i].imag(), i < 11 ? infraRed.getSample(i) : 0.0);
+  }
+}
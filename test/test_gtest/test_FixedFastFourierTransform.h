@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "FastFourierTransform.h"
+#include "FixedFastFourierTransform.h"
+
+// Test case for fastFourierTransform against the runtime-planned transform
+TEST(FixedFastFourierTransformTestCase1, FastFourierTransform) {
+  // Arrange
+  std::vector<double> realInput(50), imaginaryInput(50);
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    realInput[i] = std::sin(0.3 * i) + 0.5;
+    imaginaryInput[i] = std::cos(0.05 * i * i);
+  }
+  std::vector<double> expectedReal, expectedImaginary;
+  FastFourierTransform<double> reference;
+  reference.fastFourierTransform(&realInput, &imaginaryInput, &expectedReal,
+                                 &expectedImaginary);
+  std::vector<double> realOutput, imaginaryOutput;
+
+  // Act
+  FixedFastFourierTransform<double, 64> transform;
+  transform.fastFourierTransform(&realInput, &imaginaryInput, &realOutput,
+                                 &imaginaryOutput);
+
+  // Assert
+  ASSERT_EQ(realOutput.size(), 64u);
+  for (unsigned int k = 0; k < 64; k++) {
+    EXPECT_NEAR(realOutput[k], expectedReal[k], 1e-12);
+    EXPECT_NEAR(imaginaryOutput[k], expectedImaginary[k], 1e-12);
+  }
+}
+
+// Test case for a round trip through the complex transforms
+TEST(FixedFastFourierTransformTestCase2, InverseFastFourierTransform) {
+  // Arrange
+  std::vector<float> realInput(64), imaginaryInput(64);
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    realInput[i] = static_cast<float>(i % 9);
+    imaginaryInput[i] = static_cast<float>(std::sin(0.7 * i));
+  }
+  std::vector<float> realSpectrum, imaginarySpectrum;
+  std::vector<float> realOutput, imaginaryOutput;
+
+  // Act
+  FixedFastFourierTransform<float, 64> transform;
+  transform.fastFourierTransform(&realInput, &imaginaryInput, &realSpectrum,
+                                 &imaginarySpectrum);
+  transform.inverseFastFourierTransform(&realSpectrum, &imaginarySpectrum,
+                                        &realOutput, &imaginaryOutput);
+
+  // Assert
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    EXPECT_NEAR(realOutput[i], realInput[i], 1e-4);
+    EXPECT_NEAR(imaginaryOutput[i], imaginaryInput[i], 1e-4);
+  }
+}
+
+// Test case for the in-place real transforms
+TEST(FixedFastFourierTransformTestCase3, RealFastFourierTransformInPlace) {
+  // Arrange
+  std::vector<double> realInput(64);
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    realInput[i] = std::cos(0.9 * i) + 0.05 * i;
+  }
+  std::vector<double> expectedReal, expectedImaginary;
+  FastFourierTransform<double> reference;
+  reference.realFastFourierTransform(&realInput, &expectedReal,
+                                     &expectedImaginary);
+  std::complex<double> data[33];
+  double* samples = reinterpret_cast<double*>(data);
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    samples[i] = realInput[i];
+  }
+  FixedFastFourierTransform<double, 64> transform;
+
+  // Act
+  transform.realFastFourierTransformInPlace(data, 6);
+
+  // Assert
+  for (unsigned int k = 0; k < 33; k++) {
+    EXPECT_NEAR(data[k].real(), expectedReal[k], 1e-12);
+    EXPECT_NEAR(data[k].imag(), expectedImaginary[k], 1e-12);
+  }
+
+  // Act
+  transform.inverseRealFastFourierTransformInPlace(data, 6);
+
+  // Assert
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    EXPECT_NEAR(samples[i], realInput[i], 1e-12);
+  }
+}
+
+// Test case for in-place transforms of another size
+TEST(FixedFastFourierTransformTestCase4, WrongSize) {
+  // Arrange
+  std::complex<double> data[64];
+  std::vector<double> longInput(65, 1.0);
+  std::vector<double> realOutput, imaginaryOutput;
+  FixedFastFourierTransform<double, 64> transform;
+
+  // Act & Assert
+  EXPECT_THROW(transform.fastFourierTransformInPlace(data, 5),
+               std::invalid_argument);
+  EXPECT_THROW(
+      transform.realFastFourierTransform(&longInput, &realOutput,
+                                         &imaginaryOutput),
+      std::invalid_argument);
+}
+
+// Test case for exact size transforms, which only take the fixed size
+TEST(FixedFastFourierTransformTestCase5, ExactSize) {
+  // Arrange
+  std::complex<double> data[64];
+  std::complex<double> expected[64];
+  for (unsigned int i = 0; i < 64; i++) {
+    data[i] = std::complex<double>(std::sin(0.3 * i), 0.05 * i);
+    expected[i] = data[i];
+  }
+  FixedFastFourierTransform<double, 64> transform;
+
+  // Act
+  transform.exactSizeFastFourierTransformInPlace(data, 64);
+  transform.fastFourierTransformInPlace(expected, 6);
+
+  // Assert
+  for (unsigned int k = 0; k < 64; k++) {
+    EXPECT_EQ(data[k], expected[k]);
+  }
+  EXPECT_THROW(transform.exactSizeFastFourierTransformInPlace(data, 50),
+               std::invalid_argument);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "FastFourierTransform.h"
+#include "FixedPointFastFourierTransform.h"
+
+// Signal to noise ratio in dB of a transform output against a reference
+inline double fixedPointSignalToNoiseRatio(
+    const std::vector<double>& expectedReal,
+    const std::vector<double>& expectedImaginary,
+    const std::vector<double>& actualReal,
+    const std::vector<double>& actualImaginary) {
+  double signalPower = 0;
+  double noisePower = 0;
+  for (unsigned int i = 0; i < expectedReal.size(); i++) {
+    double realError = actualReal[i] - expectedReal[i];
+    double imaginaryError = actualImaginary[i] - expectedImaginary[i];
+    signalPower += expectedReal[i] * expectedReal[i] +
+                   expectedImaginary[i] * expectedImaginary[i];
+    noisePower += realError * realError + imaginaryError * imaginaryError;
+  }
+  return 10 * std::log10(signalPower / noisePower);
+}
+
+// Test case for the Q15 transform against the double precision transform
+TEST(FixedPointFastFourierTransformTestCase1, Q15FastFourierTransform) {
+  // Arrange
+  std::vector<double> realInput(256), imaginaryInput(256);
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    realInput[i] = 2.5 + std::sin(0.21 * i) + 0.3 * std::cos(1.7 * i);
+    imaginaryInput[i] = 0.8 * std::sin(0.05 * i * i);
+  }
+  std::vector<double> expectedReal, expectedImaginary;
+  FastFourierTransform<double> reference;
+  reference.fastFourierTransform(&realInput, &imaginaryInput, &expectedReal,
+                                 &expectedImaginary);
+  std::vector<double> realOutput, imaginaryOutput;
+  FixedPointFastFourierTransform<double, q15_data_type> transform;
+
+  // Act
+  transform.fastFourierTransform(&realInput, &imaginaryInput, &realOutput,
+                                 &imaginaryOutput);
+
+  // Assert
+  ASSERT_EQ(realOutput.size(), 256u);
+  EXPECT_GT(fixedPointSignalToNoiseRatio(expectedReal, expectedImaginary,
+                                         realOutput, imaginaryOutput),
+            50);
+}
+
+// Test case for the Q31 transform against the double precision transform
+TEST(FixedPointFastFourierTransformTestCase2, Q31FastFourierTransform) {
+  // Arrange
+  std::vector<double> realInput(256), imaginaryInput(256);
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    realInput[i] = 2.5 + std::sin(0.21 * i) + 0.3 * std::cos(1.7 * i);
+    imaginaryInput[i] = 0.8 * std::sin(0.05 * i * i);
+  }
+  std::vector<double> expectedReal, expectedImaginary;
+  FastFourierTransform<double> reference;
+  reference.fastFourierTransform(&realInput, &imaginaryInput, &expectedReal,
+                                 &expectedImaginary);
+  std::vector<double> realOutput, imaginaryOutput;
+  FixedPointFastFourierTransform<double, q31_data_type> transform;
+
+  // Act
+  transform.fastFourierTransform(&realInput, &imaginaryInput, &realOutput,
+                                 &imaginaryOutput);
+
+  // Assert
+  EXPECT_GT(fixedPointSignalToNoiseRatio(expectedReal, expectedImaginary,
+                                         realOutput, imaginaryOutput),
+            140);
+}
+
+// Test case for the real transforms against the double precision transform
+TEST(FixedPointFastFourierTransformTestCase3, RealFastFourierTransform) {
+  // Arrange
+  std::vector<double> realInput(64);
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    realInput[i] = 1.2 + 0.1 * std::sin(0.6 * i) + 0.02 * std::cos(2.1 * i);
+  }
+  std::vector<double> expectedReal, expectedImaginary;
+  FastFourierTransform<double> reference;
+  reference.realFastFourierTransform(&realInput, &expectedReal,
+                                     &expectedImaginary);
+  std::vector<double> realSpectrum, imaginarySpectrum, realOutput;
+  FixedPointFastFourierTransform<double, q15_data_type> transform;
+
+  // Act
+  transform.realFastFourierTransform(&realInput, &realSpectrum,
+                                     &imaginarySpectrum);
+  transform.inverseRealFastFourierTransform(&realSpectrum, &imaginarySpectrum,
+                                            &realOutput);
+
+  // Assert
+  ASSERT_EQ(realSpectrum.size(), 33u);
+  EXPECT_GT(fixedPointSignalToNoiseRatio(expectedReal, expectedImaginary,
+                                         realSpectrum, imaginarySpectrum),
+            50);
+  std::vector<double> zeros(64, 0.0);
+  EXPECT_GT(
+      fixedPointSignalToNoiseRatio(realInput, zeros, realOutput, zeros), 50);
+}
+
+// Test case for a round trip through the interface with float elements
+TEST(FixedPointFastFourierTransformTestCase4, InverseFastFourierTransform) {
+  // Arrange
+  std::vector<float> realInput(64), imaginaryInput(64);
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    realInput[i] = static_cast<float>(i % 9);
+    imaginaryInput[i] = static_cast<float>(std::sin(0.7 * i));
+  }
+  std::vector<float> realSpectrum, imaginarySpectrum;
+  std::vector<float> realOutput, imaginaryOutput;
+  FixedPointFastFourierTransform<float, q31_data_type> fixedPointTransform;
+  FastFourierTransformInterface<float>* transform = &fixedPointTransform;
+
+  // Act
+  transform->fastFourierTransform(&realInput, &imaginaryInput, &realSpectrum,
+                                  &imaginarySpectrum);
+  transform->inverseFastFourierTransform(&realSpectrum, &imaginarySpectrum,
+                                         &realOutput, &imaginaryOutput);
+
+  // Assert
+  for (unsigned int i = 0; i < realInput.size(); i++) {
+    EXPECT_NEAR(realOutput[i], realInput[i], 1e-4);
+    EXPECT_NEAR(imaginaryOutput[i], imaginaryInput[i], 1e-4);
+  }
+}
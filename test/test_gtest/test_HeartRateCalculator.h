@@ -1,5 +1,6 @@
 #include <cmath>
 
+#include "CompactSignalHistory.h"
 #include "HeartRateCalculator.h"
 #include "SignalHistory.h"
 #include "gtest/gtest.h"
@@ -219,3 +220,30 @@ TEST(HeartRateCalculatorTest7, CalculateTest) {
   delete infraRedSignalHistory;
   delete heartRateCalculatorObject;
 }
+
+// Test case for a history storing Q15 codes instead of signals
+TEST(HeartRateCalculatorTest8, CalculateFromCompactHistory) {
+  // Arrange
+  CompactSignalHistory<double, std::int16_t, 64> redSignalHistory(1.0 /
+                                                                  16384);
+  CompactSignalHistory<double, std::int16_t, 64> infraRedSignalHistory(
+      1.0 / 16384);
+  HeartRateCalculator<double> heartRateCalculatorObject;
+
+  double expectedHeartRate = 60;
+
+  for (int i = 0; i < (int)expectedHeartRate; ++i) {
+    double time = i / 60.0;
+    redSignalHistory.put(std::sin(2 * M_PI * 1 * time));
+    infraRedSignalHistory.put(std::sin(2 * M_PI * 1 * time));
+  }
+
+  // Act
+  double samplingPeriodUs = 1e6 / expectedHeartRate;  // Sampling rate of 60 Hz.
+  double calculatedHeartRate = heartRateCalculatorObject.calculate(
+      &redSignalHistory, &infraRedSignalHistory, samplingPeriodUs);
+
+  // Assert
+  ASSERT_NEAR(expectedHeartRate, calculatedHeartRate,
+              1e-6);  // Allow a small margin of error.
+}
@@ -0,0 +1,175 @@
+#ifdef EXCLUDEARDUINOLIB
+
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "HeartRateCalculator.h"
+#include "MappedSignalHistory.h"
+#include "SignalHistory.h"
+
+// Builds a fresh backing file path in the test temporary directory
+static std::string mappedHistoryPath(const char* name) {
+  std::string path = ::testing::TempDir() + name;
+  std::remove(path.c_str());
+  return path;
+}
+
+// Test case for put and get methods
+TEST(MappedSignalHistoryTestCase1, PutAndGet) {
+  // Arrange
+  std::string path = mappedHistoryPath("mapped_history_1.bin");
+  MappedSignalHistory<double> signalHistory(path.c_str(), 64);
+
+  // Act
+  signalHistory.put(1.0);
+  signalHistory.put(2.0);
+
+  // Assert
+  ASSERT_TRUE(signalHistory.isOpen());
+  EXPECT_EQ(signalHistory.size(), 2);
+  EXPECT_EQ(signalHistory.get(0), 1.0);
+  EXPECT_EQ(signalHistory.get(1), 2.0);
+  EXPECT_THROW(signalHistory.get(2), std::invalid_argument);
+}
+
+// Test case for the history surviving a reopen of its file
+TEST(MappedSignalHistoryTestCase2, ReopenKeepsHistory) {
+  // Arrange
+  std::string path = mappedHistoryPath("mapped_history_2.bin");
+  {
+    MappedSignalHistory<double> signalHistory(path.c_str(), 64);
+    for (int i = 0; i < 10; ++i) signalHistory.put(i);
+  }
+
+  // Act
+  MappedSignalHistory<double> reopenedHistory(path.c_str(), 64);
+
+  // Assert
+  ASSERT_EQ(reopenedHistory.size(), 10);
+  for (std::size_t i = 0; i < 10; ++i) {
+    EXPECT_EQ(reopenedHistory.getSample(i), static_cast<double>(i));
+  }
+  EXPECT_EQ(reopenedHistory.min(), 0.0);
+  EXPECT_EQ(reopenedHistory.max(), 9.0);
+  EXPECT_DOUBLE_EQ(reopenedHistory.mean(), 4.5);
+}
+
+// Test case for a file of another capacity being reinitialized
+TEST(MappedSignalHistoryTestCase3, ReopenWithOtherCapacity) {
+  // Arrange
+  std::string path = mappedHistoryPath("mapped_history_3.bin");
+  {
+    MappedSignalHistory<double> signalHistory(path.c_str(), 64);
+    signalHistory.put(1.0);
+  }
+
+  // Act
+  MappedSignalHistory<double> reopenedHistory(path.c_str(), 128);
+
+  // Assert
+  EXPECT_EQ(reopenedHistory.size(), 0);
+}
+
+// Overwrites a 64-bit word of a history file, like a truncated write would
+static void overwriteMappedWord(const std::string& path, long offset,
+                                std::uint64_t value) {
+  std::FILE* file = std::fopen(path.c_str(), "r+b");
+  std::fseek(file, offset, SEEK_SET);
+  std::fwrite(&value, sizeof(value), 1, file);
+  std::fclose(file);
+}
+
+// Test case for a file whose state is out of range being reinitialized
+TEST(MappedSignalHistoryTestCase7, ReopenCorruptedFile) {
+  // Arrange
+  const long elementCountOffset = 32;  // After magic, size, capacity, slot
+  const long minSlotsOffset = 96 + 64 * sizeof(double);  // Header, signals
+  std::string countPath = mappedHistoryPath("mapped_history_7_count.bin");
+  std::string slotPath = mappedHistoryPath("mapped_history_7_slot.bin");
+  for (const std::string& path : {countPath, slotPath}) {
+    MappedSignalHistory<double> signalHistory(path.c_str(), 64);
+    for (int i = 0; i < 10; ++i) signalHistory.put(i);
+  }
+  overwriteMappedWord(countPath, elementCountOffset, 1000);
+  overwriteMappedWord(slotPath, minSlotsOffset, 1u << 20);
+
+  // Act
+  MappedSignalHistory<double> countHistory(countPath.c_str(), 64);
+  MappedSignalHistory<double> slotHistory(slotPath.c_str(), 64);
+
+  // Assert
+  EXPECT_EQ(countHistory.size(), 0);
+  EXPECT_EQ(slotHistory.size(), 0);
+  countHistory.put(1.0);
+  EXPECT_EQ(countHistory.min(), 1.0);
+}
+
+// Test case for matching an in-memory history while evicting
+TEST(MappedSignalHistoryTestCase4, PutWhenFull) {
+  // Arrange
+  std::string path = mappedHistoryPath("mapped_history_4.bin");
+  MappedSignalHistory<double> mappedHistory(path.c_str(), 64);
+  SignalHistory<double, 64> memoryHistory;
+
+  // Act and Assert
+  for (int i = 0; i < 500; ++i) {
+    double signal = std::sin(i * 0.37) * (i % 7);
+    mappedHistory.put(signal);
+    memoryHistory.put(signal);
+    ASSERT_EQ(mappedHistory.min(), memoryHistory.min());
+    ASSERT_EQ(mappedHistory.max(), memoryHistory.max());
+    ASSERT_NEAR(mappedHistory.mean(), memoryHistory.mean(), 1e-9);
+    ASSERT_NEAR(mappedHistory.variance(), memoryHistory.variance(), 1e-9);
+  }
+  ASSERT_EQ(mappedHistory.size(), 64);
+  SignalBlock<double> block = mappedHistory.getBlock(0, 64);
+  EXPECT_EQ(block.first.length + block.second.length, 64u);
+  for (std::size_t i = 0; i < 64; ++i) {
+    EXPECT_EQ(mappedHistory.getSample(i), memoryHistory.getSample(i));
+  }
+}
+
+// Test case for a mapped history feeding a calculator through the interface
+TEST(MappedSignalHistoryTestCase5, HeartRateCalculator) {
+  // Arrange
+  std::string redPath = mappedHistoryPath("mapped_history_5_red.bin");
+  std::string infraRedPath = mappedHistoryPath("mapped_history_5_ir.bin");
+  MappedSignalHistory<double> redSignalHistory(redPath.c_str(), 512);
+  MappedSignalHistory<double> infraRedSignalHistory(infraRedPath.c_str(), 512);
+  HeartRateCalculator<double> heartRateCalculatorObject;
+  double expectedHeartRate = 60;
+  for (int i = 0; i < (int)expectedHeartRate; ++i) {
+    double time = i / 60.0;
+    redSignalHistory.put(std::sin(2 * M_PI * 1 * time));
+    infraRedSignalHistory.put(std::sin(2 * M_PI * 1 * time));
+  }
+
+  // Act
+  double samplingPeriodUs = 1e6 / expectedHeartRate;  // Sampling rate of 60 Hz.
+  double calculatedHeartRate = heartRateCalculatorObject.calculate(
+      &redSignalHistory, &infraRedSignalHistory, samplingPeriodUs);
+
+  // Assert
+  ASSERT_NEAR(expectedHeartRate, calculatedHeartRate, 1e-6);
+}
+
+// Test case for a file that cannot be resized failing without leaking it
+TEST(MappedSignalHistoryTestCase6, UnusableFile) {
+  // Arrange
+  int freeDescriptor = open("/dev/null", O_RDONLY);
+  close(freeDescriptor);
+
+  // Act and Assert
+  EXPECT_THROW(MappedSignalHistory<double>("/dev/null", 64),
+               std::runtime_error);
+  int nextDescriptor = open("/dev/null", O_RDONLY);
+  close(nextDescriptor);
+  EXPECT_EQ(nextDescriptor, freeDescriptor);
+}
+
+#endif  // EXCLUDEARDUINOLIB
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include "MultiChannelSignalHistory.h"
+
+// Test case for put method
+TEST(MultiChannelSignalHistoryTestCase1, Put) {
+  // Arrange
+  MultiChannelSignalHistory<double, int, AmbientChannel, 64> signalHistory;
+  double frame[] = {1.0, 2.0};
+
+  // Act
+  signalHistory.put(frame, 100);
+
+  // Assert
+  EXPECT_EQ(signalHistory.size(), 1u);
+  EXPECT_EQ(signalHistory.channelCount(), 2u);
+  EXPECT_EQ(signalHistory.getChannel(RedChannel)->get(0), 1.0);
+  EXPECT_EQ(signalHistory.getChannel(InfraRedChannel)->get(0), 2.0);
+  EXPECT_EQ(signalHistory.getTimestampUs(0), 100);
+}
+
+// Test case for the channels staying aligned with the timestamps
+TEST(MultiChannelSignalHistoryTestCase2, PutWhenWindowFull) {
+  // Arrange
+  MultiChannelSignalHistory<double, int, AmbientChannel, 64> signalHistory(50);
+
+  // Act
+  for (int i = 0; i < 120; ++i) {
+    double frame[] = {static_cast<double>(i), static_cast<double>(-i)};
+    signalHistory.put(frame, i * 25000);
+  }
+
+  // Assert
+  SignalHistoryInterface<double>* redHistory =
+      signalHistory.getChannel(RedChannel);
+  SignalHistoryInterface<double>* infraRedHistory =
+      signalHistory.getChannel(InfraRedChannel);
+  ASSERT_EQ(signalHistory.size(), 50u);
+  ASSERT_EQ(redHistory->size(), 50);
+  ASSERT_EQ(infraRedHistory->size(), 50);
+  for (std::size_t i = 0; i < 50; ++i) {
+    EXPECT_EQ(redHistory->getSample(i), 70.0 + i);
+    EXPECT_EQ(infraRedHistory->getSample(i), -70.0 - i);
+    EXPECT_EQ(signalHistory.getTimestampUs(i), (70 + i) * 25000);
+  }
+}
+
+// Test case for blocks of every lane splitting at the same frame
+TEST(MultiChannelSignalHistoryTestCase3, GetBlocksInLockstep) {
+  // Arrange
+  MultiChannelSignalHistory<double, int, AmbientChannel, 64> signalHistory;
+  for (int i = 0; i < 100; ++i) {
+    double frame[] = {static_cast<double>(i), static_cast<double>(2 * i)};
+    signalHistory.put(frame, i);
+  }
+
+  // Act
+  SignalBlock<double> redBlock =
+      signalHistory.getChannel(RedChannel)->getBlock(0, 64);
+  SignalBlock<double> infraRedBlock =
+      signalHistory.getChannel(InfraRedChannel)->getBlock(0, 64);
+  SignalBlock<int> timestampBlock = signalHistory.getTimestampBlock(0, 64);
+
+  // Assert
+  EXPECT_EQ(redBlock.first.length, infraRedBlock.first.length);
+  EXPECT_EQ(redBlock.first.length, timestampBlock.first.length);
+  for (std::size_t i = 0; i < redBlock.first.length; ++i) {
+    EXPECT_EQ(2 * redBlock.first.data[i], infraRedBlock.first.data[i]);
+    EXPECT_EQ(redBlock.first.data[i], timestampBlock.first.data[i]);
+  }
+  for (std::size_t i = 0; i < redBlock.second.length; ++i) {
+    EXPECT_EQ(2 * redBlock.second.data[i], infraRedBlock.second.data[i]);
+    EXPECT_EQ(redBlock.second.data[i], timestampBlock.second.data[i]);
+  }
+}
+
+// Test case for reset method
+TEST(MultiChannelSignalHistoryTestCase4, Reset) {
+  // Arrange
+  MultiChannelSignalHistory<double, int, AmbientChannel, 64> signalHistory;
+  double frame[] = {1.0, 2.0};
+  signalHistory.put(frame, 0);
+
+  // Act
+  signalHistory.reset();
+
+  // Assert
+  EXPECT_EQ(signalHistory.size(), 0u);
+  EXPECT_EQ(signalHistory.getChannel(RedChannel)->size(), 0);
+  EXPECT_EQ(signalHistory.getChannel(InfraRedChannel)->size(), 0);
+  EXPECT_THROW(signalHistory.getTimestampUs(0), std::invalid_argument);
+}
+
+// Test case for blocks splitting at the same frame after a reset
+TEST(MultiChannelSignalHistoryTestCase5, GetBlocksInLockstepAfterReset) {
+  // Arrange
+  MultiChannelSignalHistory<double, int, AmbientChannel, 64> signalHistory;
+  for (int i = 0; i < 40; ++i) {
+    double frame[] = {static_cast<double>(i), static_cast<double>(2 * i)};
+    signalHistory.put(frame, i);
+  }
+  signalHistory.reset();
+  for (int i = 0; i < 64; ++i) {
+    double frame[] = {static_cast<double>(i), static_cast<double>(2 * i)};
+    signalHistory.put(frame, i);
+  }
+
+  // Act
+  SignalBlock<double> redBlock =
+      signalHistory.getChannel(RedChannel)->getBlock(0, 64);
+  SignalBlock<double> infraRedBlock =
+      signalHistory.getChannel(InfraRedChannel)->getBlock(0, 64);
+  SignalBlock<int> timestampBlock = signalHistory.getTimestampBlock(0, 64);
+
+  // Assert
+  ASSERT_GT(redBlock.second.length, 0u);
+  EXPECT_EQ(redBlock.first.length, infraRedBlock.first.length);
+  EXPECT_EQ(redBlock.first.length, timestampBlock.first.length);
+  EXPECT_EQ(redBlock.second.length, timestampBlock.second.length);
+  for (std::size_t i = 0; i < redBlock.first.length; ++i) {
+    EXPECT_EQ(2 * redBlock.first.data[i], infraRedBlock.first.data[i]);
+    EXPECT_EQ(redBlock.first.data[i], timestampBlock.first.data[i]);
+  }
+  for (std::size_t i = 0; i < redBlock.second.length; ++i) {
+    EXPECT_EQ(2 * redBlock.second.data[i], infraRedBlock.second.data[i]);
+    EXPECT_EQ(redBlock.second.data[i], timestampBlock.second.data[i]);
+  }
+}
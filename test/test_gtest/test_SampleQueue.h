@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "SampleQueue.h"
+
+// Test case for push and pop methods
+TEST(SampleQueueTestCase1, PushPop) {
+  // Arrange
+  SampleQueue<double, 64> sampleQueue;
+  double sample = 0;
+
+  // Act
+  bool isPushed = sampleQueue.push(1.5);
+  bool isPopped = sampleQueue.pop(sample);
+
+  // Assert
+  EXPECT_TRUE(isPushed);
+  EXPECT_TRUE(isPopped);
+  EXPECT_EQ(sample, 1.5);
+  EXPECT_EQ(sampleQueue.size(), 0u);
+}
+
+// Test case for pop method on an empty queue
+TEST(SampleQueueTestCase2, PopWhenEmpty) {
+  // Arrange
+  SampleQueue<double, 64> sampleQueue;
+  double sample = 7.0;
+
+  // Act and Assert
+  EXPECT_FALSE(sampleQueue.pop(sample));
+  EXPECT_EQ(sample, 7.0);
+}
+
+// Test case for push method on a full queue
+TEST(SampleQueueTestCase3, PushWhenFull) {
+  // Arrange
+  SampleQueue<double, 64> sampleQueue;
+  for (int i = 0; i < 64; ++i) {
+    ASSERT_TRUE(sampleQueue.push(i));
+  }
+
+  // Act
+  bool isPushed = sampleQueue.push(64);
+
+  // Assert
+  EXPECT_FALSE(isPushed);
+  EXPECT_EQ(sampleQueue.size(), 64u);
+  EXPECT_EQ(sampleQueue.droppedCount(), 1u);
+  double sample = -1;
+  for (int i = 0; i < 64; ++i) {
+    ASSERT_TRUE(sampleQueue.pop(sample));
+    EXPECT_EQ(sample, i);
+  }
+}
+
+// Stress test with a producer thread and a consumer thread
+TEST(SampleQueueTestCase4, ProducerConsumerThreads) {
+  // Arrange
+  SampleQueue<double, 64>* sampleQueue = new SampleQueue<double, 64>();
+  const int SAMPLECOUNT = 1000000;
+  int outOfOrderCount = 0;
+
+  // Act
+  std::thread producer([sampleQueue, SAMPLECOUNT]() {
+    for (int i = 0; i < SAMPLECOUNT; ++i) {
+      while (!sampleQueue->push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::thread consumer([sampleQueue, SAMPLECOUNT, &outOfOrderCount]() {
+    double sample = 0;
+    for (int expected = 0; expected < SAMPLECOUNT; ++expected) {
+      while (!sampleQueue->pop(sample)) {
+        std::this_thread::yield();
+      }
+      if (sample != expected) ++outOfOrderCount;
+    }
+  });
+  producer.join();
+  consumer.join();
+
+  // Assert
+  EXPECT_EQ(outOfOrderCount, 0);
+  EXPECT_EQ(sampleQueue->size(), 0u);
+
+  // Clean up.
+  delete sampleQueue;
+}
+
+// Stress test of size() read from a third thread while the queue is in use
+TEST(SampleQueueTestCase5, SizeWhileProducerConsumerThreads) {
+  // Arrange
+  SampleQueue<double, 64>* sampleQueue = new SampleQueue<double, 64>();
+  const int SAMPLECOUNT = 200000;
+  std::atomic<bool> isRunning(true);
+  std::size_t largestSize = 0;
+
+  // Act
+  std::thread observer([sampleQueue, &isRunning, &largestSize]() {
+    while (isRunning.load()) {
+      std::size_t size = sampleQueue->size();
+      if (size > largestSize) largestSize = size;
+    }
+  });
+  std::thread producer([sampleQueue, SAMPLECOUNT]() {
+    for (int i = 0; i < SAMPLECOUNT; ++i) {
+      while (!sampleQueue->push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  std::thread consumer([sampleQueue, SAMPLECOUNT]() {
+    double sample = 0;
+    for (int i = 0; i < SAMPLECOUNT; ++i) {
+      while (!sampleQueue->pop(sample)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  producer.join();
+  consumer.join();
+  isRunning.store(false);
+  observer.join();
+
+  // Assert
+  EXPECT_LE(largestSize, 64u);
+
+  // Clean up.
+  delete sampleQueue;
+}
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "SignalAlgebra.h"
+#include "SignalHistory.h"
+
+// Test case for a view of a wrapped block
+TEST(SignalAlgebraTestCase1, ViewOfWrappedBlock) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory;
+  for (int i = 0; i < 100; ++i) {
+    signalHistory.put(i);
+  }
+
+  // Act
+  SignalView<double> signal(signalHistory.getBlock(0, 64));
+
+  // Assert
+  ASSERT_EQ(signal.size(), 64u);
+  for (std::size_t i = 0; i < 64; ++i) {
+    EXPECT_EQ(signal[i], 36.0 + i);
+  }
+}
+
+// Test case for "subtract mean, square, sum" fused in one pass
+TEST(SignalAlgebraTestCase2, MapAndReduce) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(50);
+  for (int i = 0; i < 90; ++i) {
+    signalHistory.put(std::sin(i * 0.4) + 2.0);
+  }
+  double mean = signalHistory.mean();
+  SignalView<double> signal(signalHistory.getBlock(0, 50));
+
+  // Act
+  double squaredError = reduce(
+      mapEach(signal,
+              [mean](double x) { return (x - mean) * (x - mean); }),
+      0.0, [](double total, double x) { return total + x; });
+
+  // Assert
+  EXPECT_NEAR(squaredError / 50, signalHistory.variance(), 1e-12);
+}
+
+// Test case for combining two histories value by value
+TEST(SignalAlgebraTestCase3, ZipAndReduce) {
+  // Arrange
+  SignalHistory<double, 64> redHistory;
+  SignalHistory<double, 64> infraRedHistory;
+  for (int i = 0; i < 70; ++i) {
+    redHistory.put(i);
+    infraRedHistory.put(2 * i);
+  }
+  SignalView<double> red(redHistory.getBlock(0, 64));
+  SignalView<double> infraRed(infraRedHistory.getBlock(0, 64));
+
+  // Act
+  double dotProduct =
+      reduce(zipWith(red, infraRed, [](double a, double b) { return a * b; }),
+             0.0, [](double total, double x) { return total + x; });
+
+  // Assert
+  double expectedDotProduct = 0;
+  for (int i = 6; i < 70; ++i) expectedDotProduct += 2.0 * i * i;
+  EXPECT_EQ(dotProduct, expectedDotProduct);
+}
+
+// Test case for counting rising edges across the ring buffer wrap
+TEST(SignalAlgebraTestCase4, AdjacentPairs) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory;
+  for (int i = 0; i < 100; ++i) {
+    signalHistory.put(i % 10 < 5 ? 0.0 : 1.0);
+  }
+  SignalView<double> signal(signalHistory.getBlock(0, 64));
+
+  // Act
+  auto risingEdges = adjacentPairs(signal, [](double previous, double current) {
+    return previous < 0.5 && current >= 0.5;
+  });
+  int risingEdgeCount = reduce(risingEdges, 0, [](int count, bool isRising) {
+    return isRising ? count + 1 : count;
+  });
+
+  // Assert
+  EXPECT_EQ(risingEdges.size(), 63u);
+  // The window holds signals 36 to 99, edges at 45, 55, ..., 95
+  EXPECT_EQ(risingEdgeCount, 6);
+}
+
+// Test case for expressions over an empty view
+TEST(SignalAlgebraTestCase5, EmptyView) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory;
+  SignalView<double> signal(signalHistory.getBlock(0, 0));
+
+  // Act
+  double total =
+      reduce(adjacentPairs(signal, [](double a, double b) { return a + b; }),
+             0.0, [](double sum, double x) { return sum + x; });
+
+  // Assert
+  EXPECT_EQ(signal.size(), 0u);
+  EXPECT_EQ(total, 0.0);
+}
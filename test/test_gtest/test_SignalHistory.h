@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+
 #include "SignalHistory.h"
 
 // Test case for put method
@@ -149,3 +154,395 @@ TEST(SignalHistoryTestCase12, ResetWhenEmpty) {
   // Assert
   EXPECT_EQ(signalHistory.size(), 0);
 }
+
+TEST(SignalHistoryTestCase13, PutWhenWindowFull) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(5);
+  double signals[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+  for (double signal : signals) {
+    signalHistory.put(signal);
+  }
+
+  // Act
+  double newSignal = 6.0;
+  signalHistory.put(newSignal);
+
+  // Assert
+  EXPECT_EQ(signalHistory.size(), 5);
+  EXPECT_EQ(signalHistory.get(0), 2.0);
+  EXPECT_EQ(signalHistory.get(4), newSignal);
+}
+
+TEST(SignalHistoryTestCase14, PutWrapsAroundCapacity) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory;
+
+  // Act
+  for (int i = 0; i < 100; ++i) {
+    signalHistory.put(i);
+  }
+
+  // Assert
+  EXPECT_EQ(signalHistory.size(), 64);
+  for (int i = 0; i < 64; ++i) {
+    EXPECT_EQ(signalHistory.get(i), 36 + i);
+  }
+  EXPECT_EQ(signalHistory.min(), 36.0);
+  EXPECT_EQ(signalHistory.max(), 99.0);
+}
+
+TEST(SignalHistoryTestCase15, ConstructWithInvalidWindow) {
+  // Act and Assert
+  EXPECT_THROW((SignalHistory<double, 64>(0)), std::invalid_argument);
+  EXPECT_THROW((SignalHistory<double, 64>(65)), std::invalid_argument);
+}
+
+TEST(SignalHistoryTestCase16, MinMaxFollowSlidingWindow) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(7);
+  unsigned int seed = 12345;
+
+  for (int i = 0; i < 500; ++i) {
+    // Act
+    seed = seed * 1103515245u + 12345u;
+    signalHistory.put(static_cast<double>((seed >> 16) % 100));
+
+    // Assert
+    double expectedMin = signalHistory.get(0);
+    double expectedMax = signalHistory.get(0);
+    for (int j = 1; j < signalHistory.size(); ++j) {
+      expectedMin = std::min(expectedMin, signalHistory.get(j));
+      expectedMax = std::max(expectedMax, signalHistory.get(j));
+    }
+    EXPECT_EQ(signalHistory.min(), expectedMin);
+    EXPECT_EQ(signalHistory.max(), expectedMax);
+  }
+}
+
+TEST(SignalHistoryTestCase17, MinMaxAfterReset) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(3);
+  double signals[] = {-4.0, 9.0, 2.0, 7.0};
+  for (double signal : signals) {
+    signalHistory.put(signal);
+  }
+
+  // Act
+  signalHistory.reset();
+  signalHistory.put(5.0);
+
+  // Assert
+  EXPECT_EQ(signalHistory.min(), 5.0);
+  EXPECT_EQ(signalHistory.max(), 5.0);
+}
+
+TEST(SignalHistoryTestCase18, RunningStatistics) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory;
+  double signals[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+  for (double signal : signals) {
+    signalHistory.put(signal);
+  }
+
+  // Act and Assert
+  EXPECT_DOUBLE_EQ(signalHistory.sum(), 15.0);
+  EXPECT_DOUBLE_EQ(signalHistory.mean(), 3.0);
+  EXPECT_DOUBLE_EQ(signalHistory.sumOfSquares(), 55.0);
+  EXPECT_DOUBLE_EQ(signalHistory.variance(), 2.0);
+}
+
+TEST(SignalHistoryTestCase19, RunningStatisticsFollowSlidingWindow) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(50);
+
+  for (int i = 0; i < 5000; ++i) {
+    // Act: a small PPG-like ripple riding on a large DC offset
+    signalHistory.put(1e6 + std::sin(0.37 * i) + 0.001 * (i % 7));
+
+    // Assert
+    double expectedMean = 0;
+    for (int j = 0; j < signalHistory.size(); ++j) {
+      expectedMean += signalHistory.get(j);
+    }
+    expectedMean /= signalHistory.size();
+    double expectedVariance = 0;
+    for (int j = 0; j < signalHistory.size(); ++j) {
+      double deviation = signalHistory.get(j) - expectedMean;
+      expectedVariance += deviation * deviation;
+    }
+    expectedVariance /= signalHistory.size();
+
+    EXPECT_NEAR(signalHistory.mean(), expectedMean, 1e-6);
+    EXPECT_NEAR(signalHistory.variance(), expectedVariance, 1e-6);
+  }
+}
+
+TEST(SignalHistoryTestCase20, MeanWithEmptyHistory) {
+  // Arrange
+  SignalHistory<double> signalHistory;
+
+  // Act and Assert
+  EXPECT_THROW(signalHistory.mean(), std::runtime_error);
+  EXPECT_THROW(signalHistory.variance(), std::runtime_error);
+}
+
+TEST(SignalHistoryTestCase21, GetBlockWithoutWrap) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory;
+  for (int i = 0; i < 10; ++i) {
+    signalHistory.put(i);
+  }
+
+  // Act
+  SignalBlock<double> block = signalHistory.getBlock(2, 5);
+
+  // Assert
+  ASSERT_EQ(block.first.length, 5u);
+  EXPECT_EQ(block.second.length, 0u);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(block.first.data[i], 2 + i);
+  }
+}
+
+TEST(SignalHistoryTestCase22, GetBlockWithWrap) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory;
+  for (int i = 0; i < 100; ++i) {
+    signalHistory.put(i);
+  }
+
+  // Act
+  SignalBlock<double> block = signalHistory.getBlock(0, 64);
+
+  // Assert
+  EXPECT_EQ(block.first.length + block.second.length, 64u);
+  EXPECT_GT(block.second.length, 0u);
+  for (std::size_t i = 0; i < 64; ++i) {
+    double signal = i < block.first.length
+                        ? block.first.data[i]
+                        : block.second.data[i - block.first.length];
+    EXPECT_EQ(signal, 36.0 + i);
+    EXPECT_EQ(signalHistory.getSample(i), 36.0 + i);
+  }
+}
+
+TEST(SignalHistoryTestCase23, GetBlockWithInvalidRange) {
+  // Arrange
+  SignalHistory<double> signalHistory;
+  double signals[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+  for (double signal : signals) {
+    signalHistory.put(signal);
+  }
+
+  // Act and Assert
+  EXPECT_THROW(signalHistory.getBlock(3, 3), std::invalid_argument);
+  EXPECT_THROW(signalHistory.getSample(5), std::invalid_argument);
+}
+
+TEST(SignalHistoryTestCase24, CopyBlockWithWrap) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory;
+  for (int i = 0; i < 100; ++i) {
+    signalHistory.put(i);
+  }
+  double copiedSignals[40];
+
+  // Act
+  signalHistory.copyBlock(20, 40, copiedSignals);
+
+  // Assert
+  for (std::size_t i = 0; i < 40; ++i) {
+    EXPECT_EQ(copiedSignals[i], 56.0 + i);
+  }
+}
+
+TEST(SignalHistoryTestCase25, VersionChangesOnPutAndReset) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(50);
+  unsigned int initialVersion = signalHistory.version();
+
+  // Act and Assert
+  signalHistory.reset();
+  EXPECT_EQ(signalHistory.version(), initialVersion);
+  for (int i = 0; i < 70; ++i) {
+    signalHistory.put(i);
+  }
+  EXPECT_EQ(signalHistory.version(), initialVersion + 70);
+  signalHistory.reset();
+  EXPECT_NE(signalHistory.version(), initialVersion + 70);
+  EXPECT_EQ(signalHistory.getSnapshot(50).sampleCount, 0u);
+}
+
+TEST(SignalHistoryTestCase26, SnapshotOfNewestSignals) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(50);
+  for (int i = 0; i < 100; ++i) {
+    signalHistory.put(i);
+  }
+
+  // Act
+  SignalSnapshot<double> snapshot = signalHistory.getSnapshot(80);
+
+  // Assert
+  ASSERT_EQ(snapshot.sampleCount, 50u);
+  EXPECT_EQ(snapshot.version, 100u);
+  ASSERT_EQ(snapshot.block.first.length + snapshot.block.second.length, 50u);
+  for (std::size_t i = 0; i < 50; ++i) {
+    double signal =
+        i < snapshot.block.first.length
+            ? snapshot.block.first.data[i]
+            : snapshot.block.second.data[i - snapshot.block.first.length];
+    EXPECT_EQ(signal, 50.0 + i);
+    EXPECT_EQ(signal, signalHistory.getSample(i));
+  }
+  EXPECT_TRUE(signalHistory.isSnapshotValid(snapshot));
+}
+
+TEST(SignalHistoryTestCase27, SnapshotValidUntilOverwritten) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(50);
+  for (int i = 0; i < 100; ++i) {
+    signalHistory.put(i);
+  }
+  SignalSnapshot<double> snapshot = signalHistory.getSnapshot(50);
+
+  // Act and Assert
+  // The 14 slots outside the window absorb 14 puts
+  for (int i = 0; i < 14; ++i) {
+    signalHistory.put(-1.0);
+    EXPECT_TRUE(signalHistory.isSnapshotValid(snapshot));
+  }
+  signalHistory.put(-1.0);
+  EXPECT_FALSE(signalHistory.isSnapshotValid(snapshot));
+}
+
+// Stress test with a writer thread and a snapshot reader thread
+TEST(SignalHistoryTestCase28, SnapshotReaderThread) {
+  // Arrange
+  SignalHistory<double, 64>* signalHistory = new SignalHistory<double, 64>(32);
+  const int SAMPLECOUNT = 200000;
+  std::atomic<bool> isWriting(true);
+  int validSnapshotCount = 0;
+  int inconsistentSnapshotCount = 0;
+
+  // Act
+  std::thread writer([signalHistory, SAMPLECOUNT, &isWriting]() {
+    for (int i = 0; i < SAMPLECOUNT; ++i) {
+      signalHistory->put(i);
+      if (i % 16 == 0) std::this_thread::yield();
+    }
+    isWriting.store(false);
+  });
+  std::thread reader([signalHistory, &isWriting, &validSnapshotCount,
+                      &inconsistentSnapshotCount]() {
+    double copiedSignals[32];
+    while (isWriting.load()) {
+      SignalSnapshot<double> snapshot = signalHistory->getSnapshot(32);
+      std::copy(snapshot.block.first.data,
+                snapshot.block.first.data + snapshot.block.first.length,
+                copiedSignals);
+      std::copy(snapshot.block.second.data,
+                snapshot.block.second.data + snapshot.block.second.length,
+                copiedSignals + snapshot.block.first.length);
+      if (!signalHistory->isSnapshotValid(snapshot)) continue;
+
+      ++validSnapshotCount;
+      for (std::size_t i = 0; i < snapshot.sampleCount; ++i) {
+        double expected = snapshot.version - snapshot.sampleCount + i;
+        if (copiedSignals[i] != expected) {
+          ++inconsistentSnapshotCount;
+          break;
+        }
+      }
+    }
+  });
+  writer.join();
+  reader.join();
+
+  // Assert
+  EXPECT_GT(validSnapshotCount, 0);
+  EXPECT_EQ(inconsistentSnapshotCount, 0);
+
+  // Clean up.
+  delete signalHistory;
+}
+
+TEST(SignalHistoryTestCase29, CursorReadsOnlyNewSignals) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(50);
+  for (int i = 0; i < 10; ++i) {
+    signalHistory.put(i);
+  }
+  SignalCursor cursor = signalHistory.openCursor();
+
+  // Act
+  SignalBlock<double> firstRead = signalHistory.readNew(cursor, 100);
+  for (int i = 10; i < 13; ++i) {
+    signalHistory.put(i);
+  }
+  std::size_t pendingCount = signalHistory.pendingCount(cursor);
+  SignalBlock<double> secondRead = signalHistory.readNew(cursor, 100);
+  SignalBlock<double> thirdRead = signalHistory.readNew(cursor, 100);
+
+  // Assert
+  ASSERT_EQ(firstRead.first.length + firstRead.second.length, 10u);
+  EXPECT_EQ(firstRead.first.data[0], 0.0);
+  EXPECT_EQ(pendingCount, 3u);
+  ASSERT_EQ(secondRead.first.length + secondRead.second.length, 3u);
+  EXPECT_EQ(secondRead.first.data[0], 10.0);
+  EXPECT_EQ(thirdRead.first.length + thirdRead.second.length, 0u);
+  EXPECT_EQ(cursor.overrunCount, 0u);
+}
+
+TEST(SignalHistoryTestCase30, CursorsReadIndependently) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(50);
+  SignalCursor fastCursor = signalHistory.openCursor();
+  SignalCursor slowCursor = signalHistory.openCursor();
+  double fastSum = 0;
+  double slowSum = 0;
+
+  // Act
+  for (int i = 0; i < 200; ++i) {
+    signalHistory.put(i);
+    SignalBlock<double> block = signalHistory.readNew(fastCursor, 1);
+    fastSum += block.first.data[0];
+    if (i % 20 == 19) {
+      block = signalHistory.readNew(slowCursor, 64);
+      for (std::size_t j = 0; j < block.first.length; ++j) {
+        slowSum += block.first.data[j];
+      }
+      for (std::size_t j = 0; j < block.second.length; ++j) {
+        slowSum += block.second.data[j];
+      }
+    }
+  }
+
+  // Assert
+  EXPECT_EQ(fastSum, 199.0 * 200 / 2);
+  EXPECT_EQ(slowSum, 199.0 * 200 / 2);
+  EXPECT_EQ(signalHistory.pendingCount(fastCursor), 0u);
+  EXPECT_EQ(signalHistory.pendingCount(slowCursor), 0u);
+}
+
+TEST(SignalHistoryTestCase31, CursorOverrun) {
+  // Arrange
+  SignalHistory<double, 64> signalHistory(50);
+  SignalCursor cursor = signalHistory.openCursor();
+  for (int i = 0; i < 130; ++i) {
+    signalHistory.put(i);
+  }
+
+  // Act
+  std::size_t pendingCount = signalHistory.pendingCount(cursor);
+  SignalBlock<double> block = signalHistory.readNew(cursor, 10);
+
+  // Assert
+  EXPECT_EQ(pendingCount, 50u);
+  EXPECT_EQ(cursor.overrunCount, 80u);
+  ASSERT_EQ(block.first.length + block.second.length, 10u);
+  double firstSignal =
+      block.first.length != 0 ? block.first.data[0] : block.second.data[0];
+  EXPECT_EQ(firstSignal, 80.0);
+  EXPECT_EQ(signalHistory.pendingCount(cursor), 40u);
+}
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "SignalHistory.h"
+#include "SignalPyramid.h"
+
+// Test case for range queries on a window that has not wrapped yet
+TEST(SignalPyramidTestCase1, RangeQueries) {
+  // Arrange
+  SignalPyramid<double, 64> signalPyramid;
+  double signals[] = {3.0, -1.0, 4.0, 1.0, -5.0, 9.0, 2.0, 6.0};
+  for (double signal : signals) {
+    signalPyramid.put(signal);
+  }
+
+  // Act and Assert
+  EXPECT_EQ(signalPyramid.size(), 8u);
+  EXPECT_EQ(signalPyramid.rangeMin(0, 8), -5.0);
+  EXPECT_EQ(signalPyramid.rangeMax(0, 8), 9.0);
+  EXPECT_DOUBLE_EQ(signalPyramid.rangeMean(0, 8), 19.0 / 8);
+  EXPECT_EQ(signalPyramid.rangeMin(1, 3), -1.0);
+  EXPECT_EQ(signalPyramid.rangeMax(1, 3), 4.0);
+  EXPECT_DOUBLE_EQ(signalPyramid.rangeMean(1, 3), 4.0 / 3);
+  EXPECT_EQ(signalPyramid.rangeMin(5, 1), 9.0);
+}
+
+// Test case for every range of a wrapped window against a brute-force scan
+TEST(SignalPyramidTestCase2, RangeQueriesWhenWrapped) {
+  // Arrange
+  SignalPyramid<double, 64> signalPyramid(50);
+  SignalHistory<double, 64> signalHistory(50);
+  for (int i = 0; i < 237; ++i) {
+    double signal = std::sin(i * 0.21) * (1 + i % 9);
+    signalPyramid.put(signal);
+    signalHistory.put(signal);
+  }
+
+  // Act and Assert
+  ASSERT_EQ(signalPyramid.size(), 50u);
+  for (std::size_t first = 0; first < 50; ++first) {
+    for (std::size_t count = 1; first + count <= 50; ++count) {
+      double expectedMin = signalHistory.getSample(first);
+      double expectedMax = expectedMin;
+      double expectedSum = 0;
+      for (std::size_t i = first; i < first + count; ++i) {
+        double signal = signalHistory.getSample(i);
+        if (signal < expectedMin) expectedMin = signal;
+        if (signal > expectedMax) expectedMax = signal;
+        expectedSum += signal;
+      }
+      ASSERT_EQ(signalPyramid.rangeMin(first, count), expectedMin);
+      ASSERT_EQ(signalPyramid.rangeMax(first, count), expectedMax);
+      ASSERT_NEAR(signalPyramid.rangeMean(first, count), expectedSum / count,
+                  1e-12);
+    }
+  }
+}
+
+// Test case for ranges outside the window
+TEST(SignalPyramidTestCase3, InvalidRange) {
+  // Arrange
+  SignalPyramid<double> signalPyramid;
+  signalPyramid.put(1.0);
+  signalPyramid.put(2.0);
+
+  // Act and Assert
+  EXPECT_THROW(signalPyramid.rangeMin(0, 0), std::invalid_argument);
+  EXPECT_THROW(signalPyramid.rangeMax(1, 2), std::invalid_argument);
+  EXPECT_THROW(SignalPyramid<double> invalidPyramid(0), std::invalid_argument);
+}
+
+// Test case for reset clearing the window
+TEST(SignalPyramidTestCase4, Reset) {
+  // Arrange
+  SignalPyramid<double, 64> signalPyramid;
+  for (int i = 0; i < 100; ++i) {
+    signalPyramid.put(i);
+  }
+
+  // Act
+  signalPyramid.reset();
+  signalPyramid.put(-3.0);
+
+  // Assert
+  EXPECT_EQ(signalPyramid.size(), 1u);
+  EXPECT_EQ(signalPyramid.rangeMin(0, 1), -3.0);
+  EXPECT_EQ(signalPyramid.rangeMax(0, 1), -3.0);
+}
@@ -1,9 +1,19 @@
 #include <gtest/gtest.h>
 
+#include "test_gtest/test_CompactSignalHistory.h"
+#include "test_gtest/test_CompressedSignalHistory.h"
 #include "test_gtest/test_FastFourierTransform.h"
+#include "test_gtest/test_FastFourierTransformPlanner.h"
 #include "test_gtest/test_Filter.h"
+#include "test_gtest/test_FixedFastFourierTransform.h"
+#include "test_gtest/test_FixedPointFastFourierTransform.h"
 #include "test_gtest/test_HeartRateCalculator.h"
+#include "test_gtest/test_MappedSignalHistory.h"
+#include "test_gtest/test_MultiChannelSignalHistory.h"
+#include "test_gtest/test_SampleQueue.h"
+#include "test_gtest/test_SignalAlgebra.h"
 #include "test_gtest/test_SignalHistory.h"
+#include "test_gtest/test_SignalPyramid.h"
 #include "test_gtest/test_SpO2Calculator.h"
 
 int main(int argc, char **argv) {